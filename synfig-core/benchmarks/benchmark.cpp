@@ -0,0 +1,682 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file benchmark.cpp
+**	\brief Rendering benchmark suite
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+**
+** === N O T E S ===========================================================
+**
+**	Renders synthetic scenes (built here, each one stresses one subsystem)
+**	and .sif files given in command line into null targets, and writes
+**	frames per second, time of phases and peak memory in JSON, one scene
+**	per line. On Linux peak memory is reset before each scene, so it's
+**	measured per scene, elsewhere it's peak of the whole process.
+**
+**	Results can be compared with baseline written by previous run,
+**	the program returns 1 if any scene is slower (or takes more memory)
+**	than baseline by more than tolerance.
+**
+**	Usage: synfig-benchmark [options] [file.sif ...]
+**	  --output <file>      write results into file instead of stdout
+**	  --baseline <file>    compare results with baseline
+**	  --tolerance <x>      allowed relative regression (default 0.1)
+**	  --frames <n>         render at most n frames of each scene
+**	  --scene <name>       run only synthetic scenes with given name
+**	  --no-synthetic       run only scenes from files
+**	  --tile               use null-tile target instead of null
+**	  --engine <name>      rendering engine (default "software"),
+**	                       "legacy" for accelerated_render() of layers
+**
+** ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <glib.h>
+
+#ifndef _WIN32
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include <ETL/stringf>
+
+#include <synfig/general.h>
+#include <synfig/main.h>
+#include <synfig/bone.h>
+#include <synfig/blinepoint.h>
+#include <synfig/canvas.h>
+#include <synfig/color.h>
+#include <synfig/layer.h>
+#include <synfig/loadcanvas.h>
+#include <synfig/filesystemnative.h>
+#include <synfig/surface.h>
+#include <synfig/target.h>
+#include <synfig/target_scanline.h>
+#include <synfig/target_tile.h>
+#include <synfig/value.h>
+#include <synfig/debug/profiler.h>
+#include <synfig/layers/layer_bitmap.h>
+#include <synfig/layers/layer_pastecanvas.h>
+#include <synfig/layers/layer_skeletondeformation.h>
+#include <synfig/rendering/software/surfacesw.h>
+#include <synfig/valuenodes/valuenode_const.h>
+#include <synfig/valuenodes/valuenode_linear.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+struct Scene
+{
+	String name;
+	Canvas::Handle canvas;
+	String error;
+};
+
+struct Result
+{
+	String name;
+	int frames;
+	int width;
+	int height;
+	double load_time;
+	double render_time;
+	double fps;
+	long long peak_rss;
+	std::map<String, double> phases;
+	String error;
+
+	Result(): frames(), width(), height(), load_time(), render_time(), fps(), peak_rss() { }
+};
+
+/* === P R O C E D U R E S ================================================= */
+
+//! Resets peak resident memory to the current one (Linux only)
+static void
+reset_peak_rss()
+{
+#ifdef __linux__
+	FILE *f = fopen("/proc/self/clear_refs", "w");
+	if (f)
+	{
+		fputs("5", f);
+		fclose(f);
+	}
+#endif
+}
+
+//! Peak resident memory of process in kilobytes, since the last reset_peak_rss()
+static long long
+get_peak_rss()
+{
+#ifdef __linux__
+	if (FILE *f = fopen("/proc/self/status", "r"))
+	{
+		long long peak = -1;
+		char line[256];
+		while(fgets(line, sizeof(line), f))
+			if (strncmp(line, "VmHWM:", 6) == 0)
+				{ peak = atoll(line + 6); break; }
+		fclose(f);
+		if (peak >= 0) return peak;
+	}
+#endif
+#ifndef _WIN32
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+		return (long long)usage.ru_maxrss/1024;
+#else
+		return (long long)usage.ru_maxrss;
+#endif
+#endif
+	return 0;
+}
+
+static void
+set_param(const Layer::Handle &layer, const String &name, const ValueBase &value)
+{
+	if (!layer->set_param(name, value))
+		warning("benchmark: cannot set param '%s' of layer '%s'", name.c_str(), layer->get_name().c_str());
+}
+
+static void
+set_linear(const Layer::Handle &layer, const String &name, const ValueBase &offset, const ValueBase &slope)
+{
+	ValueNode_Linear::Handle node = ValueNode_Linear::create(offset);
+	node->set_link("offset", ValueNode_Const::create(offset));
+	node->set_link("slope", ValueNode_Const::create(slope));
+	layer->connect_dynamic_param(name, node);
+}
+
+static Canvas::Handle
+create_canvas(int width, int height, Time duration)
+{
+	Canvas::Handle canvas = Canvas::create();
+	RendDesc &desc = canvas->rend_desc();
+	desc.set_wh(width, height);
+	desc.set_tl(Point(-4.0, 2.25));
+	desc.set_br(Point(4.0, -2.25));
+	desc.set_frame_rate(24);
+	desc.set_time_start(0);
+	desc.set_time_end(duration);
+	return canvas;
+}
+
+static Layer::Handle
+create_layer(const Canvas::Handle &canvas, const String &name)
+{
+	Layer::Handle layer = Layer::create(name);
+	if (!layer)
+		throw String("layer '" + name + "' is not available");
+	canvas->push_back(layer);
+	return layer;
+}
+
+static Layer::Handle
+create_circle(const Canvas::Handle &canvas, const Point &origin, Real radius, const Color &color)
+{
+	Layer::Handle layer = create_layer(canvas, "circle");
+	set_param(layer, "origin", origin);
+	set_param(layer, "radius", radius);
+	set_param(layer, "color", color);
+	return layer;
+}
+
+static Color
+get_color(int i)
+{
+	return Color( 0.5 + 0.5*sin(i*0.7),
+	              0.5 + 0.5*sin(i*1.3 + 1.0),
+	              0.5 + 0.5*sin(i*2.1 + 2.0),
+	              1.0 );
+}
+
+//! Deep stack of semitransparent layers with various blend methods
+static Canvas::Handle
+create_blend_stack()
+{
+	static const Color::BlendMethod methods[] = {
+		Color::BLEND_COMPOSITE, Color::BLEND_ADD, Color::BLEND_MULTIPLY,
+		Color::BLEND_SCREEN, Color::BLEND_OVERLAY, Color::BLEND_HARD_LIGHT,
+		Color::BLEND_DIFFERENCE, Color::BLEND_BRIGHTEN, Color::BLEND_DARKEN };
+	static const int methods_count = sizeof(methods)/sizeof(methods[0]);
+
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+	for(int i = 0; i < 300; ++i)
+	{
+		Layer::Handle layer = create_circle(canvas, Point(3.5*sin(i*0.37), 2.0*cos(i*0.53)), 0.5 + 0.01*(i%100), get_color(i));
+		set_param(layer, "amount", Real(0.6));
+		set_param(layer, "blend_method", (int)methods[i%methods_count]);
+	}
+	return canvas;
+}
+
+//! Long outlines with many vertices and big width
+static Canvas::Handle
+create_outlines()
+{
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+	for(int j = 0; j < 20; ++j)
+	{
+		std::vector<BLinePoint> bline;
+		for(int i = 0; i < 200; ++i)
+		{
+			Real a = 2.0*M_PI*i/200.0;
+			Real r = 1.0 + 0.1*j + 0.3*sin(a*(7 + j));
+			BLinePoint point;
+			point.set_vertex(Point(r*cos(a)*1.6, r*sin(a)));
+			point.set_tangent(Vector(-sin(a), cos(a))*0.1);
+			point.set_width(1.0 + 0.5*sin(a*3));
+			bline.push_back(point);
+		}
+
+		Layer::Handle layer = create_layer(canvas, "outline");
+		set_param(layer, "bline", ValueBase(bline, true));
+		set_param(layer, "width", Real(0.05 + 0.02*j));
+		set_param(layer, "color", get_color(j));
+		set_linear(layer, "origin", Vector(), Vector(0.1*sin(j), 0.1*cos(j)));
+	}
+	return canvas;
+}
+
+//! Blur layers with given size over moving shapes
+static Canvas::Handle
+create_blur(Real size)
+{
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+	for(int j = 0; j < 3; ++j)
+	{
+		Layer::Handle layer = create_layer(canvas, "blur");
+		set_param(layer, "size", Vector(size, size));
+		for(int i = 0; i < 10; ++i)
+		{
+			Layer::Handle circle = create_circle(canvas, Point(), 0.3 + 0.05*i, get_color(10*j + i));
+			set_linear(circle, "origin", Vector(3.0*sin(i*1.7), 1.8*cos(i*2.3)), Vector(0.2*cos(i), 0.2*sin(i)));
+		}
+	}
+	return canvas;
+}
+
+//! Big bitmap, rotated and zoomed every frame
+static Canvas::Handle
+create_bitmap_transform()
+{
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+
+	const int w = 2048, h = 2048;
+	etl::handle<Layer_Bitmap> bitmap = new Layer_Bitmap();
+	bitmap->surface.set_wh(w, h);
+	for(int y = 0; y < h; ++y)
+		for(int x = 0; x < w; ++x)
+			bitmap->surface[y][x] = ((x/64 + y/64) % 2)
+			                      ? Color(1.0*x/w, 1.0*y/h, 0.5, 1.0)
+			                      : Color(0.0, 0.0, 0.0, 0.5);
+	rendering::SurfaceSW::Handle surface = new rendering::SurfaceSW();
+	surface->assign(bitmap->surface[0], w, h);
+	bitmap->rendering_surface = surface;
+	set_param(bitmap, "tl", Point(-3.0, 3.0));
+	set_param(bitmap, "br", Point(3.0, -3.0));
+	set_param(bitmap, "c", 3);
+
+	Layer::Handle rotate = create_layer(canvas, "rotate");
+	set_linear(rotate, "amount", Angle(Angle::deg(0)), Angle(Angle::deg(90)));
+	Layer::Handle zoom = create_layer(canvas, "zoom");
+	set_linear(zoom, "amount", Real(-0.5), Real(1.0));
+	canvas->push_back(bitmap);
+	return canvas;
+}
+
+//! Skeleton deformation of detailed content
+static Canvas::Handle
+create_skeleton()
+{
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+
+	std::vector<Layer_SkeletonDeformation::BonePair> bones;
+	for(int i = 0; i < 8; ++i)
+	{
+		Point origin(-3.2 + 0.8*i, 0.0);
+		Bone setup(origin, origin + Vector(0.8, 0.0));
+		Bone pose(origin + Vector(0.0, 0.2*sin(i*0.9)), origin + Vector(0.75, 0.2*sin(i*0.9 + 0.9)));
+		setup.set_width(0.6); setup.set_tipwidth(0.6);
+		pose.set_width(0.6); pose.set_tipwidth(0.6);
+		bones.push_back(Layer_SkeletonDeformation::BonePair(setup, pose));
+	}
+
+	Layer::Handle deformation = create_layer(canvas, "skeleton_deformation");
+	ValueBase bones_value;
+	bones_value.set_list_of(bones);
+	set_param(deformation, "bones", bones_value);
+	set_param(deformation, "point1", Point(-4.0, 2.25));
+	set_param(deformation, "point2", Point(4.0, -2.25));
+	set_param(deformation, "x_subdivisions", 64);
+	set_param(deformation, "y_subdivisions", 32);
+
+	for(int i = 0; i < 40; ++i)
+	{
+		Layer::Handle rectangle = create_layer(canvas, "rectangle");
+		set_param(rectangle, "point1", Point(-3.6 + 0.18*i, -0.6));
+		set_param(rectangle, "point2", Point(-3.5 + 0.18*i, 0.6));
+		set_param(rectangle, "color", get_color(i));
+		set_linear(rectangle, "amount", Real(0.5), Real(0.5));
+	}
+	return canvas;
+}
+
+//! Several blocks of text
+static Canvas::Handle
+create_text()
+{
+	Canvas::Handle canvas = create_canvas(1280, 720, Time(1));
+	String text;
+	for(int i = 0; i < 12; ++i)
+		text += "The quick brown fox jumps over the lazy dog 0123456789\n";
+	for(int i = 0; i < 4; ++i)
+	{
+		Layer::Handle layer = create_layer(canvas, "text");
+		set_param(layer, "text", text);
+		set_param(layer, "size", Vector(0.15 + 0.05*i, 0.15 + 0.05*i));
+		set_param(layer, "color", get_color(i));
+		set_linear(layer, "origin", Vector(0.0, 0.0), Vector(0.1*i, 0.0));
+	}
+	return canvas;
+}
+
+//! Many frames of simple animated shapes at small size
+static Canvas::Handle
+create_long_animation()
+{
+	Canvas::Handle canvas = create_canvas(480, 270, Time(20));
+	for(int i = 0; i < 60; ++i)
+	{
+		Layer::Handle layer = create_circle(canvas, Point(), 0.2 + 0.01*i, get_color(i));
+		set_linear(layer, "origin", Vector(3.0*sin(i*1.1), 2.0*cos(i*0.7)), Vector(0.05*cos(i), -0.05*sin(i)));
+		set_linear(layer, "radius", Real(0.2), Real(0.01*(i%7)));
+	}
+	return canvas;
+}
+
+static Scene
+create_scene(const String &name)
+{
+	Scene scene;
+	scene.name = name;
+	try
+	{
+		if (name == "blend_stack")       scene.canvas = create_blend_stack(); else
+		if (name == "outlines")          scene.canvas = create_outlines(); else
+		if (name == "blur_small")        scene.canvas = create_blur(0.02); else
+		if (name == "blur_large")        scene.canvas = create_blur(0.5); else
+		if (name == "bitmap_transform")  scene.canvas = create_bitmap_transform(); else
+		if (name == "skeleton")          scene.canvas = create_skeleton(); else
+		if (name == "text")              scene.canvas = create_text(); else
+		if (name == "long_animation")    scene.canvas = create_long_animation(); else
+			scene.error = "unknown scene";
+	}
+	catch(const String &error)
+	{
+		scene.error = error;
+	}
+	return scene;
+}
+
+static Scene
+load_scene(const String &filename)
+{
+	Scene scene;
+	scene.name = filename;
+	String errors, warnings;
+	try
+	{
+		scene.canvas = open_canvas_as(FileSystemNative::instance()->get_identifier(filename), filename, errors, warnings);
+	}
+	catch(...)
+	{
+		scene.canvas = NULL;
+	}
+	if (!scene.canvas)
+		scene.error = errors.empty() ? String("cannot open file") : errors;
+	return scene;
+}
+
+static Result
+run_scene(const Scene &scene, double load_time, int max_frames, bool tile, const String &engine)
+{
+	Result result;
+	result.name = scene.name;
+	result.load_time = load_time;
+	result.error = scene.error;
+	if (!scene.canvas) return result;
+
+	RendDesc desc = scene.canvas->rend_desc();
+	int frames = desc.get_frame_end() - desc.get_frame_start() + 1;
+	if (max_frames > 0 && frames > max_frames)
+	{
+		desc.set_time_end(desc.get_time_start() + Time(max_frames - 1)/desc.get_frame_rate());
+		frames = max_frames;
+	}
+	if (frames < 1) frames = 1;
+
+	Target::Handle target = Target::create(tile ? "null-tile" : "null", String(), TargetParam());
+	if (!target)
+	{
+		result.error = "cannot create target";
+		return result;
+	}
+	target->set_canvas(scene.canvas);
+	target->set_rend_desc(&desc);
+	target->set_quality(3);
+	String target_engine = engine == "legacy" ? String() : engine;
+	if (etl::handle<Target_Scanline> scanline = etl::handle<Target_Scanline>::cast_dynamic(target))
+		scanline->set_engine(target_engine);
+	if (etl::handle<Target_Tile> tile_target = etl::handle<Target_Tile>::cast_dynamic(target))
+		tile_target->set_engine(target_engine);
+
+	debug::Profiler::enable();
+	long long begin = g_get_monotonic_time();
+	bool success = target->render(NULL);
+	long long end = g_get_monotonic_time();
+	debug::Profiler::disable();
+
+	if (!success)
+		result.error = "render failure";
+
+	result.frames = frames;
+	result.width = desc.get_w();
+	result.height = desc.get_h();
+	result.render_time = (double)(end - begin)*0.000001;
+	result.fps = result.render_time > 0.0 ? frames/result.render_time : 0.0;
+	result.peak_rss = get_peak_rss();
+
+	// time of all tasks of each type, summary of all threads
+	debug::Profiler::TotalMap tasks = debug::Profiler::get_task_totals();
+	for(debug::Profiler::TotalMap::const_iterator i = tasks.begin(); i != tasks.end(); ++i)
+		result.phases[i->first] += (double)i->second.duration*0.000001;
+
+	return result;
+}
+
+static String
+escape_json(const String &x)
+{
+	String s;
+	for(String::const_iterator i = x.begin(); i != x.end(); ++i)
+	{
+		if (*i == '"' || *i == '\\') s += '\\';
+		if ((unsigned char)*i < 0x20) { s += ' '; continue; }
+		s += *i;
+	}
+	return s;
+}
+
+static String
+format_result(const Result &r)
+{
+	String s = strprintf(
+		"{\"name\":\"%s\",\"frames\":%d,\"width\":%d,\"height\":%d,"
+		"\"fps\":%.4f,\"load\":%.6f,\"render\":%.6f,\"peak_rss_kb\":%lld,\"phases\":{",
+		escape_json(r.name).c_str(), r.frames, r.width, r.height,
+		r.fps, r.load_time, r.render_time, r.peak_rss );
+	for(std::map<String, double>::const_iterator i = r.phases.begin(); i != r.phases.end(); ++i)
+		s += strprintf("%s\"%s\":%.6f", i == r.phases.begin() ? "" : ",", escape_json(i->first).c_str(), i->second);
+	s += "}";
+	if (!r.error.empty())
+		s += ",\"error\":\"" + escape_json(r.error) + "\"";
+	return s + "}";
+}
+
+//! Reads numeric field from line written by format_result()
+static bool
+read_number(const String &line, const String &key, double &value)
+{
+	String::size_type pos = line.find("\"" + key + "\":");
+	if (pos == String::npos) return false;
+	value = atof(line.c_str() + pos + key.size() + 3);
+	return true;
+}
+
+static bool
+read_name(const String &line, String &name)
+{
+	static const String key = "{\"name\":\"";
+	if (line.compare(0, key.size(), key) != 0) return false;
+	String::size_type end = line.find("\",", key.size());
+	if (end == String::npos) return false;
+	name = line.substr(key.size(), end - key.size());
+	return true;
+}
+
+//! Returns count of regressions
+static int
+compare_with_baseline(const String &filename, const std::vector<Result> &results, double tolerance)
+{
+	std::ifstream f(filename.c_str());
+	if (!f)
+	{
+		error("benchmark: cannot open baseline %s", filename.c_str());
+		return 0;
+	}
+
+	std::map<String, String> baseline;
+	String line;
+	while(std::getline(f, line))
+	{
+		String::size_type pos = line.find('{', 1);
+		if (pos == String::npos) continue;
+		line = line.substr(pos);
+		String name;
+		if (read_name(line, name))
+			baseline[name] = line;
+	}
+
+	int regressions = 0;
+	for(std::vector<Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+	{
+		std::map<String, String>::const_iterator j = baseline.find(escape_json(i->name));
+		if (j == baseline.end() || !i->error.empty()) continue;
+
+		double fps = 0.0, rss = 0.0;
+		read_number(j->second, "fps", fps);
+		read_number(j->second, "peak_rss_kb", rss);
+
+		if (fps > 0.0 && i->fps < fps*(1.0 - tolerance))
+		{
+			cerr << strprintf("REGRESSION %s: %.3f fps, baseline %.3f fps", i->name.c_str(), i->fps, fps) << endl;
+			++regressions;
+		}
+		if (rss > 0.0 && (double)i->peak_rss > rss*(1.0 + tolerance))
+		{
+			cerr << strprintf("REGRESSION %s: peak memory %lld KB, baseline %.0f KB", i->name.c_str(), i->peak_rss, rss) << endl;
+			++regressions;
+		}
+	}
+	return regressions;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main(int argc, char **argv)
+{
+	static const char *synthetic_scenes[] = {
+		"blend_stack", "outlines", "blur_small", "blur_large",
+		"bitmap_transform", "skeleton", "text", "long_animation" };
+
+	String output, baseline, engine = "software";
+	double tolerance = 0.1;
+	int max_frames = 0;
+	bool tile = false;
+	bool synthetic = true;
+	std::vector<String> scenes, files;
+
+	for(int i = 1; i < argc; ++i)
+	{
+		String arg = argv[i];
+		bool has_value = i + 1 < argc;
+		if (arg == "--output"    && has_value) output = argv[++i]; else
+		if (arg == "--baseline"  && has_value) baseline = argv[++i]; else
+		if (arg == "--tolerance" && has_value) tolerance = atof(argv[++i]); else
+		if (arg == "--frames"    && has_value) max_frames = atoi(argv[++i]); else
+		if (arg == "--scene"     && has_value) scenes.push_back(argv[++i]); else
+		if (arg == "--engine"    && has_value) engine = argv[++i]; else
+		if (arg == "--tile")         tile = true; else
+		if (arg == "--no-synthetic") synthetic = false; else
+		if (arg.compare(0, 2, "--") == 0)
+		{
+			cerr << "unknown option " << arg << endl;
+			return 2;
+		}
+		else
+			files.push_back(arg);
+	}
+
+	if (scenes.empty() && synthetic)
+		scenes.assign(synthetic_scenes, synthetic_scenes + sizeof(synthetic_scenes)/sizeof(synthetic_scenes[0]));
+
+	synfig::Main synfig_main(etl::dirname(argv[0]));
+
+	std::vector<Result> results;
+	for(std::vector<String>::const_iterator i = scenes.begin(); i != scenes.end(); ++i)
+	{
+		reset_peak_rss();
+		long long begin = g_get_monotonic_time();
+		Scene scene = create_scene(*i);
+		double load_time = (double)(g_get_monotonic_time() - begin)*0.000001;
+		results.push_back(run_scene(scene, load_time, max_frames, tile, engine));
+		cerr << format_result(results.back()) << endl;
+	}
+	for(std::vector<String>::const_iterator i = files.begin(); i != files.end(); ++i)
+	{
+		reset_peak_rss();
+		long long begin = g_get_monotonic_time();
+		Scene scene = load_scene(*i);
+		double load_time = (double)(g_get_monotonic_time() - begin)*0.000001;
+		results.push_back(run_scene(scene, load_time, max_frames, tile, engine));
+		cerr << format_result(results.back()) << endl;
+	}
+
+	std::ostringstream json;
+	json << "{\"engine\":\"" << escape_json(engine) << "\",\"target\":\"" << (tile ? "null-tile" : "null") << "\",\"scenes\":[" << endl;
+	for(std::vector<Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+		json << (i == results.begin() ? " " : ",") << format_result(*i) << endl;
+	json << "]}" << endl;
+
+	if (output.empty())
+		cout << json.str();
+	else
+	{
+		std::ofstream f(output.c_str());
+		f << json.str();
+		if (!f)
+		{
+			error("benchmark: cannot write %s", output.c_str());
+			return 2;
+		}
+	}
+
+	int failures = 0;
+	for(std::vector<Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+		if (!i->error.empty()) ++failures;
+
+	int regressions = baseline.empty() ? 0 : compare_with_baseline(baseline, results, tolerance);
+	return regressions ? 1 : failures ? 2 : 0;
+}
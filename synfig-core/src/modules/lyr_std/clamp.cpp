@@ -176,6 +176,13 @@ TaskClampSW::run(RunParams & /* params */) const
 	return true;
 }
 
+void
+TaskClampSW::process_pixels(Color *dst, const Color *src, int count) const
+{
+	for(Color *end = dst + count; dst < end; ++dst, ++src)
+		clamp_pixel(*dst, *src);
+}
+
 
 void
 OptimizerClampSW::run(const RunParams& params) const
@@ -34,6 +34,7 @@
 #include <synfig/rendering/common/task/taskpixelprocessor.h>
 #include <synfig/rendering/common/task/tasksplittable.h>
 #include <synfig/rendering/software/task/tasksw.h>
+#include <synfig/rendering/software/task/taskpixelchainsw.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -70,7 +71,7 @@ public:
 };
 
 
-class TaskClampSW: public TaskClamp, public rendering::TaskSW, public rendering::TaskSplittable
+class TaskClampSW: public TaskClamp, public rendering::TaskSW, public rendering::TaskSplittable, public rendering::TaskPixelFunctionSW
 {
 private:
 	void clamp_pixel(Color &dst, const Color &src) const;
@@ -80,6 +81,7 @@ public:
 	Task::Handle clone() const { return clone_pointer(this); }
 	virtual void split(const RectInt &sub_target_rect);
 	virtual bool run(RunParams &params) const;
+	virtual void process_pixels(Color *dst, const Color *src, int count) const;
 };
 
 
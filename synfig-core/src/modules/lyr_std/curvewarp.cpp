@@ -69,89 +69,31 @@ SYNFIG_LAYER_SET_CVS_ID(CurveWarp,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
-inline float calculate_distance(const std::vector<BLinePoint>& bline)
-{
-	std::vector<BLinePoint>::const_iterator iter,next,ret;
-	std::vector<BLinePoint>::const_iterator end(bline.end());
-
-	float dist(0);
-
-	if (bline.empty()) return dist;
-
-	next=bline.begin();
-	iter=next++;
-
-	for(;next!=end;iter=next++)
-	{
-		// Setup the curve
-		etl::hermite<Vector> curve(iter->get_vertex(), next->get_vertex(), iter->get_tangent2(), next->get_tangent1());
-		dist+=curve.length();
-	}
-
-	return dist;
-}
-
 std::vector<BLinePoint>::const_iterator
-find_closest_to_bline(bool fast, const std::vector<BLinePoint>& bline,const Point& p,float& t, float& len, bool& extreme)
+find_closest_to_bline(bool fast, const BLineIndex &bline_index,const Point& p,float& t, float& len, bool& extreme)
 {
-	std::vector<BLinePoint>::const_iterator iter,next,ret;
-	std::vector<BLinePoint>::const_iterator end(bline.end());
-
-	ret=bline.end();
-	float dist(100000000000.0);
-	next=bline.begin();
-	float best_pos(0), best_len(0);
-	etl::hermite<Vector> best_curve;
-	iter=next++;
-	Point bp;
-	float total_len(0);
-	bool first = true, last = false;
+	Real pos;
+	const int index = bline_index.find_closest(fast, p, pos);
 	extreme = false;
+	if (index < 0)
+		return bline_index.get_bline().end();
 
-	for(;next!=end;iter=next++)
-	{
-		// Setup the curve
-		etl::hermite<Vector> curve(iter->get_vertex(), next->get_vertex(), iter->get_tangent2(), next->get_tangent1());
-		float thisdist(0);
-		last = false;
+	const BLineIndex::Segment &segment = bline_index.get_segments()[index];
+	const bool first = index == 0;
+	const bool last = index + 1 == (int)bline_index.get_segments().size();
 
-		if (fast)
-		{
-#define POINT_CHECK(x) bp=curve(x);	thisdist=(bp-p).mag_squared(); if(thisdist<dist) { extreme = (first&&x<0.01); ret=iter; best_len = total_len; dist=thisdist; best_curve=curve; last=true; best_pos=x;}
-			POINT_CHECK(0.0001);  POINT_CHECK((1.0/6)); POINT_CHECK((2.0/6)); POINT_CHECK((3.0/6));
-			POINT_CHECK((4.0/6)); POINT_CHECK((5.0/6)); POINT_CHECK(0.9999);
-		}
-		else
-		{
-			float pos = curve.find_closest(fast, p);
-			thisdist=(curve(pos)-p).mag_squared();
-			if(thisdist<dist)
-			{
-				extreme = (first && pos == 0);
-				ret=iter;
-				dist=thisdist;
-				best_pos = pos;
-				best_curve = curve;
-				best_len = total_len;
-				last = true;
-			}
-		}
-		total_len += curve.length();
-		first = false;
-	}
-
-	t = best_pos;
+	t = pos;
 	if (fast)
 	{
-		len = best_len + best_curve.find_distance(0,best_curve.find_closest(fast, p));
-		if (last && t > .99) extreme = true;
+		len = segment.offset + segment.curve.find_distance(0,segment.curve.find_closest(fast, p));
+		extreme = (first && t < 0.01) || (last && t > .99);
 	}
 	else
 	{
-		len = best_len + best_curve.find_distance(0,best_pos);
-		if (last && t == 1) extreme = true;
+		len = segment.offset + segment.curve.find_distance(0,pos);
+		extreme = (first && t == 0) || (last && t == 1);
 	}
-	return ret;
+	return bline_index.get_bline().begin() + segment.index;
 }
 
 /* === M E T H O D S ======================================================= */
@@ -159,11 +101,11 @@ find_closest_to_bline(bool fast, const std::vector<BLinePoint>& bline,const Poin
 inline void
 CurveWarp::sync()
 {
-	std::vector<BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
 	Point start_point=param_start_point.get(Point());
 	Point end_point=param_end_point.get(Point());
-	
-	curve_length_=calculate_distance(bline);
+
+	bline_index.build(param_bline.get_list_of(BLinePoint()), false);
+	curve_length_=bline_index.get_length();
 	perp_ = (end_point - start_point).perp().norm();
 }
 
@@ -194,7 +136,7 @@ CurveWarp::CurveWarp():
 inline Point
 CurveWarp::transform(const Point &point_, Real *dist, Real *along, int quality)const
 {
-	std::vector<BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
+	const std::vector<BLinePoint> &bline(bline_index.get_bline());
 	Point start_point=param_start_point.get(Point());
 	Point end_point=param_end_point.get(Point());
 	Point origin=param_origin.get(Point());
@@ -227,7 +169,7 @@ CurveWarp::transform(const Point &point_, Real *dist, Real *along, int quality)c
 		std::vector<BLinePoint>::const_iterator iter,next;
 
 		// Figure out the BLinePoint we will be using,
-		next=find_closest_to_bline(fast,bline,point,t,len,extreme);
+		next=find_closest_to_bline(fast,bline_index,point,t,len,extreme);
 
 		iter=next++;
 		if(next==bline.end()) next=bline.begin();
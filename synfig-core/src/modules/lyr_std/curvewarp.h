@@ -35,6 +35,7 @@
 #include <synfig/vector.h>
 #include <synfig/layer.h>
 #include <synfig/blinepoint.h>
+#include <synfig/blineindex.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -69,6 +70,7 @@ private:
 
 	Vector perp_;
 	Real curve_length_;
+	BLineIndex bline_index;
 
 	void sync();
 
@@ -84,6 +86,7 @@ public:
 	Layer::Handle hit_check(Context context, const Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 
 protected:
 	virtual RendDesc get_sub_renddesc_vfunc(const RendDesc &renddesc) const;
@@ -48,6 +48,7 @@
 #include <synfig/valuenode.h>
 #include <synfig/canvas.h>
 #include <synfig/filesystemnative.h>
+#include <synfig/importercache.h>
 
 #include <synfig/rendering/software/surfacesw.h>
 
@@ -106,7 +107,8 @@ Import::set_param(const String & param, const ValueBase &value)
 			filename=value.get(filename);
 			importer=0;
 			cimporter=0;
-			surface.clear();
+			// detach from the pixels which may be shared with other layers
+			surface.mirror(Surface());
 			csurface.set_cairo_surface(NULL);
 			param_filename.set(filename);
 			return true;
@@ -152,7 +154,8 @@ Import::set_param(const String & param, const ValueBase &value)
 			filename=newfilename;
 			importer=0;
 			cimporter=0;
-			surface.clear();
+			// detach from the pixels which may be shared with other layers
+			surface.mirror(Surface());
 			csurface.set_cairo_surface(NULL);
 			param_filename.set(filename);
 			return true;
@@ -183,32 +186,48 @@ Import::set_param(const String & param, const ValueBase &value)
 					filename_with_path=absolute_path(get_canvas()->get_file_path()+ETL_DIRECTORY_SEPARATOR+newfilename_orig);
 
 				handle<Importer> newimporter;
+				ImporterCache::Frame frame;
 
-				newimporter=Importer::open(file_system->get_identifier(filename_with_path));
-
-				if(!newimporter)
+				if(!ImporterCache::get_frame(file_system->get_identifier(filename_with_path),get_canvas()->rend_desc(),frame,newimporter)
+				&& !newimporter)
 				{
-					newimporter=Importer::open(file_system->get_identifier(get_canvas()->get_file_path()+ETL_DIRECTORY_SEPARATOR+basename(newfilename_orig)));
-					if(!newimporter)
+					if(!ImporterCache::get_frame(file_system->get_identifier(get_canvas()->get_file_path()+ETL_DIRECTORY_SEPARATOR+basename(newfilename_orig)),get_canvas()->rend_desc(),frame,newimporter)
+					&& !newimporter)
 					{
 						error(strprintf("Unable to create an importer object with file \"%s\"",filename_with_path.c_str()));
 						importer=0;
 						filename=newfilename;
 						abs_filename=filename_with_path;
-						surface.clear();
+						surface.mirror(Surface());
 						param_filename.set(filename);
 						return false;
 					}
 				}
 
-				surface.clear();
-				if(!newimporter->get_frame(surface,get_canvas()->rend_desc(),Time(0),trimmed,width,height,top,left))
+				if(frame.surface)
 				{
-					warning(strprintf("Unable to get frame from \"%s\"",filename_with_path.c_str()));
+					// static image, decoded pixels are shared with other layers,
+					// importer is not needed anymore
+					rendering_surface = frame.surface;
+					surface.mirror(frame.surface->get_surface());
+					trimmed=frame.trimmed;
+					width=frame.width;
+					height=frame.height;
+					top=frame.top;
+					left=frame.left;
 				}
+				else
+				{
+					// animated image, frames are loaded by set_time_vfunc()
+					surface.mirror(Surface());
+					if(!newimporter->get_frame(surface,get_canvas()->rend_desc(),Time(0),trimmed,width,height,top,left))
+					{
+						warning(strprintf("Unable to get frame from \"%s\"",filename_with_path.c_str()));
+					}
 
-				rendering_surface = new rendering::SurfaceSW();
-				rendering_surface->assign(surface[0], surface.get_w(), surface.get_h());
+					rendering_surface = new rendering::SurfaceSW();
+					rendering_surface->assign(surface[0], surface.get_w(), surface.get_h());
+				}
 
 				importer=newimporter;
 				filename=newfilename;
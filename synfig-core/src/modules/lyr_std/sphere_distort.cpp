@@ -49,6 +49,9 @@
 
 #include <synfig/curve_helper.h>
 
+#include <synfig/rendering/common/task/tasktransformation.h>
+#include <synfig/rendering/primitive/transformation.h>
+
 #endif
 
 /* === U S I N G =========================================================== */
@@ -871,3 +874,49 @@ Layer_SphereDistort::get_bounding_rect()const
 
 	return bounds;
 }
+
+namespace {
+	//! Spherize transformation for rendering tasks,
+	//! keeps copies of parameters, because tasks may be rendered in other threads
+	class SpherizeTransformation: public rendering::Transformation
+	{
+	public:
+		typedef etl::handle<SpherizeTransformation> Handle;
+
+		Point center;
+		Real radius;
+		Real percent;
+		int type;
+		bool clip;
+
+		SpherizeTransformation(): radius(), percent(), type(), clip() { }
+
+	protected:
+		virtual TransformedPoint transform_vfunc(const Point &x) const
+			{ return TransformedPoint(sphtrans(x, center, radius, -percent, type)); }
+
+		virtual TransformedPoint back_transform_vfunc(const Point &x) const
+		{
+			bool clipped;
+			Point p = sphtrans(x, center, radius, percent, type, clipped);
+			return TransformedPoint(p, 0.0, !(clip && clipped));
+		}
+	};
+}
+
+rendering::Task::Handle
+Layer_SphereDistort::build_rendering_task_vfunc(Context context)const
+{
+	SpherizeTransformation::Handle transformation(new SpherizeTransformation());
+	transformation->center = param_center.get(Vector());
+	transformation->radius = param_radius.get(double());
+	transformation->percent = param_amount.get(double());
+	transformation->type = param_type.get(int());
+	transformation->clip = param_clip.get(bool());
+
+	rendering::TaskTransformation::Handle task_transformation(new rendering::TaskTransformation());
+	task_transformation->transformation = transformation;
+	task_transformation->interpolation = rendering::TaskTransformation::get_interpolation_by_quality(context.get_params().quality);
+	task_transformation->sub_task() = context.build_rendering_task();
+	return task_transformation;
+}
@@ -86,10 +86,12 @@ public:
 	virtual Rect get_bounding_rect()const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 	virtual etl::handle<Transform> get_transform()const;
 
 protected:
 	virtual RendDesc get_sub_renddesc_vfunc(const RendDesc &renddesc) const;
+	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context)const;
 }; // END of class Layer_SphereDistort
 
 }; // END of namespace lyr_std
@@ -66,6 +66,7 @@ public:
 	virtual Rect get_bounding_rect(Context context)const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 
 protected:
 	virtual RendDesc get_sub_renddesc_vfunc(const RendDesc &renddesc) const;
@@ -87,6 +87,7 @@ public:
 	virtual Vocab get_param_vocab()const;
 	virtual etl::handle<Transform> get_transform()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_splittable()const { return true; }
 
 protected:
 	virtual RendDesc get_sub_renddesc_vfunc(const RendDesc &renddesc) const;
@@ -50,6 +50,9 @@
 #include <synfig/cairo_renddesc.h>
 #include <ETL/misc>
 
+#include <synfig/rendering/common/task/tasktransformation.h>
+#include <synfig/rendering/primitive/transformation.h>
+
 #endif
 
 using namespace std;
@@ -1356,3 +1359,67 @@ Warp::get_full_bounding_rect(Context context)const
 	return ret;
 	*/
 }
+
+namespace {
+	//! Perspective transformation of Warp for rendering tasks,
+	//! keeps copies of parameters, because tasks may be rendered in other threads
+	class WarpTransformation: public rendering::Transformation
+	{
+	public:
+		typedef etl::handle<WarpTransformation> Handle;
+
+		Real matrix[3][3];
+		Real inv_matrix[3][3];
+		Rect clip_rect;
+		bool clip;
+		Real horizon;
+
+		WarpTransformation(): clip(), horizon() { }
+
+		static Point transform(const Real m[3][3], const Point &p)
+		{
+			Real z = m[2][0]*p[0] + m[2][1]*p[1] + m[2][2];
+			return Point(
+				(m[0][0]*p[0] + m[0][1]*p[1] + m[0][2])/z,
+				(m[1][0]*p[0] + m[1][1]*p[1] + m[1][2])/z );
+		}
+
+	protected:
+		virtual TransformedPoint transform_vfunc(const Point &x) const
+			{ return TransformedPoint(transform(matrix, x)); }
+
+		virtual TransformedPoint back_transform_vfunc(const Point &x) const
+		{
+			Point p = transform(inv_matrix, x);
+			Real z = matrix[2][0]*p[0] + matrix[2][1]*p[1] + matrix[2][2];
+			bool visible = z > 0 && z < horizon
+			            && ( !clip
+			              || ( approximate_less_or_equal(clip_rect.minx, p[0])
+			                && approximate_less_or_equal(p[0], clip_rect.maxx)
+			                && approximate_less_or_equal(clip_rect.miny, p[1])
+			                && approximate_less_or_equal(p[1], clip_rect.maxy) ));
+			return TransformedPoint(p, z, visible);
+		}
+	};
+}
+
+rendering::Task::Handle
+Warp::build_rendering_task_vfunc(Context context)const
+{
+	WarpTransformation::Handle transformation(new WarpTransformation());
+	for(int i = 0; i < 3; ++i)
+		for(int j = 0; j < 3; ++j)
+		{
+			transformation->matrix[i][j] = matrix[i][j];
+			transformation->inv_matrix[i][j] = inv_matrix[i][j];
+		}
+	transformation->clip_rect = Rect(param_src_tl.get(Point()), param_src_br.get(Point()));
+	transformation->clip = param_clip.get(bool());
+	transformation->horizon = param_horizon.get(Real());
+
+	rendering::TaskTransformation::Handle task_transformation(new rendering::TaskTransformation());
+	task_transformation->transformation = transformation;
+	task_transformation->interpolation = rendering::TaskTransformation::get_interpolation_by_quality(context.get_params().quality);
+	task_transformation->sub_task() = context.build_rendering_task();
+	return task_transformation;
+}
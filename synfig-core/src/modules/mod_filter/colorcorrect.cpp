@@ -86,34 +86,29 @@ TaskColorCorrectSW::split(const RectInt &sub_target_rect)
 }
 
 void
-TaskColorCorrectSW::correct_pixel(Color &dst, const Color &src, const Angle &hue_adjust, ColorReal shift, ColorReal amplifier, const Gamma &gamma) const
+TaskColorCorrectSW::correct_pixel(Color &dst, const Color &src, const Angle &hue_adjust, ColorReal shift, ColorReal amplifier, ColorReal gamma) const
 {
 	static const double precision = 1e-8;
 
 	dst = src;
 
-	if (fabs(gamma.get_gamma_r() - 1.0) > precision)
+	// the same as Gamma::r_F32_to_F32(), but without building of Gamma tables
+	if (fabs(gamma - 1.0) > precision)
 	{
 		if (dst.get_r() < 0)
-			dst.set_r(-gamma.r_F32_to_F32(-dst.get_r()));
+			dst.set_r(-(ColorReal)pow(-dst.get_r(), gamma));
 		else
-			dst.set_r(gamma.r_F32_to_F32(dst.get_r()));
-	}
+			dst.set_r((ColorReal)pow(dst.get_r(), gamma));
 
-	if (fabs(gamma.get_gamma_g() - 1.0) > precision)
-	{
 		if (dst.get_g() < 0)
-			dst.set_g(-gamma.g_F32_to_F32(-dst.get_g()));
+			dst.set_g(-(ColorReal)pow(-dst.get_g(), gamma));
 		else
-			dst.set_g(gamma.g_F32_to_F32(dst.get_g()));
-	}
+			dst.set_g((ColorReal)pow(dst.get_g(), gamma));
 
-	if (fabs(gamma.get_gamma_b() - 1.0) > precision)
-	{
 		if (dst.get_b() < 0)
-			dst.set_b(-gamma.b_F32_to_F32(-dst.get_b()));
+			dst.set_b(-(ColorReal)pow(-dst.get_b(), gamma));
 		else
-			dst.set_b(gamma.b_F32_to_F32(dst.get_b()));
+			dst.set_b((ColorReal)pow(dst.get_b(), gamma));
 	}
 
 	assert(!isnan(dst.get_r()));
@@ -182,19 +177,11 @@ TaskColorCorrectSW::run(RunParams & /* params */) const
 			etl::set_intersect(ra, ra, r);
 			if (ra.valid())
 			{
-				ColorReal amplifier = (ColorReal)(contrast*exp(exposure));
-				ColorReal shift = (ColorReal)((brightness - 0.5)*contrast + 0.5);
-				Gamma g(fabs(gamma) < 1e-8 ? 1.0 : 1.0/gamma);
-
-				synfig::Surface::pen pc = c.get_pen(ra.minx, ra.maxx);
-				synfig::Surface::pen pa = c.get_pen(ra.minx, ra.maxx);
 				for(int y = ra.miny; y < ra.maxy; ++y)
-				{
-					const Color *ca = &a[y - r.miny - offset[1]][ra.minx - r.minx - offset[0]];
-					Color *cc = &c[y][ra.minx];
-					for(int x = ra.minx; x < ra.maxx; ++x, ++ca, ++cc)
-						correct_pixel(*cc, *ca, hue_adjust, shift, amplifier, g);
-				}
+					process_pixels(
+						&c[y][ra.minx],
+						&a[y - r.miny - offset[1]][ra.minx - r.minx - offset[0]],
+						ra.maxx - ra.minx );
 			}
 		}
 	}
@@ -204,6 +191,17 @@ TaskColorCorrectSW::run(RunParams & /* params */) const
 	return true;
 }
 
+void
+TaskColorCorrectSW::process_pixels(Color *dst, const Color *src, int count) const
+{
+	ColorReal amplifier = (ColorReal)(contrast*exp(exposure));
+	ColorReal shift = (ColorReal)((brightness - 0.5)*contrast + 0.5);
+	ColorReal g = (ColorReal)(fabs(gamma) < 1e-8 ? 1.0 : 1.0/gamma);
+
+	for(Color *end = dst + count; dst < end; ++dst, ++src)
+		correct_pixel(*dst, *src, hue_adjust, shift, amplifier, g);
+}
+
 
 void
 OptimizerColorCorrectSW::run(const RunParams& params) const
@@ -37,6 +37,7 @@
 #include <synfig/rendering/common/task/taskpixelprocessor.h>
 #include <synfig/rendering/common/task/tasksplittable.h>
 #include <synfig/rendering/software/task/tasksw.h>
+#include <synfig/rendering/software/task/taskpixelchainsw.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -69,16 +70,17 @@ public:
 };
 
 
-class TaskColorCorrectSW: public TaskColorCorrect, public rendering::TaskSW, public rendering::TaskSplittable
+class TaskColorCorrectSW: public TaskColorCorrect, public rendering::TaskSW, public rendering::TaskSplittable, public rendering::TaskPixelFunctionSW
 {
 private:
-	void correct_pixel(Color &dst, const Color &src, const Angle &hue_djust, ColorReal shift, ColorReal amplifier, const Gamma &gamma) const;
+	void correct_pixel(Color &dst, const Color &src, const Angle &hue_djust, ColorReal shift, ColorReal amplifier, ColorReal gamma) const;
 
 public:
 	typedef etl::handle<TaskColorCorrectSW> Handle;
 	Task::Handle clone() const { return clone_pointer(this); }
 	virtual void split(const RectInt &sub_target_rect);
 	virtual bool run(RunParams &params) const;
+	virtual void process_pixels(Color *dst, const Color *src, int count) const;
 };
 
 
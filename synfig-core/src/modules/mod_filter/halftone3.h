@@ -88,6 +88,7 @@ public:
 	Layer::Handle hit_check(Context context, const Point &point)const;
 	virtual Vocab get_param_vocab()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_splittable()const { return true; }
 
 protected:
 	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context) const;
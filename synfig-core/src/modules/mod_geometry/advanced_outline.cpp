@@ -366,10 +366,10 @@ Advanced_Outline::sync_vfunc()
 			//synfig::info("P:%f W:%f B:%d A:%d", witer->get_position(), witer->get_width(), witer->get_side_type_before(), witer->get_side_type_after());
 		//synfig::info("------");
 		////////////////////////////////////////////////////////////////
-		// TODO: step should be a function of the current situation
-		// i.e.: where in the bline, and where in wplist so we could go
-		// faster or slower when needed.
-		Real step(1.0/SAMPLES/bline_size);
+		// The step is chosen for each bezier by its curvature and the
+		// current pixel size, this one is used if pixel size is unknown.
+		const Real default_step(1.0/SAMPLES/bline_size);
+		Real step(default_step);
 		//////////////////// prepare the widhtpoints from the dash list
 		if(dash_enabled)
 		{
@@ -676,6 +676,22 @@ Advanced_Outline::sync_vfunc()
 			if(last->get_side_type_after() == WidthPoint::TYPE_INTERPOLATE)
 				last->set_side_type_after(dend_tip);
 		}
+		// Allowed deviation of the outline from the exact curves, and
+		// the widths range to choose the step for each bezier.
+		const Real tolerance(get_flattening_tolerance());
+		Real max_width(0.0), width_range(0.0);
+		if (tolerance > 0.0 && !cwplist.empty())
+		{
+			Real wmin(cwplist.front().get_width()), wmax(wmin);
+			for(vector<WidthPoint>::const_iterator i = cwplist.begin(); i != cwplist.end(); ++i)
+			{
+				wmin = min(wmin, i->get_width());
+				wmax = max(wmax, i->get_width());
+			}
+			max_width = max( fabs(gv*(expand_+width_*0.5*wmin)),
+			                 fabs(gv*(expand_+width_*0.5*wmax)) );
+			width_range = fabs(gv*width_*0.5*(wmax - wmin));
+		}
 		do ///////////////////////// Main loop
 		{
 			Vector iter_t(biter->get_tangent2());
@@ -691,6 +707,10 @@ Advanced_Outline::sync_vfunc()
 				next_t
 			);
 			const derivative< hermite<Vector> > deriv(curve);
+			if (tolerance > 0.0)
+				step = bezier_size*get_flattening_step(
+					biter->get_vertex(), bnext->get_vertex(), iter_t, next_t,
+					max_width, width_range, tolerance, 1.0/SAMPLES );
 			// if tangents are zero length then use the derivative.
 			if(iter_t_mag==0.0)
 				iter_t=deriv(CUSP_TANGENT_ADJUST);
@@ -1316,9 +1336,12 @@ Advanced_Outline::add_tip(std::vector<Point> &side_a, std::vector<Point> &side_b
 				-tangent*w*ROUND_END_FACTOR,
 				tangent*w*ROUND_END_FACTOR
 			);
+			const float step(get_flattening_step(
+				curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+				0.0, 0.0, get_flattening_tolerance(), 2.0/SAMPLES ));
 			side_a.push_back(vertex);
 			side_b.push_back(vertex);
-			for(float n=0.0f;n<0.499999f;n+=2.0f/SAMPLES)
+			for(float n=0.0f;n<0.499999f;n+=step)
 			{
 				side_a.push_back(curve(0.5+n));
 				side_b.push_back(curve(0.5-n));
@@ -1370,7 +1393,10 @@ Advanced_Outline::add_tip(std::vector<Point> &side_a, std::vector<Point> &side_b
 				tangent*w*ROUND_END_FACTOR,
 				-tangent*w*ROUND_END_FACTOR
 			);
-			for(float n=0.0f;n<0.499999f;n+=2.0f/SAMPLES)
+			const float step(get_flattening_step(
+				curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+				0.0, 0.0, get_flattening_tolerance(), 2.0/SAMPLES ));
+			for(float n=0.0f;n<0.499999f;n+=step)
 			{
 				side_a.push_back(curve(1-n));
 				side_b.push_back(curve(n));
@@ -1477,7 +1503,10 @@ Advanced_Outline::add_cusp(std::vector<Point> &side_a, std::vector<Point> &side_
 					Point(-tangent*w*Angle::sin(angle*0+offset).get(),tangent*w*Angle::cos(angle*0+offset).get()),
 					Point(-tangent*w*Angle::sin(angle*1+offset).get(),tangent*w*Angle::cos(angle*1+offset).get())
 				);
-				for(float n=0.0f;n<0.999999f;n+=4.0f/SAMPLES)
+				const float step(get_flattening_step(
+					curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+					0.0, 0.0, get_flattening_tolerance(), 4.0/SAMPLES ));
+				for(float n=0.0f;n<0.999999f;n+=step)
 					side_a.push_back(curve(n));
 			}
 			if(cross < 0)
@@ -1498,7 +1527,10 @@ Advanced_Outline::add_cusp(std::vector<Point> &side_a, std::vector<Point> &side_
 					Point(-tangent*w*Angle::sin(angle*1+offset).get(),tangent*w*Angle::cos(angle*1+offset).get()),
 					Point(-tangent*w*Angle::sin(angle*0+offset).get(),tangent*w*Angle::cos(angle*0+offset).get())
 				);
-				for(float n=0.0f;n<0.999999f;n+=4.0f/SAMPLES)
+				const float step(get_flattening_step(
+					curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+					0.0, 0.0, get_flattening_tolerance(), 4.0/SAMPLES ));
+				for(float n=0.0f;n<0.999999f;n+=step)
 					side_b.push_back(curve(n));
 			}
 			break;
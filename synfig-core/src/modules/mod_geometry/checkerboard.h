@@ -64,6 +64,7 @@ public:
 	virtual synfig::Color get_color(synfig::Context context, const synfig::Point &pos)const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 
 	synfig::Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
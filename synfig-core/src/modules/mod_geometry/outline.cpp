@@ -236,6 +236,8 @@ Outline::sync_vfunc()
 	Vector last_tangent=iter->get_tangent1();
 	// Retrieve the parent canvas grow value
 	Real gv(exp(get_outline_grow_mark()));
+	// Allowed deviation of the outline from the exact curves
+	const Real tolerance(get_flattening_tolerance());
 	// if we are looped and drawing sharp cusps, we'll need a value for the incoming tangent
 	if (loop && sharp_cusps && last_tangent.is_equal_to(Vector::zero()))
 	{
@@ -279,6 +281,10 @@ Outline::sync_vfunc()
 
 		const derivative< hermite<Vector> > deriv(curve);
 
+		const float step(get_flattening_step(
+			iter->get_vertex(), next->get_vertex(), iter_t, next_t,
+			max(iter_w, next_w), 0.0, tolerance, 1.0/SAMPLES ));
+
 		if (first)
 			first_tangent = deriv(CUSP_TANGENT_ADJUST);
 
@@ -326,7 +332,7 @@ Outline::sync_vfunc()
 			const float length(curve.length());
 			float dist(0);
 			Point lastpoint;
-			for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+			for(float n=0.0f;n<0.999999f;n+=step)
 			{
 				const Vector d(deriv(n>CUSP_TANGENT_ADJUST?n:CUSP_TANGENT_ADJUST).perp().norm());
 				const Vector p(curve(n));
@@ -343,7 +349,7 @@ Outline::sync_vfunc()
 			}
 		}
 		else
-			for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+			for(float n=0.0f;n<0.999999f;n+=step)
 			{
 				const Vector d(deriv(n>CUSP_TANGENT_ADJUST?n:CUSP_TANGENT_ADJUST).perp().norm());
 				const Vector p(curve(n));
@@ -384,7 +390,10 @@ Outline::sync_vfunc()
 			-tangent*w*ROUND_END_FACTOR
 		);
 
-		for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+		const float step(get_flattening_step(
+			curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+			0.0, 0.0, tolerance, 1.0/SAMPLES ));
+		for(float n=0.0f;n<0.999999f;n+=step)
 			side_a.push_back(curve(n));
 	}
 
@@ -408,7 +417,10 @@ Outline::sync_vfunc()
 			tangent*w*ROUND_END_FACTOR
 		);
 
-		for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+		const float step(get_flattening_step(
+			curve.p1(), curve.p2(), curve.t1(), curve.t2(),
+			0.0, 0.0, tolerance, 1.0/SAMPLES ));
+		for(float n=0.0f;n<0.999999f;n+=step)
 			side_a.push_back(curve(n));
 	}
 
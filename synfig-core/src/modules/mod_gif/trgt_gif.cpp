@@ -38,6 +38,8 @@
 #include <ETL/stringf>
 #include "trgt_gif.h"
 #include <cstdio>
+#include <algorithm>
+#include <glib.h>
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -48,6 +50,9 @@ using namespace etl;
 
 #define MAX_FRAME_RATE	(20.0)
 
+// Minimal height of band of rows, quantized by separate thread
+#define MIN_BAND_HEIGHT	(64)
+
 /* === G L O B A L S ======================================================= */
 
 SYNFIG_TARGET_INIT(gif);
@@ -77,11 +82,14 @@ gif::gif(const char *filename_, const synfig::TargetParam & /* params */):
 	color_bits(8),
 	iframe_density(30),
 	loop_count(0x7fff),
-	local_palette(true)
+	local_palette(true),
+	curr_build_off_previous(false),
+	encoder(NULL)
 { }
 
 gif::~gif()
 {
+	wait_encoder();
 	if(file)
 		fputc(';',file.get());	// Image terminator
 }
@@ -147,7 +155,7 @@ gif::init(synfig::ProgressCallback * /* cb */)
 	if(!local_palette)
 	{
 		curr_palette=Palette::grayscale(256/(1<<(8-rootsize))-1);
-		output_curr_palette();
+		output_palette(curr_palette);
 	}
 
 	if(loop_count && multi_image)
@@ -167,14 +175,14 @@ gif::init(synfig::ProgressCallback * /* cb */)
 }
 
 void
-gif::output_curr_palette()
+gif::output_palette(const Palette &palette)
 {
 	// Output the color table
-	for(i=0;i<256/(1<<(8-rootsize));i++)
+	for(int i=0;i<256/(1<<(8-rootsize));i++)
 	{
-		if(i<(signed)curr_palette.size())
+		if(i<(signed)palette.size())
 		{
-			Color color(curr_palette[i].color.clamped());
+			Color color(palette[i].color.clamped());
 			//fputc(i*(1<<(8-rootsize)),file.get());
 			//fputc(i*(1<<(8-rootsize)),file.get());
 			//fputc(i*(1<<(8-rootsize)),file.get());
@@ -211,17 +219,97 @@ gif::start_frame(synfig::ProgressCallback *callback)
 	return true;
 }
 
+void
+gif::quantize_rows(int y0, int y1)
+{
+	int w=desc.get_w();
+	bool build_off_previous(curr_build_off_previous);
+
+	for(int y=y0;y<y1;y++)
+	{
+		for(int x=0;x<w;x++)
+		{
+			Color color(curr_surface[y][x].clamped());
+			int index(curr_index.find_closest(color));
+			if(index<0)
+				index=0;
+			const Color &palette_color(curr_palette[index].color);
+
+			if(dithering)
+			{
+				// error is diffused to the next rows,
+				// so dithered frame is always quantized by single band
+				Color error(color-palette_color);
+				if(y+1<y1)
+				{
+					if(x>0)
+						curr_surface[y+1][x-1]  += error * ((float)3/(float)16);
+					curr_surface[y+1][x]    += error * ((float)5/(float)16);
+					if(w>x+1)
+						curr_surface[y+1][x+1]  += error * ((float)1/(float)16);
+				}
+				if(w>x+1)
+					curr_surface[y][x+1]    += error * ((float)7/(float)16);
+			}
+
+			curr_frame[y][x]=index;
+
+			unsigned int value=curr_frame[y][x];
+			if(build_off_previous)
+				value++;
+			if(value>(unsigned)(1<<rootsize)-1)
+				value=(1<<rootsize)-1;
+
+			// If the pixel is the same as the one that
+			// is already there, then we should make it
+			// transparent
+			if(build_off_previous)
+			{
+				if(lossy)
+				{
+					int prev_index((int)prev_frame[y][x]-1);
+
+					// Lossy
+					if(
+						prev_index<0 || prev_index>=(int)prev_palette.size() ||
+						abs( ( palette_color-prev_palette[prev_index].color ).get_y() ) > (1.0/16.0) ||
+//						abs((int)value-(int)prev_frame[y][x])>2||
+//						(value<=2 && value!=prev_frame[y][x]) ||
+						(imagecount%iframe_density)==0 || imagecount==desc.get_frame_end()-1 ) // lossy version
+						prev_frame[y][x]=value;
+					else
+					{
+						prev_frame[y][x]=value;
+						value=0;
+					}
+				}
+				else
+				{
+					// lossless version
+					if(value!=prev_frame[y][x])
+						prev_frame[y][x]=value;
+					else
+						value=0;
+				}
+			}
+			else
+			prev_frame[y][x]=value;
+
+			curr_encoded.pixels[y*w+x]=value;
+		}
+	}
+}
+
 void
 gif::end_frame()
 {
-	int w=desc.get_w(),h=desc.get_h(),i;
-	unsigned int value;
+	int w=desc.get_w(),h=desc.get_h();
 	int
 		delaytime=round_to_int(100.0/desc.get_frame_rate());
 
 	bool build_off_previous(multi_image);
 
-	Palette prev_palette(curr_palette);
+	prev_palette=curr_palette;
 
 	// Fill in the background color
 	if(get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)
@@ -272,14 +360,70 @@ gif::end_frame()
 	if(has_transparency)
 		gec_flags|=1;
 
+	// Quantize the frame. Without dithering pixels are independent,
+	// so bands of rows are processed in parallel. Dithering diffuses
+	// the error through the whole frame, so it runs sequentially
+	// and result doesn't depend on count of processors.
+	curr_index=PaletteIndex(curr_palette);
+	curr_build_off_previous=build_off_previous;
+	curr_encoded.pixels.resize(w*h);
+
+	int bands=dithering ? 1 : std::max(1,std::min((int)g_get_num_processors(),h/MIN_BAND_HEIGHT));
+	std::vector<Glib::Threads::Thread*> threads;
+	for(int band=1;band<bands;band++)
+		threads.push_back(Glib::Threads::Thread::create(
+			sigc::bind(sigc::mem_fun(*this,&gif::quantize_rows),band*h/bands,(band+1)*h/bands) ));
+	quantize_rows(0,h/bands);
+	for(std::vector<Glib::Threads::Thread*>::iterator iter=threads.begin();iter!=threads.end();++iter)
+		(*iter)->join();
+
+	curr_encoded.gec_flags=gec_flags;
+	curr_encoded.delaytime=delaytime;
+	curr_encoded.transparent_index=transparent_index;
+	curr_encoded.palette.clear();
+	if(local_palette)
+	{
+		curr_encoded.palette=curr_palette;
+		if(build_off_previous)
+			curr_encoded.palette.insert(curr_encoded.palette.begin(),Color(1,0,1,0));
+	}
+
+	// Compress this frame while the next one is rendered and quantized
+	wait_encoder();
+	encoding.pixels.swap(curr_encoded.pixels);
+	encoding.palette.swap(curr_encoded.palette);
+	encoding.gec_flags=curr_encoded.gec_flags;
+	encoding.delaytime=curr_encoded.delaytime;
+	encoding.transparent_index=curr_encoded.transparent_index;
+	encoder=Glib::Threads::Thread::create(sigc::mem_fun(*this,&gif::encode_frame));
+
+	imagecount++;
+}
+
+void
+gif::wait_encoder()
+{
+	if(encoder)
+	{
+		encoder->join();
+		encoder=NULL;
+	}
+}
+
+void
+gif::encode_frame()
+{
+	int w=desc.get_w(),h=desc.get_h();
+	int delaytime(encoding.delaytime);
+
 	// output the Graphic Control Extension
 	fputc(0x21,file.get()); // Extension introducer
 	fputc(0xF9,file.get()); // Graphic Control Label
 	fputc(4,file.get()); // Block Size
-	fputc(gec_flags,file.get()); // Flags (Packed Fields)
+	fputc(encoding.gec_flags,file.get()); // Flags (Packed Fields)
 	fputc(delaytime&0x000000ff,file.get()); // Delay Time (MSB)
 	fputc((delaytime&0x0000ff00)>>8,file.get()); // Delay Time (LSB)
-	fputc(transparent_index,file.get()); // Transparent Color Index
+	fputc(encoding.transparent_index,file.get()); // Transparent Color Index
 	fputc(0,file.get()); // Block Terminator
 
 	// output the image header
@@ -297,16 +441,8 @@ gif::end_frame()
 	else
 		fputc(0x00+ rootsize-1,file.get());	// flags
 
-
 	if(local_palette)
-	{
-		Palette out(curr_palette);
-
-		if(build_off_previous)
-			curr_palette.insert(curr_palette.begin(),Color(1,0,1,0));
-		output_curr_palette();
-		curr_palette=out;
-	}
+		output_palette(encoding.palette);
 
 	bs=bitstream(file);
 
@@ -322,110 +458,44 @@ gif::end_frame()
 	// Push a table reset into the bitstream
 	bs.push_value(1<<rootsize,codesize);
 
-	for(int cur_scanline=0;cur_scanline<desc.get_h();cur_scanline++)
+	// Now we compress it!
+	for(std::vector<unsigned char>::const_iterator iter=encoding.pixels.begin();iter!=encoding.pixels.end();++iter)
 	{
-		//convert_color_format(curr_frame[cur_scanline], curr_surface[cur_scanline], desc.get_w(), PF_GRAY, gamma());
+		int value(*iter);
 
-		// Now we compress it!
-		for(i=0;i<w;i++)
+		next=node->FindCode(value);
+		if(next)
+			node=next;
+		else
 		{
-			Color color(curr_surface[cur_scanline][i].clamped());
-			Palette::iterator iter(curr_palette.find_closest(color));
-
-			if(dithering)
-			{
-				Color error(color-iter->color);
-				//error*=0.25;
-				if(curr_surface.get_h()>cur_scanline+1)
-				{
-					curr_surface[cur_scanline+1][i-1]  += error * ((float)3/(float)16);
-					curr_surface[cur_scanline+1][i]    += error * ((float)5/(float)16);
-					if(curr_surface.get_w()>i+1)
-						curr_surface[cur_scanline+1][i+1]  += error * ((float)1/(float)16);
-				}
-				if(curr_surface.get_w()>i+1)
-					curr_surface[cur_scanline][i+1]    += error * ((float)7/(float)16);
-			}
+			node->AddNode(nextcode, value);
+			bs.push_value(node->code, codesize);
+			node = table->FindCode(value);
 
-			curr_frame[cur_scanline][i]=iter-curr_palette.begin();
+			// Check to see if we need to increase the codesize
+			if (nextcode == ( 1 << codesize))
+				codesize += 1;
 
-			value=curr_frame[cur_scanline][i];
-			if(build_off_previous)
-				value++;
-			if(value>(unsigned)(1<<rootsize)-1)
-				value=(1<<rootsize)-1;
+			nextcode += 1;
 
-			// If the pixel is the same as the one that
-			// is already there, then we should make it
-			// transparent
-			if(build_off_previous)
+			// check to see if we have filled up the table
+			if (nextcode == 4096)
 			{
-				if(lossy)
-				{
+				// output the clear code: make sure to use the current
+				// codesize
+				bs.push_value((unsigned) 1 << rootsize, codesize);
 
-					// Lossy
-					if(
-						abs( ( iter->color-prev_palette[prev_frame[cur_scanline][i]-1].color ).get_y() ) > (1.0/16.0) ||
-//						abs((int)value-(int)prev_frame[cur_scanline][i])>2||
-//						(value<=2 && value!=prev_frame[cur_scanline][i]) ||
-						(imagecount%iframe_density)==0 || imagecount==desc.get_frame_end()-1 ) // lossy version
-						prev_frame[cur_scanline][i]=value;
-					else
-					{
-						prev_frame[cur_scanline][i]=value;
-						value=0;
-					}
-				}
-				else
-				{
-					// lossless version
-					if(value!=prev_frame[cur_scanline][i])
-						prev_frame[cur_scanline][i]=value;
-					else
-						value=0;
-				}
-			}
-			else
-			prev_frame[cur_scanline][i]=value;
+				delete table;
+				table = lzwcode::NewTable((1<<rootsize));
+				codesize = rootsize + 1;
+				nextcode = (1 << rootsize) + 2;
 
-			next=node->FindCode(value);
-			if(next)
-				node=next;
-			else
-			{
-				node->AddNode(nextcode, value);
-				bs.push_value(node->code, codesize);
+				// since we have a new table, need the correct prefix
 				node = table->FindCode(value);
-
-				// Check to see if we need to increase the codesize
-				if (nextcode == ( 1 << codesize))
-					codesize += 1;
-
-				nextcode += 1;
-
-				// check to see if we have filled up the table
-				if (nextcode == 4096)
-				{
-					// output the clear code: make sure to use the current
-					// codesize
-					bs.push_value((unsigned) 1 << rootsize, codesize);
-
-					delete table;
-					table = lzwcode::NewTable((1<<rootsize));
-					codesize = rootsize + 1;
-					nextcode = (1 << rootsize) + 2;
-
-					// since we have a new table, need the correct prefix
-					node = table->FindCode(value);
-				}
 			}
 		}
 	}
 
-
-
-
-
 	// Push the last code onto the bitstream
 	bs.push_value(node->code,codesize);
 
@@ -440,7 +510,6 @@ gif::end_frame()
 	fputc(0,file.get());		// Block terminator
 
 	fflush(file.get());
-	imagecount++;
 }
 
 synfig::Color*
@@ -33,6 +33,8 @@
 #include <synfig/string.h>
 #include <synfig/smartfile.h>
 #include <cstdio>
+#include <vector>
+#include <glibmm/threads.h>
 #include <synfig/surface.h>
 #include <synfig/palette.h>
 #include <synfig/targetparam.h>
@@ -162,6 +164,18 @@ private:
 		}
 	};
 
+	// Quantized frame prepared for the encoder thread
+	struct frame
+	{
+		std::vector<unsigned char> pixels;
+		synfig::Palette palette;
+		int gec_flags;
+		int delaytime;
+		int transparent_index;
+
+		frame(): gec_flags(), delaytime(), transparent_index() { }
+	};
+
 private:
 	bitstream bs;
 	synfig::String filename;
@@ -192,7 +206,20 @@ private:
 
 	synfig::Palette curr_palette;
 
-	void output_curr_palette();
+	// Quantization of the current frame, shared by the band threads
+	synfig::Palette prev_palette;
+	synfig::PaletteIndex curr_index;
+	bool curr_build_off_previous;
+	frame curr_encoded;
+
+	// Previous frame is compressed in background while the next one renders
+	frame encoding;
+	Glib::Threads::Thread *encoder;
+
+	void output_palette(const synfig::Palette &palette);
+	void quantize_rows(int y0, int y1);
+	void encode_frame();
+	void wait_encoder();
 
 public:
 	gif(const char *filename, const synfig::TargetParam& /* params */);
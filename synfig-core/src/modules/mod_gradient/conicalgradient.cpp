@@ -43,6 +43,8 @@
 #include <synfig/valuenode.h>
 #include <synfig/angle.h>
 
+#include <synfig/rendering/common/task/taskgradient.h>
+
 #include "conicalgradient.h"
 
 #endif
@@ -484,3 +486,15 @@ ConicalGradient::compile_mesh(cairo_pattern_t* pattern, Gradient mygradient, Rea
 	}
 	return cpoints_all_opaque;
 }
+
+rendering::Task::Handle
+ConicalGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->type = rendering::TaskGradient::TYPE_CONICAL;
+	task->gradient = param_gradient.get(Gradient());
+	task->p1 = param_center.get(Point());
+	task->angle = param_angle.get(Angle());
+	task->zigzag = param_symmetric.get(bool());
+	return task;
+}
@@ -80,124 +80,24 @@ inline float calculate_distance(const synfig::BLinePoint& a,const synfig::BLineP
 #endif
 }
 
-inline float calculate_distance(const std::vector<synfig::BLinePoint>& bline, bool bline_loop)
-{
-	std::vector<synfig::BLinePoint>::const_iterator iter,next,ret;
-	std::vector<synfig::BLinePoint>::const_iterator end(bline.end());
-
-	float dist(0);
-
-	if (bline.empty()) return dist;
-
-	next=bline.begin();
-
-	if(bline_loop)
-		iter=--bline.end();
-	else
-		iter=next++;
-
-	for(;next!=end;iter=next++)
-	{
-		// Setup the curve
-		etl::hermite<Vector> curve(
-			iter->get_vertex(),
-			next->get_vertex(),
-			iter->get_tangent2(),
-			next->get_tangent1());
-
-//		dist+=calculate_distance(*iter,*next);
-		dist+=curve.length();
-	}
-
-	return dist;
-}
-
 std::vector<synfig::BLinePoint>::const_iterator
-find_closest(bool fast, const std::vector<synfig::BLinePoint>& bline,const Point& p,float& t,bool loop=false,float *bline_dist_ret=0)
+find_closest(bool fast, const BLineIndex &bline_index,const Point& p,float& t,float *bline_dist_ret=0)
 {
-	std::vector<synfig::BLinePoint>::const_iterator iter,next,ret;
-	std::vector<synfig::BLinePoint>::const_iterator end(bline.end());
-
-	ret=bline.end();
-	float dist(100000000000.0);
-
-	next=bline.begin();
-
-	float best_bline_dist(0);
-	//float best_bline_len(0);
-	float total_bline_dist(0);
-	float best_pos(0);
-	etl::hermite<Vector> best_curve;
-
-	if(loop)
-		iter=--bline.end();
-	else
-		iter=next++;
+	Real pos;
+	const int index = bline_index.find_closest(fast, p, pos);
+	if (index < 0)
+		return bline_index.get_bline().end();
 
-	Point bp;
-
-	for(;next!=end;iter=next++)
-	{
-		// Setup the curve
-		etl::hermite<Vector> curve(
-			iter->get_vertex(),
-			next->get_vertex(),
-			iter->get_tangent2(),
-			next->get_tangent1());
-
-		/*
-		const float t(curve.find_closest(p,6,0.01,0.99));
-		bp=curve(t);if((bp-p).mag_squared()<dist) { ret=iter; dist=(bp-p).mag_squared(); ret_t=t; }
-		*/
-
-		float thisdist(0);
-		float len(0);
-		if(bline_dist_ret)
-		{
-			//len=calculate_distance(*iter,*next);
-			len=curve.length();
-		}
-
-		if (fast)
-		{
-#define POINT_CHECK(x) bp=curve(x);	thisdist=(bp-p).mag_squared(); if(thisdist<dist) { ret=iter; dist=thisdist; best_bline_dist=total_bline_dist; /* best_bline_len=len; */ best_curve=curve; }
-			POINT_CHECK(0.0001);
-			POINT_CHECK((1.0/6.0));
-			POINT_CHECK((2.0/6.0));
-			POINT_CHECK((3.0/6.0));
-			POINT_CHECK((4.0/6.0));
-			POINT_CHECK((5.0/6.0));
-			POINT_CHECK(0.9999);
-		}
-		else
-		{
-			float pos = curve.find_closest(fast, p);
-			thisdist=(curve(pos)-p).mag_squared();
-			if(thisdist<dist)
-			{
-				ret=iter;
-				dist=thisdist;
-				best_bline_dist=total_bline_dist;
-				//best_bline_len=len;
-				best_curve=curve;
-				best_pos = pos;
-			}
-		}
-
-		total_bline_dist+=len;
-	}
-
-	t = best_pos;
+	const BLineIndex::Segment &segment = bline_index.get_segments()[index];
+	t = pos;
 
 	if(bline_dist_ret)
 	{
-		//! \todo is this a redundant call to find_closest()?
 		// note bline_dist_ret is null except when 'perpendicular' is true
-		*bline_dist_ret=best_bline_dist+best_curve.find_distance(0,best_curve.find_closest(fast, p));
-//		*bline_dist_ret=best_bline_dist+best_curve.find_closest(fast, p)*best_bline_len;
+		*bline_dist_ret=segment.offset+segment.curve.find_distance(0,fast ? segment.curve.find_closest(fast, p) : pos);
 	}
 
-	return ret;
+	return bline_index.get_bline().begin() + segment.index;
 }
 
 /* === M E T H O D S ======================================================= */
@@ -205,8 +105,8 @@ find_closest(bool fast, const std::vector<synfig::BLinePoint>& bline,const Point
 inline void
 CurveGradient::sync()
 {
-	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
-	curve_length_=calculate_distance(bline, bline_loop);
+	bline_index.build(param_bline.get_list_of(BLinePoint()), bline_loop);
+	curve_length_=bline_index.get_length();
 }
 
 
@@ -248,8 +148,8 @@ CurveGradient::color_func(const Point &point_, int quality, float supersample)co
 {
 	Point origin=param_origin.get(Point());
 	Real width=param_width.get(Real());
-	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
-	Gradient gradient=param_gradient.get(Gradient());
+	const std::vector<synfig::BLinePoint> &bline(bline_index.get_bline());
+	const Gradient &gradient=param_gradient.get(Gradient());
 	bool loop=param_loop.get(bool());
 	bool zigzag=param_zigzag.get(bool());
 	bool perpendicular=param_perpendicular.get(bool());
@@ -283,12 +183,12 @@ CurveGradient::color_func(const Point &point_, int quality, float supersample)co
 		// Taking into account looping.
 		if(perpendicular)
 		{
-			next=find_closest(fast,bline,point,t,bline_loop,&perp_dist);
+			next=find_closest(fast,bline_index,point,t,&perp_dist);
 			perp_dist/=curve_length_;
 		}
 		else					// not perpendicular
 		{
-			next=find_closest(fast,bline,point,t,bline_loop);
+			next=find_closest(fast,bline_index,point,t);
 		}
 
 		iter=next++;
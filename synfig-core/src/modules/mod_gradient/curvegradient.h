@@ -33,6 +33,7 @@
 #include <synfig/vector.h>
 #include <synfig/layers/layer_composite.h>
 #include <synfig/gradient.h>
+#include <synfig/blineindex.h>
 #include <synfig/blinepoint.h>
 
 /* === M A C R O S ========================================================= */
@@ -69,6 +70,7 @@ private:
 
 	Real curve_length_;
 	bool bline_loop;
+	BLineIndex bline_index;
 
 	void sync();
 
@@ -87,6 +89,7 @@ public:
 	Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 };
 
 /* === E N D =============================================================== */
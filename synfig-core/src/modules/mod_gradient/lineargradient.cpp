@@ -46,6 +46,8 @@
 #include <synfig/value.h>
 #include <synfig/valuenode.h>
 
+#include <synfig/rendering/common/task/taskgradient.h>
+
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -399,3 +401,19 @@ LinearGradient::compile_gradient(cairo_pattern_t* pattern, Gradient mygradient)c
 	}
 	return cpoints_all_opaque;
 }
+
+rendering::Task::Handle
+LinearGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	Params params;
+	fill_params(params);
+
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->type = rendering::TaskGradient::TYPE_LINEAR;
+	task->gradient = params.gradient;
+	task->p1 = params.p1;
+	task->p2 = params.p2;
+	task->loop = params.loop;
+	task->zigzag = params.zigzag;
+	return task;
+}
@@ -43,6 +43,8 @@
 #include <synfig/value.h>
 #include <synfig/valuenode.h>
 
+#include <synfig/rendering/common/task/taskgradient.h>
+
 #include "radialgradient.h"
 
 #endif
@@ -367,3 +369,15 @@ RadialGradient::compile_gradient(cairo_pattern_t* pattern, Gradient mygradient)c
 	return cpoints_all_opaque;
 }
 
+rendering::Task::Handle
+RadialGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->type = rendering::TaskGradient::TYPE_RADIAL;
+	task->gradient = param_gradient.get(Gradient());
+	task->p1 = param_center.get(Point());
+	task->radius = param_radius.get(Real());
+	task->loop = param_loop.get(bool());
+	task->zigzag = param_zigzag.get(bool());
+	return task;
+}
@@ -43,6 +43,8 @@
 #include <synfig/valuenode.h>
 #include <synfig/cairo_renddesc.h>
 
+#include <synfig/rendering/common/task/taskgradient.h>
+
 #include "spiralgradient.h"
 
 #endif
@@ -334,5 +336,15 @@ SpiralGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality
 	return true;
 }
 
-
-
+rendering::Task::Handle
+SpiralGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->type = rendering::TaskGradient::TYPE_SPIRAL;
+	task->gradient = param_gradient.get(Gradient());
+	task->p1 = param_center.get(Point());
+	task->radius = param_radius.get(Real());
+	task->angle = param_angle.get(Angle());
+	task->clockwise = param_clockwise.get(bool());
+	return task;
+}
@@ -239,6 +239,11 @@ ValueNode_Random::randomize_seed()
 	}
 }
 
+// random value changes by time with speed
+void
+ValueNode_Random::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_Random::get_children_vocab_vfunc()const
 {
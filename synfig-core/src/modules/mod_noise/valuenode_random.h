@@ -72,6 +72,7 @@ public:
 protected:
 	LinkableValueNode* create_new()const;
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x);
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 
 public:
 	using synfig::LinkableValueNode::get_link_vfunc;
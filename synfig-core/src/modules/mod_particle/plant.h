@@ -125,6 +125,7 @@ public:
 	virtual bool set_version(const String &ver);
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_splittable()const { return true; }
 
 	virtual bool accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
 	virtual bool accelerated_cairorender(Context context, cairo_t *cr, int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
@@ -87,19 +87,23 @@ png_trgt_spritesheet::png_out_warning(png_struct *png_data,const char *msg)
 
 png_trgt_spritesheet::png_trgt_spritesheet(const char *Filename, const synfig::TargetParam &params):
 	ready(false),
-	initialized(false),
 	imagecount(),
 	lastimage(),
 	numimages(),
-	cur_y(0),
-	cur_row(0),
-	cur_col(0),
+	cur_frame(-1),
+	next_sequential_frame(0),
 	params(params),
-	color_data(0),
 	sheet_width(0),
 	sheet_height(0),
+	page_rows(0),
+	next_band(0),
 	in_file_pointer(0),
+	in_image_loaded(false),
+	in_image_row(0),
 	out_file_pointer(0),
+	out_png_ptr(0),
+	out_info_ptr(0),
+	cur_page(-1),
 	cur_out_image_row(0),
 	filename(Filename),
 	sequence_separator(params.sequence_separator),
@@ -112,17 +116,54 @@ png_trgt_spritesheet::~png_trgt_spritesheet()
 {
 	cout << "~png_trgt_spritesheet()" << endl;
 	if (ready)
-		write_png_file ();
-	if (color_data)
-	{
-		for (unsigned int i = 0; i < sheet_height; i++)
-			delete []color_data[i];
-		delete []color_data;
-	}
+		finish();
+	close_page();
+	if (in_image.png_ptr)
+		png_destroy_read_struct(&in_image.png_ptr, &in_image.info_ptr, NULL);
+	if (in_file_pointer)
+		fclose(in_file_pointer);
 	if (overflow_buff)
 		delete []overflow_buff;
 }
 
+int
+png_trgt_spritesheet::get_frame_row(int frame)const
+{
+	return params.dir == TargetParam::HR ? frame / params.columns : frame % params.rows;
+}
+
+int
+png_trgt_spritesheet::get_frame_column(int frame)const
+{
+	return params.dir == TargetParam::HR ? frame % params.columns : frame / params.rows;
+}
+
+int
+png_trgt_spritesheet::get_page_count()const
+{
+	return (params.rows + page_rows - 1) / page_rows;
+}
+
+unsigned int
+png_trgt_spritesheet::get_page_height(int page)const
+{
+	if (get_page_count() == 1)
+		return sheet_height;
+	unsigned int rows = std::min(page_rows, (unsigned int)params.rows - page*page_rows);
+	return params.offset_y + rows * desc.get_h();
+}
+
+synfig::String
+png_trgt_spritesheet::get_page_filename(int page)const
+{
+	if (get_page_count() == 1)
+		return filename;
+	return filename_sans_extension(filename)
+		 + sequence_separator
+		 + strprintf("%04d", page)
+		 + filename_extension(filename);
+}
+
 bool
 png_trgt_spritesheet::set_rend_desc(RendDesc *given_desc)
 {
@@ -131,10 +172,10 @@ png_trgt_spritesheet::set_rend_desc(RendDesc *given_desc)
     desc=*given_desc;
     imagecount=desc.get_frame_start();
     lastimage=desc.get_frame_end();
-    numimages = (lastimage - imagecount) + 1;		
+    numimages = (lastimage - imagecount) + 1;
 
 	overflow_buff = new Color[desc.get_w()];
-	
+
 	//Reset on uninitialized values
 	if ((params.columns == 0) || (params.rows == 0))
 	{
@@ -152,10 +193,16 @@ png_trgt_spritesheet::set_rend_desc(RendDesc *given_desc)
 		synfig::error("Bad sheet parameters. Sheet overflow.");
 		return false;
 	}
-	
+
 	cout << "Frame count" << numimages << endl;
 
-	bool is_loaded = false;
+	page_rows = params.page_rows > 0 && params.page_rows < params.rows
+	          ? params.page_rows : params.rows;
+	if (get_page_count() > 1 && params.append)
+	{
+		synfig::warning("Sprite sheet is split into pages, existing file will be overwritten.");
+		params.append = false;
+	}
 
 	if (params.append)
 	{
@@ -164,68 +211,85 @@ png_trgt_spritesheet::set_rend_desc(RendDesc *given_desc)
 			synfig::error(strprintf("[read_png_file] File %s could not be opened for reading", filename.c_str()));
 		else
 		{
-			is_loaded = load_png_file();
-			if (!is_loaded)
+			in_image_loaded = load_png_file();
+			if (!in_image_loaded)
+			{
+				if (in_image.png_ptr)
+					png_destroy_read_struct(&in_image.png_ptr, &in_image.info_ptr, NULL);
 				fclose(in_file_pointer);
+				in_file_pointer = NULL;
+				in_image = PngImage();
+			}
 		}
 	}
-		
+
 	//I select such size which appropriate to contain whole sprite sheet.
 	unsigned int target_width = params.columns * desc.get_w() + params.offset_x;
-	unsigned int target_height = params.rows * desc.get_h() + params.offset_y;
+	unsigned int target_height = page_rows * desc.get_h() + params.offset_y;
 	sheet_width = in_image.width > target_width? in_image.width : target_width;
 	sheet_height = in_image.height > target_height? in_image.height : target_height;
 
-	if (sheet_width * sheet_height > 5000 * 2000)
-	{
-		synfig::error(strprintf(_("The image is too large. It's size must be not more than 5000*2000=10000000 px. Now is %d*%d=%d px."), 
-		                          sheet_width, sheet_height, sheet_width * sheet_height));
-		return false;
-	}
-	
 	cout << "Sheet size: " << sheet_width << "x" << sheet_height << endl;
+	if (get_page_count() > 1)
+		synfig::info("png_trgt_spritesheet: sheet is split into %d pages", get_page_count());
+
+	// frames are rendered in order of rows of the sheet,
+	// so each row can be written as soon as it's complete
+	frame_order.clear();
+	band_frames.assign(params.rows, 0);
+	for(int row = 0; row < params.rows; ++row)
+		for(int column = 0; column < params.columns; ++column)
+		{
+			int frame = params.dir == TargetParam::HR
+			          ? row * params.columns + column
+			          : column * params.rows + row;
+			if (frame < numimages)
+			{
+				frame_order.push_back(frame);
+				++band_frames[row];
+			}
+		}
 
-	cout << "Color size: " << sizeof(Color) << endl;
-	
-	color_data = new Color*[sheet_height];
-	for (unsigned int i = 0; i < sheet_height; i++)
-		color_data[i] = new Color[sheet_width];
-	
-	if (is_loaded)
-		ready = read_png_file();
-	else
-		ready = true;
-	
+	out_row.resize(sheet_width);
+	out_buffer.resize(4 * sheet_width);
+
+	ready = true;
     return true;
 }
 
+int
+png_trgt_spritesheet::next_frame(Time& time)
+{
+	int step = curr_frame_;
+	int remaining = Target_Scanline::next_frame(time);
+	if (step >= 0 && step < (int)frame_order.size())
+	{
+		cur_frame = frame_order[step];
+		if (numimages > 1)
+			time = (desc.get_time_end() - desc.get_time_start())*cur_frame/(numimages - 1) + desc.get_time_start();
+	}
+	return remaining;
+}
+
 void
 png_trgt_spritesheet::end_frame()
 {
 	cout << "end_frame()" << endl;
-		
+
     imagecount++;
-	cur_y = 0;
-	if (params.dir == TargetParam::HR)
-	{
-		//Horizontal render. Columns increment
-		cur_col++;
-		if (cur_col >= (unsigned int)params.columns)
-		{
-			cur_row++;
-			cur_col = 0;
-		}
-	}
-	else
+
+	if (cur_frame >= 0 && cur_frame < numimages)
 	{
-		//Vertical render. Rows increment.
-		cur_row++;
-		if (cur_row >= (unsigned int) params.rows)
+		Band &band = bands[get_frame_row(cur_frame)];
+		if (!band.cells[get_frame_column(cur_frame)])
 		{
-			cur_col++;
-			cur_row = 0;
+			band.cells[get_frame_column(cur_frame)] = true;
+			--band.frames_left;
 		}
 	}
+	cur_frame = -1;
+
+	write_bands(false);
 }
 
 bool
@@ -233,34 +297,47 @@ png_trgt_spritesheet::start_frame(synfig::ProgressCallback *callback)
 {
 	cout << "start_frame()" << endl;
     if(callback)
-		callback->task(strprintf("%s, (frame %d/%d)", filename.c_str(), 
+		callback->task(strprintf("%s, (frame %d/%d)", filename.c_str(),
 		                         imagecount - (lastimage - numimages), numimages).c_str());
 
+	// frames added without next_frame() comes in order of time
+	if (cur_frame < 0)
+		cur_frame = next_sequential_frame++;
+
+	if (cur_frame < numimages)
+	{
+		Band &band = bands[get_frame_row(cur_frame)];
+		if (band.pixels.empty())
+		{
+			band.pixels.resize(params.columns * desc.get_w() * desc.get_h(), Color::alpha());
+			band.cells.resize(params.columns, false);
+			band.frames_left = band_frames[get_frame_row(cur_frame)];
+		}
+	}
+
     return true;
 }
 
 Color *
-png_trgt_spritesheet::start_scanline(int /*scanline*/)
+png_trgt_spritesheet::start_scanline(int scanline)
 {
-	unsigned int y = cur_y + params.offset_y + cur_row * desc.get_h();
-	unsigned int x = cur_col * desc.get_w() + params.offset_x;
-	if ((x + desc.get_w() > sheet_width) || (y > sheet_height))
+	if (cur_frame < 0 || cur_frame >= numimages || scanline < 0 || scanline >= desc.get_h())
 	{
-		cout << "Buffer overflow. x: " << x << " y: " << y << endl; 
+		synfig::warning("png_trgt_spritesheet: buffer overflow, frame: %d, y: %d", cur_frame, scanline);
 		//TODO: Fix exception processing outside the module.
 		return overflow_buff; //Spike. Bad exception processing
 	}
-    return &color_data[y][x];
+	Band &band = bands[get_frame_row(cur_frame)];
+	return &band.pixels[(scanline * params.columns + get_frame_column(cur_frame)) * desc.get_w()];
 }
 
 bool
 png_trgt_spritesheet::end_scanline()
 {
-	cur_y++;
     return true;
 }
 
-//The func only loads file. Reading into the buffer in read_png_file().
+//The func only loads header of file. Rows are read in read_base_row().
 bool
 png_trgt_spritesheet::load_png_file()
 {
@@ -309,130 +386,119 @@ png_trgt_spritesheet::load_png_file()
     in_image.color_type = png_get_color_type(in_image.png_ptr, in_image.info_ptr);
     in_image.bit_depth = png_get_bit_depth(in_image.png_ptr, in_image.info_ptr);
 
-    png_read_update_info(in_image.png_ptr, in_image.info_ptr);
+    if (in_image.color_type == PNG_COLOR_TYPE_RGB)
+	{
+        synfig::error("[process_file] input file is PNG_COLOR_TYPE_RGB but must be PNG_COLOR_TYPE_RGBA "
+               "(lacks the alpha channel)");
+		in_image.width = in_image.height = 0;
+		return false;
+	}
 
+    if (in_image.color_type != PNG_COLOR_TYPE_RGBA || in_image.bit_depth != 8)
+	{
+        synfig::error(strprintf("[process_file] color_type of input file must be PNG_COLOR_TYPE_RGBA (%d) (is %d)",
+			PNG_COLOR_TYPE_RGBA, in_image.color_type));
+		in_image.width = in_image.height = 0;
+		return false;
+	}
 
-    /* read file */
-    if (setjmp(png_jmpbuf(in_image.png_ptr)))
+    if (png_get_interlace_type(in_image.png_ptr, in_image.info_ptr) != PNG_INTERLACE_NONE)
 	{
-        synfig::error("[read_png_file] Error during read_image");
+        synfig::error("[process_file] interlaced input file is not supported");
+		in_image.width = in_image.height = 0;
 		return false;
 	}
 
+    png_read_update_info(in_image.png_ptr, in_image.info_ptr);
+	in_buffer.resize(png_get_rowbytes(in_image.png_ptr, in_image.info_ptr));
+
 	return true;
 }
 
-bool 
-png_trgt_spritesheet::read_png_file()
+void
+png_trgt_spritesheet::read_base_row(unsigned int y)
 {
-	cout << "read_png_file()" << endl;
-	//Byte buffer for png data
-	png_bytep * row_pointers;
-    row_pointers = new png_bytep[in_image.height];
-    for (unsigned int y = 0; y < in_image.height; y++)
-            row_pointers[y] = new png_byte[png_get_rowbytes(in_image.png_ptr,in_image.info_ptr)];
-	cout << "row_pointers created" << endl;
-	
-	png_read_image(in_image.png_ptr, row_pointers);
-	cout << "image read" << endl;
-	
-    if (png_get_color_type(in_image.png_ptr, in_image.info_ptr) == PNG_COLOR_TYPE_RGB)
-	{
-        synfig::error("[process_file] input file is PNG_COLOR_TYPE_RGB but must be PNG_COLOR_TYPE_RGBA "
-               "(lacks the alpha channel)");
-		return false;
-	}
+	std::fill(out_row.begin(), out_row.end(), Color::alpha());
+
+	// existing sheet is only in the first page
+	if (!in_image_loaded || cur_page != 0 || y >= in_image.height || in_image_row != y)
+		return;
 
-    if (png_get_color_type(in_image.png_ptr, in_image.info_ptr) != PNG_COLOR_TYPE_RGBA)
+	if (setjmp(png_jmpbuf(in_image.png_ptr)))
 	{
-        synfig::error(strprintf("[process_file] color_type of input file must be PNG_COLOR_TYPE_RGBA (%d) (is %d)",
-			PNG_COLOR_TYPE_RGBA, png_get_color_type(in_image.png_ptr, in_image.info_ptr)));
-		return false;
+        synfig::error("[read_png_file] Error during read_image");
+		in_image_loaded = false;
+		return;
 	}
+	png_read_row(in_image.png_ptr, &in_buffer.front(), NULL);
+	++in_image_row;
 
-	cout << "colors checked" << endl;
-
-	//Gamma correction for PNG. I took 2.2 value from 
+	//Gamma correction for PNG. I took 2.2 value from
 	//http://www.libpng.org/pub/png/spec/1.2/PNG-GammaAppendix.html
 	//Also see gamma.h and gamma.cpp
-	Gamma gamma_png(2.2);
-	
+	static const Gamma gamma_png(2.2);
+
 	//From png bytes to synfig::Color convertion
-    for (unsigned int y = 0; y < in_image.height; y++) 
+	for (unsigned int x = 0; x < in_image.width; x++)
 	{
-        png_byte* row = row_pointers[y];
-        for (unsigned int x = 0; x < in_image.width; x++) 
-		{
-            png_byte* ptr = &(row[x*4]);
-			color_data[y][x].set_r(gamma_png.r_U8_to_F32(ptr[0]));
-			color_data[y][x].set_g(gamma_png.g_U8_to_F32(ptr[1]));
-			color_data[y][x].set_b(gamma_png.b_U8_to_F32(ptr[2]));
-			color_data[y][x].set_a((float)ptr[3] / 255.0f);
-        }
-    }
-
-	cout << "colors converted" << endl;
-	
-    for (unsigned int y = 0; y < in_image.height; y++)
-            delete []row_pointers[y];
-    delete row_pointers;
-	cout << "row_pointers deleted" << endl;
-	return true;
+		png_byte* ptr = &in_buffer[x*4];
+		out_row[x].set_r(gamma_png.r_U8_to_F32(ptr[0]));
+		out_row[x].set_g(gamma_png.g_U8_to_F32(ptr[1]));
+		out_row[x].set_b(gamma_png.b_U8_to_F32(ptr[2]));
+		out_row[x].set_a((float)ptr[3] / 255.0f);
+	}
 }
 
-bool 
-png_trgt_spritesheet::write_png_file()
+bool
+png_trgt_spritesheet::open_page(int page)
 {
-	cout << "write_png_file()" << endl;
-	png_structp png_ptr;
-	png_infop info_ptr;
-	unsigned char buffer [4 * sheet_width];
+	cur_page = page;
+	cur_out_image_row = 0;
+
+	// existing sheet is read while the new one is written, so write into temporary file
+	String page_filename = get_page_filename(page);
+	out_filename = in_image_loaded ? page_filename + ".tmp" : page_filename;
 
-	
-    if (filename == "-")
+    if (out_filename == "-")
     	out_file_pointer=stdout;
     else
-    	out_file_pointer=fopen(filename.c_str(), POPEN_BINARY_WRITE_TYPE);
+    	out_file_pointer=fopen(out_filename.c_str(), POPEN_BINARY_WRITE_TYPE);
 
-	
-    png_ptr=png_create_write_struct(PNG_LIBPNG_VER_STRING, (png_voidp)this,png_out_error, png_out_warning);
-    if (!png_ptr)
+	if (!out_file_pointer)
+	{
+		synfig::error(strprintf("Unable to open %s for write", out_filename.c_str()));
+		ready = false;
+		return false;
+	}
+
+    out_png_ptr=png_create_write_struct(PNG_LIBPNG_VER_STRING, (png_voidp)this,png_out_error, png_out_warning);
+    if (!out_png_ptr)
     {
         synfig::error("Unable to setup PNG struct");
-        fclose(out_file_pointer);
-        out_file_pointer=NULL;
+        ready = false;
         return false;
     }
 
-	
-    info_ptr= png_create_info_struct(png_ptr);
-    if (!info_ptr)
+    out_info_ptr= png_create_info_struct(out_png_ptr);
+    if (!out_info_ptr)
     {
         synfig::error("Unable to setup PNG info struct");
-        fclose(out_file_pointer);
-        out_file_pointer=NULL;
-        png_destroy_write_struct(&png_ptr,(png_infopp)NULL);
+        ready = false;
         return false;
     }
 
-	
-    if (setjmp(png_jmpbuf(png_ptr)))
+    if (setjmp(png_jmpbuf(out_png_ptr)))
     {
         synfig::error("Unable to setup longjump");
-        png_destroy_write_struct(&png_ptr, &info_ptr);
-        fclose(out_file_pointer);
-        out_file_pointer=NULL;
+        ready = false;
         return false;
     }
-    png_init_io(png_ptr,out_file_pointer);
-    png_set_filter(png_ptr,0,PNG_FILTER_NONE);
-
-	
-    setjmp(png_jmpbuf(png_ptr));
+    png_init_io(out_png_ptr,out_file_pointer);
+    png_set_filter(out_png_ptr,0,PNG_FILTER_NONE);
 
-	png_set_IHDR(png_ptr,info_ptr,
+	png_set_IHDR(out_png_ptr,out_info_ptr,
 	             sheet_width,
-	             sheet_height,
+	             get_page_height(page),
 	             8,
 	             (get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)?PNG_COLOR_TYPE_RGBA:PNG_COLOR_TYPE_RGB,
 	             PNG_INTERLACE_NONE,
@@ -440,10 +506,10 @@ png_trgt_spritesheet::write_png_file()
 	             PNG_FILTER_TYPE_DEFAULT);
     // Write the gamma
     //png_set_gAMA(png_ptr, info_ptr,1.0/gamma().get_gamma());
-    png_set_gAMA(png_ptr, info_ptr,gamma().get_gamma());
+    png_set_gAMA(out_png_ptr, out_info_ptr,gamma().get_gamma());
 
     // Write the physical size
-    png_set_pHYs(png_ptr,info_ptr,round_to_int(desc.get_x_res()),round_to_int(desc.get_y_res()),PNG_RESOLUTION_METER);
+    png_set_pHYs(out_png_ptr,out_info_ptr,round_to_int(desc.get_x_res()),round_to_int(desc.get_y_res()),PNG_RESOLUTION_METER);
 
     char title      [] = "Title";
     char description[] = "Description";
@@ -460,31 +526,145 @@ png_trgt_spritesheet::write_png_file()
         },
         { PNG_TEXT_COMPRESSION_NONE, software, synfig, strlen(synfig) },
     };
-    png_set_text(png_ptr,info_ptr,comments,sizeof(comments)/sizeof(png_text));
+    png_set_text(out_png_ptr,out_info_ptr,comments,sizeof(comments)/sizeof(png_text));
 
-    png_write_info_before_PLTE(png_ptr, info_ptr);
-    png_write_info(png_ptr, info_ptr);
+    png_write_info_before_PLTE(out_png_ptr, out_info_ptr);
+    png_write_info(out_png_ptr, out_info_ptr);
+	return true;
+}
 
-    //Writing spritesheet into png image
-	for (cur_out_image_row = 0; cur_out_image_row < sheet_height; cur_out_image_row++)
+void
+png_trgt_spritesheet::close_page()
+{
+	if (out_png_ptr)
 	{
-		convert_color_format(buffer, 
-		                     color_data[cur_out_image_row],
-		                     sheet_width, 
-		                     PF_RGB|(get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)?PF_A:PF_RGB, //Note: PF_RGB == 0
-		                     gamma());
-	
-		setjmp(png_jmpbuf(png_ptr));
-		png_write_row(png_ptr,buffer);
+		if (ready && !setjmp(png_jmpbuf(out_png_ptr)))
+			png_write_end(out_png_ptr,out_info_ptr);
+		png_destroy_write_struct(&out_png_ptr, out_info_ptr ? &out_info_ptr : (png_infopp)NULL);
+		out_png_ptr = NULL;
+		out_info_ptr = NULL;
 	}
-	cur_out_image_row = 0;
-    if(out_file_pointer)
-    {
-        png_write_end(png_ptr,info_ptr);
-        png_destroy_write_struct(&png_ptr, &info_ptr);
-        fclose(out_file_pointer);
-        out_file_pointer=NULL;
 
-    }
-	return true;
+	if (out_file_pointer)
+	{
+		if (out_file_pointer != stdout)
+			fclose(out_file_pointer);
+		out_file_pointer = NULL;
+
+		if (out_filename != get_page_filename(cur_page))
+		{
+			// replace the existing sheet, it should be already read
+			if (in_file_pointer)
+			{
+				png_destroy_read_struct(&in_image.png_ptr, &in_image.info_ptr, NULL);
+				fclose(in_file_pointer);
+				in_file_pointer = NULL;
+				in_image_loaded = false;
+			}
+			if (ready)
+			{
+				remove(get_page_filename(cur_page).c_str());
+				if (rename(out_filename.c_str(), get_page_filename(cur_page).c_str()))
+					synfig::error(strprintf("Unable to rename %s", out_filename.c_str()));
+			}
+			else
+				remove(out_filename.c_str());
+		}
+	}
+}
+
+void
+png_trgt_spritesheet::write_row()
+{
+	if (!ready || !out_png_ptr)
+		return;
+
+	convert_color_format(&out_buffer.front(),
+	                     &out_row.front(),
+	                     sheet_width,
+	                     (get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)?PF_A:PF_RGB, //Note: PF_RGB == 0
+	                     gamma());
+
+	if (setjmp(png_jmpbuf(out_png_ptr)))
+	{
+		ready = false;
+		return;
+	}
+	png_write_row(out_png_ptr,&out_buffer.front());
+	++cur_out_image_row;
+}
+
+void
+png_trgt_spritesheet::write_rows_until(unsigned int y)
+{
+	while(ready && cur_out_image_row < y)
+	{
+		read_base_row(cur_out_image_row);
+		write_row();
+	}
+}
+
+void
+png_trgt_spritesheet::write_band(unsigned int band_index, const Band &band)
+{
+	int page = band_index / page_rows;
+	while(ready && cur_page < page)
+	{
+		if (cur_page >= 0)
+		{
+			write_rows_until(get_page_height(cur_page));
+			close_page();
+		}
+		open_page(cur_page + 1);
+	}
+
+	unsigned int w = desc.get_w();
+	unsigned int h = desc.get_h();
+	unsigned int y = params.offset_y + (band_index - page*page_rows) * h;
+	write_rows_until(y);
+
+	for(unsigned int i = 0; ready && i < h; ++i)
+	{
+		read_base_row(cur_out_image_row);
+		for(int column = 0; column < params.columns; ++column)
+			if (band.cells[column])
+				std::copy(
+					band.pixels.begin() + (i * params.columns + column) * w,
+					band.pixels.begin() + (i * params.columns + column + 1) * w,
+					out_row.begin() + params.offset_x + column * w );
+		write_row();
+	}
+}
+
+void
+png_trgt_spritesheet::write_bands(bool force)
+{
+	while(ready && !bands.empty())
+	{
+		std::map<unsigned int, Band>::iterator iter = bands.begin();
+		if (!force && (iter->first != next_band || iter->second.frames_left > 0))
+			break;
+		write_band(iter->first, iter->second);
+		next_band = iter->first + 1;
+		bands.erase(iter);
+	}
+}
+
+void
+png_trgt_spritesheet::finish()
+{
+	// write incomplete bands too, if rendering was interrupted
+	write_bands(true);
+
+	if (cur_page < 0)
+		open_page(0);
+	while(ready)
+	{
+		write_rows_until(get_page_height(cur_page));
+		if (cur_page + 1 >= get_page_count())
+			break;
+		close_page();
+		open_page(cur_page + 1);
+	}
+	close_page();
 }
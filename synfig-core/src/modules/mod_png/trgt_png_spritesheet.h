@@ -38,6 +38,8 @@
 #include <synfig/string.h>
 #include <synfig/targetparam.h>
 #include <cstdio>
+#include <map>
+#include <vector>
 
 /* === M A C R O S ========================================================= */
 
@@ -45,6 +47,14 @@
 
 /* === C L A S S E S & S T R U C T S ======================================= */
 
+/*!	\class png_trgt_spritesheet
+**	\brief Writes frames into the cells of one or several PNG sheets.
+**
+**	Layout of the sheet is known before rendering, so frames are rendered
+**	row by row of the sheet and each finished row of frames (band) is
+**	written into the PNG immediately. Only unfinished bands are kept
+**	in memory. Existing sheet (in append mode) is read row by row too.
+*/
 class png_trgt_spritesheet : public synfig::Target_Scanline
 {
 	SYNFIG_TARGET_MODULE_EXT
@@ -55,7 +65,9 @@ private:
 			width(0),
 			height(0),
 			color_type(0),
-			bit_depth(0){}
+			bit_depth(0),
+			png_ptr(NULL),
+			info_ptr(NULL){}
 		unsigned int width;
 		unsigned int height;
 		png_byte color_type;
@@ -64,27 +76,67 @@ private:
 		png_infop info_ptr;
 	};
 
+	//! Row of frames in the sheet
+	struct Band
+	{
+		std::vector<synfig::Color> pixels;
+		std::vector<bool> cells; //!< columns with rendered frames
+		int frames_left;
+		Band(): frames_left(0) { }
+	};
+
 	static void png_out_error(png_struct *png,const char *msg);
 	static void png_out_warning(png_struct *png,const char *msg);
 	bool ready;
-	bool initialized;
 	int imagecount;
 	int lastimage;
 	int numimages;
-	unsigned int cur_y;
-	unsigned int cur_row;
-	unsigned int cur_col;
+	int cur_frame;
+	int next_sequential_frame;
 	synfig::TargetParam params;
-	synfig::Color ** color_data;
 	unsigned int sheet_width;
 	unsigned int sheet_height;
+	unsigned int page_rows;
+
+	std::vector<int> frame_order;
+	std::vector<int> band_frames;
+	std::map<unsigned int, Band> bands;
+	unsigned int next_band;
+
 	FILE * in_file_pointer;
+	PngImage in_image;
+	bool in_image_loaded;
+	unsigned int in_image_row;
+	std::vector<png_byte> in_buffer;
+
 	FILE * out_file_pointer;
+	png_structp out_png_ptr;
+	png_infop out_info_ptr;
+	synfig::String out_filename;
+	int cur_page;
 	unsigned int cur_out_image_row;
-	PngImage in_image;
+	std::vector<synfig::Color> out_row;
+	std::vector<unsigned char> out_buffer;
+
 	synfig::String filename;
 	synfig::String sequence_separator;
 	synfig::Color * overflow_buff;
+
+	int get_frame_row(int frame)const;
+	int get_frame_column(int frame)const;
+	int get_page_count()const;
+	unsigned int get_page_height(int page)const;
+	synfig::String get_page_filename(int page)const;
+
+	bool open_page(int page);
+	void close_page();
+	void read_base_row(unsigned int y);
+	void write_row();
+	void write_rows_until(unsigned int y);
+	void write_band(unsigned int band_index, const Band &band);
+	void write_bands(bool force);
+	void finish();
+
 public:
 	png_trgt_spritesheet(const char *filename, const synfig::TargetParam& /* params */);
 	virtual ~png_trgt_spritesheet();
@@ -92,11 +144,10 @@ public:
 	virtual bool set_rend_desc(synfig::RendDesc *desc);
 	virtual bool start_frame(synfig::ProgressCallback *cb);
 	virtual void end_frame();
+	virtual int next_frame(synfig::Time& time);
 
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline();
-	bool read_png_file();
-	bool write_png_file();
 	bool load_png_file();
 };
 
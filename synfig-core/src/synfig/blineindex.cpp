@@ -0,0 +1,220 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file blineindex.cpp
+**	\brief Spatial index of bline segments
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <algorithm>
+
+#include "blineindex.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+#define LEAF_SEGMENTS 4
+#define MAX_DEPTH 64
+
+/* === G L O B A L S ======================================================= */
+
+const Real BLineIndex::samples[BLineIndex::SAMPLES_COUNT] =
+	{ 0.0001, 1.0/6.0, 2.0/6.0, 3.0/6.0, 4.0/6.0, 5.0/6.0, 0.9999 };
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	inline Real distance_squared(const Rect &r, const Point &p)
+	{
+		Real dx = p[0] < r.minx ? r.minx - p[0] : p[0] > r.maxx ? p[0] - r.maxx : 0.0;
+		Real dy = p[1] < r.miny ? r.miny - p[1] : p[1] > r.maxy ? p[1] - r.maxy : 0.0;
+		return dx*dx + dy*dy;
+	}
+
+	class CenterLess
+	{
+	public:
+		const std::vector<BLineIndex::Segment> &segments;
+		int axis;
+		CenterLess(const std::vector<BLineIndex::Segment> &segments, int axis):
+			segments(segments), axis(axis) { }
+		Real center(int i) const
+		{
+			const Rect &r = segments[i].bounds;
+			return axis ? r.miny + r.maxy : r.minx + r.maxx;
+		}
+		bool operator() (int a, int b) const
+			{ return center(a) < center(b); }
+	};
+}
+
+/* === M E T H O D S ======================================================= */
+
+void
+BLineIndex::build(const std::vector<BLinePoint> &bline, bool loop)
+{
+	this->bline = bline;
+	this->loop = loop;
+	length = 0.0;
+	segments.clear();
+	order.clear();
+	nodes.clear();
+
+	if (bline.empty()) return;
+
+	// same order of segments as in the linear search, looped segment goes first
+	int count = (int)bline.size();
+	for(int i = loop ? count - 1 : 0, next = loop ? 0 : 1; next < count; i = next++)
+	{
+		const BLinePoint &a = bline[i];
+		const BLinePoint &b = bline[next];
+
+		segments.push_back(Segment());
+		Segment &s = segments.back();
+		s.index = i;
+		s.curve = Curve(a.get_vertex(), b.get_vertex(), a.get_tangent2(), b.get_tangent1());
+		s.length = s.curve.length();
+		s.offset = length;
+		s.bounds = Rect(s.curve.P1);
+		s.bounds.expand(s.curve.P1 + s.curve.T1/3);
+		s.bounds.expand(s.curve.P2 - s.curve.T2/3);
+		s.bounds.expand(s.curve.P2);
+		for(int j = 0; j < SAMPLES_COUNT; ++j)
+			s.points[j] = s.curve(samples[j]);
+
+		length += s.length;
+	}
+
+	// single point of open bline has no segments
+	if (segments.empty()) return;
+
+	order.resize(segments.size());
+	for(int i = 0; i < (int)order.size(); ++i)
+		order[i] = i;
+
+	nodes.push_back(Node());
+	build_node(0, 0, (int)order.size());
+}
+
+void
+BLineIndex::build_node(int node_index, int begin, int end)
+{
+	Rect bounds = segments[order[begin]].bounds;
+	for(int i = begin + 1; i < end; ++i)
+	{
+		// operator|= skips rects with zero area, but straight segments are valid here
+		bounds.expand(segments[order[i]].bounds.get_min());
+		bounds.expand(segments[order[i]].bounds.get_max());
+	}
+
+	nodes[node_index].bounds = bounds;
+	nodes[node_index].begin = begin;
+	nodes[node_index].end = end;
+	if (end - begin <= LEAF_SEGMENTS)
+		return;
+
+	// split by median of centers along the longest side
+	int axis = bounds.maxy - bounds.miny > bounds.maxx - bounds.minx ? 1 : 0;
+	int middle = (begin + end)/2;
+	std::nth_element(
+		order.begin() + begin,
+		order.begin() + middle,
+		order.begin() + end,
+		CenterLess(segments, axis) );
+
+	int children = (int)nodes.size();
+	nodes[node_index].children = children;
+	nodes.push_back(Node());
+	nodes.push_back(Node());
+	build_node(children, begin, middle);
+	build_node(children + 1, middle, end);
+}
+
+int
+BLineIndex::find_closest(bool fast, const Point &p, Real &out_pos) const
+{
+	int best = -1;
+	Real best_dist = 0.0;
+	out_pos = 0.0;
+	if (nodes.empty()) return best;
+
+	int stack[MAX_DEPTH];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+	while(stack_size)
+	{
+		const Node &node = nodes[stack[--stack_size]];
+		if (best >= 0 && distance_squared(node.bounds, p) > best_dist)
+			continue;
+
+		if (node.children >= 0)
+		{
+			// visit nearest child first
+			int a = node.children, b = a + 1;
+			if ( distance_squared(nodes[a].bounds, p)
+			   < distance_squared(nodes[b].bounds, p) )
+				std::swap(a, b);
+			stack[stack_size++] = a;
+			stack[stack_size++] = b;
+			continue;
+		}
+
+		for(int i = node.begin; i < node.end; ++i)
+		{
+			const int index = order[i];
+			const Segment &s = segments[index];
+			if (best >= 0 && distance_squared(s.bounds, p) > best_dist)
+				continue;
+
+			// on equal distance the first segment wins, like in the linear search
+			if (fast)
+			{
+				for(int j = 0; j < SAMPLES_COUNT; ++j)
+				{
+					Real dist = (s.points[j] - p).mag_squared();
+					if (best < 0 || dist < best_dist || (dist == best_dist && index < best))
+						{ best = index; best_dist = dist; out_pos = samples[j]; }
+				}
+			}
+			else
+			{
+				Real pos = s.curve.find_closest(false, p);
+				Real dist = (s.curve(pos) - p).mag_squared();
+				if (best < 0 || dist < best_dist || (dist == best_dist && index < best))
+					{ best = index; best_dist = dist; out_pos = pos; }
+			}
+		}
+	}
+
+	return best;
+}
+
+/* === E N T R Y P O I N T ================================================= */
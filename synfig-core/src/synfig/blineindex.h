@@ -0,0 +1,112 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file blineindex.h
+**	\brief Spatial index of bline segments
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_BLINEINDEX_H
+#define __SYNFIG_BLINEINDEX_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <vector>
+
+#include <ETL/hermite>
+
+#include "blinepoint.h"
+#include "rect.h"
+#include "vector.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+//! Segments of bline prepared for many closest point queries.
+//! Should be rebuilt once when bline changes, then each query visits
+//! only segments near to the point instead of all segments.
+//! Results are the same as from the linear search through all segments.
+class BLineIndex
+{
+public:
+	typedef etl::hermite<Vector> Curve;
+
+	enum { SAMPLES_COUNT = 7 };
+
+	//! Positions on segment which are compared in fast mode
+	static const Real samples[SAMPLES_COUNT];
+
+	struct Segment
+	{
+		int index;      //!< index of the first point of segment in bline
+		Curve curve;
+		Real length;    //!< length of curve
+		Real offset;    //!< length of bline before this segment
+		Rect bounds;    //!< bounds of control points, the curve is inside
+		Point points[SAMPLES_COUNT];
+
+		Segment(): index(), length(), offset() { }
+	};
+
+private:
+	struct Node
+	{
+		Rect bounds;
+		int begin;      //!< range in 'order' for leaf
+		int end;
+		int children;   //!< index of the first of two children, or -1 for leaf
+		Node(): begin(), end(), children(-1) { }
+	};
+
+	std::vector<BLinePoint> bline;
+	bool loop;
+	Real length;
+	std::vector<Segment> segments;
+	std::vector<int> order;
+	std::vector<Node> nodes;
+
+	void build_node(int node_index, int begin, int end);
+
+public:
+	BLineIndex(): loop(false), length() { }
+
+	void build(const std::vector<BLinePoint> &bline, bool loop);
+
+	const std::vector<BLinePoint>& get_bline() const { return bline; }
+	bool get_loop() const { return loop; }
+	Real get_length() const { return length; }
+	const std::vector<Segment>& get_segments() const { return segments; }
+
+	//! Returns index of segment which contains the closest point, or -1 if there are no segments.
+	//! In fast mode compares points at positions from BLineIndex::samples,
+	//! otherwise uses Curve::find_closest() for candidate segments.
+	//! Position of the closest point on the segment stored into out_pos.
+	int find_closest(bool fast, const Point &p, Real &out_pos) const;
+};
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
@@ -86,7 +86,8 @@ Canvas::Canvas(const String &id):
 	is_inline_	(false),
 	is_dirty_	(true),
 	op_flag_	(false),
-	outline_grow(0.0)
+	outline_grow(0.0),
+	pixel_size(0.0)
 {
 	identifier_.file_system = FileSystemNative::instance();
 	_CanvasCounter::counter++;
@@ -336,6 +337,22 @@ Canvas::get_outline_grow()const
 	return outline_grow;
 }
 
+void
+Canvas::set_pixel_size(Real x)
+{
+	if (fabs(pixel_size - x) > 1e-12)
+	{
+		pixel_size = x;
+		get_independent_context().set_pixel_size(pixel_size);
+	}
+}
+
+Real
+Canvas::get_pixel_size()const
+{
+	return pixel_size;
+}
+
 void
 Canvas::set_time(Time t)const
 {
@@ -1546,6 +1563,18 @@ Canvas::register_external_canvas(String file_name, Handle canvas)
 	externals_[file_name] = canvas;
 }
 
+bool
+Canvas::has_external_canvases()const
+{
+	// inline canvases resolve external ids through their parents
+	if(!externals_.empty())
+		return true;
+	for(std::list<Handle>::const_iterator iter=children().begin();iter!=children().end();++iter)
+		if((*iter)->has_external_canvases())
+			return true;
+	return false;
+}
+
 #ifdef _DEBUG
 void
 Canvas::show_externals(String file, int line, String text) const
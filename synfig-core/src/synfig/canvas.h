@@ -251,6 +251,10 @@ private:
 	/*! \see get_grow_value set_grow_value */
 	Real outline_grow;
 
+	//! Size of the target pixel for the child layers, zero when unknown
+	/*! \see get_pixel_size set_pixel_size */
+	Real pixel_size;
+
 
 	/*
  -- ** -- S I G N A L S -------------------------------------------------------
@@ -640,10 +644,17 @@ public:
 	//! Stores the external canvas by its file name and the Canvas handle
 	void register_external_canvas(String file, Handle canvas);
 
+	//! Returns true if this Canvas or its exported children use Canvases of other files
+	bool has_external_canvases()const;
+
 	//! Set/Get members for the outline grow value
 	Real get_outline_grow()const;
 	void set_outline_grow(Real x);
 
+	//! Set/Get members for the size of the target pixel
+	Real get_pixel_size()const;
+	void set_pixel_size(Real x);
+
 #if 0
 	void show_canvas_ancestry(String file, int line, String note)const;
 	void show_canvas_ancestry()const;
@@ -129,6 +129,24 @@ IndependentContext::set_outline_grow(Real outline_grow)const
 	(*context)->set_outline_grow(context+1, outline_grow);
 }
 
+void
+IndependentContext::set_pixel_size(Real pixel_size)const
+{
+	IndependentContext context(*this);
+	while(*context)
+	{
+		if ( (*context)->active()
+		  && fabs((*context)->get_pixel_size_mark() - pixel_size) > 1e-12 )
+			break;
+		++context;
+	}
+	if (!*context) return;
+
+	// Set up a writer lock
+	RWLock::WriterLock lock((*context)->get_rw_lock());
+	(*context)->set_pixel_size(context+1, pixel_size);
+}
+
 Color
 Context::get_color(const Point &pos)const
 {
@@ -502,6 +520,14 @@ Context::accelerated_cairorender(cairo_t *cr,int quality, const RendDesc &rendde
 rendering::Task::Handle
 Context::build_rendering_task() const
 {
+	// instances of pasted canvases share evaluated tasks until whole task is built
+	if (!get_params().instance_cache)
+	{
+		ContextParams params = get_params();
+		params.instance_cache = new ContextInstanceCache();
+		return Context(*this, params).build_rendering_task();
+	}
+
 	Context context = *this;
 	while ( *context
 		 && ( !context.active()
@@ -76,9 +76,54 @@ public:
 
 	//! Sets the context outline grow to \outline_grow. It is done recursively.
 	void set_outline_grow(Real outline_grow) const;
+
+	//! Sets the size of the target pixel to \pixel_size. It is done recursively.
+	void set_pixel_size(Real pixel_size) const;
 };
 
 
+/*!	\class ContextInstanceCache
+**	\brief Rendering tasks of pasted canvases. Instances of one canvas with
+**	the same local time are evaluated once and share the task while
+**	the rendering task of the whole context is being built.
+**	\see Layer_PasteCanvas, Context::build_rendering_task() */
+class ContextInstanceCache: public etl::shared_object
+{
+public:
+	typedef etl::handle<ContextInstanceCache> Handle;
+
+	struct Key
+	{
+		const Canvas *canvas;
+		Time time;
+		Real pixel_size;
+		Real outline_grow;
+		bool render_excluded_contexts;
+		bool z_range;
+		Real z_range_position;
+		Real z_range_depth;
+		Real z_range_blur;
+
+		bool operator<(const Key &other)const
+		{
+			if (canvas != other.canvas) return canvas < other.canvas;
+			if (!time.is_equal(other.time)) return time.is_less_than(other.time);
+			if (pixel_size != other.pixel_size) return pixel_size < other.pixel_size;
+			if (outline_grow != other.outline_grow) return outline_grow < other.outline_grow;
+			if (render_excluded_contexts != other.render_excluded_contexts) return other.render_excluded_contexts;
+			if (z_range != other.z_range) return other.z_range;
+			if (!z_range) return false;
+			if (z_range_position != other.z_range_position) return z_range_position < other.z_range_position;
+			if (z_range_depth != other.z_range_depth) return z_range_depth < other.z_range_depth;
+			return z_range_blur < other.z_range_blur;
+		}
+	};
+
+	typedef std::map<Key, rendering::Task::Handle> TaskMap;
+
+	TaskMap tasks;
+};
+
 /*!	\class ContextParams
 **	\brief ContextParams is a class to store rendering parameters significant for Context.
 **	\see Context */
@@ -94,13 +139,18 @@ public:
 	Real z_range_depth;
 	//! Layers with z_Depth inside transition are partially visibile
 	Real z_range_blur;
+	//! Render quality of target, the same as \quality of accelerated_render()
+	int quality;
+	//! Tasks of pasted canvases, valid while rendering task is being built
+	ContextInstanceCache::Handle instance_cache;
 
 	explicit ContextParams(bool render_excluded_contexts = false):
 	render_excluded_contexts(render_excluded_contexts),
 	z_range(false),
 	z_range_position(0.0),
 	z_range_depth(0.0),
-	z_range_blur(0.0){ }
+	z_range_blur(0.0),
+	quality(4){ }
 };
 
 /*!	\class Context
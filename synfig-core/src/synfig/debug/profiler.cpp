@@ -0,0 +1,206 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file profiler.cpp
+**	\brief Profiler of rendering tasks
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <glib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#include <synfig/general.h>
+#include <synfig/localization.h>
+
+#include "profiler.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace etl;
+using namespace synfig;
+using namespace debug;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	typedef Profiler::Total Total;
+	typedef Profiler::TotalMap TotalMap;
+
+	String get_source(const Profiler::Record &r)
+		{ return r.source.empty() ? "<" + r.name + ">" : r.source; }
+
+	String escape_json(const String &x)
+	{
+		String s;
+		s.reserve(x.size());
+		for(String::const_iterator i = x.begin(); i != x.end(); ++i)
+		{
+			if (*i == '"' || *i == '\\')
+				{ s += '\\'; s += *i; }
+			else
+			if ((unsigned char)*i < 0x20)
+				s += strprintf("\\u%04x", (int)(unsigned char)*i);
+			else
+				s += *i;
+		}
+		return s;
+	}
+
+	bool greater_duration(const std::pair<String, Total> &a, const std::pair<String, Total> &b)
+		{ return a.second.duration > b.second.duration; }
+
+	String format_table(const TotalMap &totals, long long full_duration)
+	{
+		std::vector< std::pair<String, Total> > rows(totals.begin(), totals.end());
+		std::sort(rows.begin(), rows.end(), greater_duration);
+
+		String text;
+		for(std::vector< std::pair<String, Total> >::const_iterator i = rows.begin(); i != rows.end(); ++i)
+			text += strprintf( "  %12.6f %6.2f%% %8d %12.3f  %s\n",
+				(double)i->second.duration*0.000001,
+				full_duration ? 100.0*(double)i->second.duration/(double)full_duration : 0.0,
+				i->second.count,
+				(double)i->second.bytes/(1024.0*1024.0),
+				i->first.c_str() );
+		return text;
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+gint Profiler::enabled = 0;
+bool Profiler::keep_records = false;
+long long Profiler::origin = 0;
+Mutex Profiler::mutex;
+std::vector<Profiler::Record> Profiler::records;
+std::map<int, Profiler::Totals> Profiler::frames;
+Profiler::Totals Profiler::totals;
+Profiler::TotalMap Profiler::tasks;
+
+void
+Profiler::enable(bool keep_records)
+{
+	Mutex::Lock lock(mutex);
+	records.clear();
+	frames.clear();
+	totals = Totals();
+	tasks.clear();
+	Profiler::keep_records = keep_records;
+	origin = g_get_monotonic_time();
+	g_atomic_int_set(&enabled, 1);
+}
+
+void
+Profiler::disable()
+	{ g_atomic_int_set(&enabled, 0); }
+
+long long
+Profiler::get_time()
+	{ return g_get_monotonic_time() - origin; }
+
+void
+Profiler::add(const Record &record)
+{
+	if (!is_enabled()) return;
+	String source = get_source(record);
+	Mutex::Lock lock(mutex);
+	frames[record.frame].add(source, record);
+	totals.add(source, record);
+	tasks[record.name].add(record);
+	if (keep_records)
+		records.push_back(record);
+}
+
+std::vector<Profiler::Record>
+Profiler::get_records()
+{
+	Mutex::Lock lock(mutex);
+	return records;
+}
+
+Profiler::TotalMap
+Profiler::get_task_totals()
+{
+	Mutex::Lock lock(mutex);
+	return tasks;
+}
+
+bool
+Profiler::write_trace(const String &filename)
+{
+	std::ofstream f(filename.c_str());
+	if (!f)
+	{
+		error("Profiler: cannot open file %s", filename.c_str());
+		return false;
+	}
+
+	Mutex::Lock lock(mutex);
+	f << "{\"traceEvents\":[" << std::endl;
+	for(std::vector<Record>::const_iterator i = records.begin(); i != records.end(); ++i)
+	{
+		f << (i == records.begin() ? "" : ",\n")
+		  << "{\"name\":\"" << escape_json(get_source(*i)) << "\""
+		  << ",\"cat\":\"" << escape_json(i->name) << "\""
+		  << ",\"ph\":\"X\""
+		  << ",\"ts\":" << i->begin
+		  << ",\"dur\":" << i->duration
+		  << ",\"pid\":0"
+		  << ",\"tid\":" << i->thread
+		  << ",\"args\":{\"frame\":" << i->frame
+		  << ",\"task\":\"" << escape_json(i->name) << "\""
+		  << ",\"bytes\":" << i->bytes << "}}";
+	}
+	f << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+	return (bool)f;
+}
+
+String
+Profiler::get_summary()
+{
+	Mutex::Lock lock(mutex);
+
+	// share is relative to the total time of the same frame
+	String header = "      time (s)   share    tasks  memory (MB)  layer\n";
+	String text;
+	for(std::map<int, Totals>::const_iterator i = frames.begin(); i != frames.end(); ++i)
+		text += strprintf("frame %d\n", i->first)
+		      + header
+		      + format_table(i->second.sources, i->second.all.duration);
+	text += strprintf("all frames, %d tasks\n", totals.all.count)
+	      + header
+	      + format_table(totals.sources, totals.all.duration);
+	return text;
+}
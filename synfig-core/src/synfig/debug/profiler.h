@@ -0,0 +1,122 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file profiler.h
+**	\brief Profiler of rendering tasks
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_DEBUG_PROFILER_H
+#define __SYNFIG_DEBUG_PROFILER_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <map>
+#include <vector>
+
+#include <glib.h>
+
+#include <synfig/mutex.h>
+#include <synfig/string.h>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+namespace debug {
+
+//! Collects execution time and allocated memory of rendering tasks
+//! from all rendering threads. When disabled costs one check per task.
+//! Records are summed into totals when they arrive, and stored one by one
+//! only when they are needed for trace.
+class Profiler {
+public:
+	struct Record {
+		String name;     //!< type of the task
+		String source;   //!< layer which built the task
+		int frame;       //!< see rendering::Task::RunParams::frame
+		int thread;
+		long long begin; //!< microseconds since Profiler::enable()
+		long long duration;
+		long long bytes; //!< size of surface allocated by the task
+
+		Record(): frame(), thread(), begin(), duration(), bytes() { }
+	};
+
+	struct Total {
+		long long duration;
+		long long bytes;
+		int count;
+
+		Total(): duration(), bytes(), count() { }
+		void add(const Record &r)
+			{ duration += r.duration; bytes += r.bytes; ++count; }
+	};
+
+	typedef std::map<String, Total> TotalMap;
+
+private:
+	struct Totals {
+		Total all;
+		TotalMap sources;
+		void add(const String &source, const Record &r)
+			{ all.add(r); sources[source].add(r); }
+	};
+
+	static gint enabled;
+	static bool keep_records;
+	static long long origin;
+	static Mutex mutex;
+	static std::vector<Record> records;
+	static std::map<int, Totals> frames;
+	static Totals totals;
+	static TotalMap tasks;
+
+public:
+	static bool is_enabled() { return g_atomic_int_get(&enabled) != 0; }
+
+	//! Clears previous results and starts profiling,
+	//! records are stored one by one for write_trace() only when 'keep_records' is set
+	static void enable(bool keep_records = false);
+	static void disable();
+
+	//! Current time in microseconds since Profiler::enable()
+	static long long get_time();
+
+	static void add(const Record &record);
+	//! Returns stored records, see enable()
+	static std::vector<Record> get_records();
+	//! Returns totals per type of task
+	static TotalMap get_task_totals();
+
+	//! Writes stored records in trace-event format of Chrome (chrome://tracing)
+	static bool write_trace(const String &filename);
+	//! Returns table with time and memory per layer per frame and totals per layer
+	static String get_summary();
+};
+
+}; // END of namespace debug
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
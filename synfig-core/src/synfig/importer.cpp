@@ -43,6 +43,7 @@
 
 #include "canvas.h"
 #include "importer.h"
+#include "importercache.h"
 #include "string.h"
 #include "surface.h"
 
@@ -69,12 +70,13 @@ Importer::subsys_init()
 {
 	book_=new Book();
 	__open_importers=new map<FileSystem::Identifier,Importer::LooseHandle>();
-	return true;
+	return ImporterCache::subsys_init();
 }
 
 bool
 Importer::subsys_stop()
 {
+	ImporterCache::subsys_stop();
 	delete book_;
 	delete __open_importers;
 	return true;
@@ -0,0 +1,511 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file importercache.cpp
+**	\brief Process-wide cache of decoded images
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#endif
+
+#include <cassert>
+#include <cstdlib>
+
+#include <algorithm>
+#include <map>
+
+#include <glib/gstdio.h>
+#include <glibmm.h>
+#include <glibmm/threads.h>
+
+#include "general.h"
+
+#include "importercache.h"
+#include "gamma.h"
+#include "surface.h"
+#include "rendering/software/function/packedpixels.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+//! default limit of memory in megabytes, may be changed by SYNFIG_IMPORTER_CACHE_SIZE
+#define DEFAULT_MEMORY_LIMIT 1024
+//! compact copies larger than this are stored in memory-mapped files
+#define MAPPED_MIN_SIZE (64*1024*1024)
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+
+//! Compact copy of pixels of decoded image.
+//! Pixels are stored only when they can be restored without any change,
+//! so the rendering result does not depend on state of cache.
+class Packed: public etl::shared_object
+{
+public:
+	typedef etl::handle<Packed> Handle;
+
+	enum Format
+	{
+		FORMAT_U8,  //!< indices in decoding tables of importer, 4 bytes per pixel
+		FORMAT_HALF //!< straight RGBA, four half-floats, 8 bytes per pixel
+	};
+
+private:
+	Format format;
+	int width;
+	int height;
+	float tables[4][256];
+	unsigned char *data;
+	size_t size;
+	bool mapped;
+
+	Packed(int width, int height, const Gamma &gamma):
+		format(FORMAT_U8), width(width), height(height), data(NULL), size(0), mapped(false)
+	{
+		// the same expressions as in importers
+		for(int i = 0; i < 256; ++i)
+		{
+			tables[0][i] = gamma.r_U8_to_F32(i);
+			tables[1][i] = gamma.g_U8_to_F32(i);
+			tables[2][i] = gamma.b_U8_to_F32(i);
+			tables[3][i] = (float)((float)i*(1.0/255.0));
+		}
+	}
+
+	static bool find(const float *table, float x, unsigned char &out_index)
+	{
+		const float *i = std::lower_bound(table, table + 256, x);
+		if (i == table + 256 || *i != x) return false;
+		out_index = (unsigned char)(i - table);
+		return true;
+	}
+
+	bool allocate(size_t size)
+	{
+		free();
+		this->size = size;
+
+		#ifndef _WIN32
+		if (size >= MAPPED_MIN_SIZE)
+		{
+			gchar *filename = NULL;
+			int fd = g_file_open_tmp("synfig-image-XXXXXX", &filename, NULL);
+			if (fd >= 0)
+			{
+				// file is removed immediately, it lives until unmapped
+				g_unlink(filename);
+				if (ftruncate(fd, (off_t)size) == 0)
+				{
+					void *d = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+					if (d != MAP_FAILED)
+						{ data = (unsigned char*)d; mapped = true; }
+				}
+				close(fd);
+			}
+			g_free(filename);
+			if (mapped) return true;
+		}
+		#endif
+
+		data = new unsigned char[size];
+		return true;
+	}
+
+	void free()
+	{
+		if (data)
+		{
+			#ifndef _WIN32
+			if (mapped) munmap(data, size); else
+			#endif
+			delete[] data;
+		}
+		data = NULL;
+		size = 0;
+		mapped = false;
+	}
+
+	bool pack_u8(const Color *src, int count)
+	{
+		format = FORMAT_U8;
+		allocate((size_t)count*4);
+		unsigned char *d = data;
+		for(const Color *c = src, *end = src + count; c < end; ++c, d += 4)
+			if ( !find(tables[0], c->get_r(), d[0])
+			  || !find(tables[1], c->get_g(), d[1])
+			  || !find(tables[2], c->get_b(), d[2])
+			  || !find(tables[3], c->get_a(), d[3]) )
+				{ free(); return false; }
+		return true;
+	}
+
+	static bool to_half(float x, unsigned short &out_half)
+	{
+		out_half = rendering::software::PackedPixels::float_to_half(x);
+		return rendering::software::PackedPixels::half_to_float(out_half) == x;
+	}
+
+	bool pack_half(const Color *src, int count)
+	{
+		format = FORMAT_HALF;
+		allocate((size_t)count*4*sizeof(unsigned short));
+		unsigned short *d = (unsigned short*)data;
+		for(const Color *c = src, *end = src + count; c < end; ++c, d += 4)
+			if ( !to_half(c->get_r(), d[0])
+			  || !to_half(c->get_g(), d[1])
+			  || !to_half(c->get_b(), d[2])
+			  || !to_half(c->get_a(), d[3]) )
+				{ free(); return false; }
+		return true;
+	}
+
+public:
+	~Packed() { free(); }
+
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+	size_t get_size() const { return size; }
+
+	//! Returns null when pixels cannot be stored without loss
+	static Handle create(const synfig::Surface &surface, const Gamma &gamma)
+	{
+		if ( !surface.is_valid()
+		  || (int)surface.get_pitch() != (int)sizeof(Color)*surface.get_w() )
+			return Handle();
+
+		Handle packed(new Packed(surface.get_w(), surface.get_h(), gamma));
+		const Color *src = &surface[0][0];
+		int count = surface.get_w()*surface.get_h();
+		if (packed->pack_u8(src, count) || packed->pack_half(src, count))
+			return packed;
+		return Handle();
+	}
+
+	void unpack(synfig::Surface &surface) const
+	{
+		assert(data);
+		surface.set_wh(width, height);
+		Color *dst = &surface[0][0];
+		Color *end = dst + width*height;
+		if (format == FORMAT_U8)
+		{
+			const unsigned char *s = data;
+			for(Color *c = dst; c < end; ++c, s += 4)
+				*c = Color(tables[0][s[0]], tables[1][s[1]], tables[2][s[2]], tables[3][s[3]]);
+		}
+		else
+		{
+			const unsigned short *s = (const unsigned short*)data;
+			for(Color *c = dst; c < end; ++c, s += 4)
+				*c = Color(
+					rendering::software::PackedPixels::half_to_float(s[0]),
+					rendering::software::PackedPixels::half_to_float(s[1]),
+					rendering::software::PackedPixels::half_to_float(s[2]),
+					rendering::software::PackedPixels::half_to_float(s[3]) );
+		}
+	}
+};
+
+//! Modification time and size of native file, to detect changes of file
+struct Stamp
+{
+	bool valid;
+	gint64 mtime;
+	gint64 size;
+
+	Stamp(): valid(), mtime(), size() { }
+
+	bool operator== (const Stamp &other) const
+		{ return valid == other.valid && mtime == other.mtime && size == other.size; }
+
+	static Stamp get(const FileSystem::Identifier &identifier)
+	{
+		Stamp stamp;
+		if (!identifier.file_system) return stamp;
+		String uri = identifier.file_system->get_real_uri(identifier.filename);
+		if (uri.empty()) return stamp;
+		try
+		{
+			GStatBuf buf;
+			if (g_stat(Glib::filename_from_uri(uri).c_str(), &buf) == 0)
+			{
+				stamp.valid = true;
+				stamp.mtime = (gint64)buf.st_mtime;
+				stamp.size = (gint64)buf.st_size;
+			}
+		}
+		catch(...) { }
+		return stamp;
+	}
+};
+
+struct Entry
+{
+	Stamp stamp;
+	ImporterCache::Frame frame;
+	//! gamma of importer, to find the 8-bit values of pixels
+	Gamma gamma;
+	//! made when surface is released first time, kept while entry lives
+	Packed::Handle packed;
+	long long last_use;
+
+	Entry(): last_use() { }
+
+	static size_t get_surface_size(const rendering::SurfaceSW::Handle &surface)
+		{ return surface ? surface->get_buffer_size() : 0; }
+
+	size_t get_size() const
+		{ return get_surface_size(frame.surface) + (packed ? packed->get_size() : 0); }
+
+	//! surface is not used outside of cache
+	bool is_releasable() const
+		{ return !frame.surface || frame.surface.count() == 1; }
+};
+
+class Cache
+{
+public:
+	typedef std::map<FileSystem::Identifier, Entry> Map;
+
+	Glib::Threads::Mutex mutex;
+	Map entries;
+	size_t memory_limit;
+	size_t memory_used;
+	long long uses;
+
+	Cache(): memory_limit((size_t)DEFAULT_MEMORY_LIMIT*1024*1024), memory_used(), uses() { }
+
+	void erase(Map::iterator i)
+	{
+		memory_used -= i->second.get_size();
+		entries.erase(i);
+	}
+
+	//! Releases memory of least recently used entries, entry 'keep' is not touched
+	void reserve(size_t size, const Entry *keep)
+	{
+		while(memory_used + size > memory_limit)
+		{
+			Map::iterator lru = entries.end();
+			for(Map::iterator i = entries.begin(); i != entries.end(); ++i)
+				if ( &i->second != keep
+				  && i->second.is_releasable()
+				  && (lru == entries.end() || i->second.last_use < lru->second.last_use) )
+					lru = i;
+			if (lru == entries.end())
+				break;
+
+			Entry &entry = lru->second;
+			if (entry.frame.surface && !entry.packed)
+			{
+				entry.packed = Packed::create(entry.frame.surface->get_surface(), entry.gamma);
+				if (entry.packed)
+					memory_used += entry.packed->get_size();
+			}
+
+			if (entry.frame.surface && entry.packed)
+			{
+				// keep compact copy, surface will be expanded again on demand
+				memory_used -= Entry::get_surface_size(entry.frame.surface);
+				entry.frame.surface.reset();
+			}
+			else
+			{
+				erase(lru);
+			}
+		}
+	}
+};
+
+Cache *cache = NULL;
+
+} // END of anonymous namespace
+
+/* === M E T H O D S ======================================================= */
+
+bool
+ImporterCache::subsys_init()
+{
+	cache = new Cache();
+	if (const char *s = getenv("SYNFIG_IMPORTER_CACHE_SIZE"))
+		cache->memory_limit = (size_t)atol(s)*1024*1024;
+	return true;
+}
+
+bool
+ImporterCache::subsys_stop()
+{
+	delete cache;
+	cache = NULL;
+	return true;
+}
+
+bool
+ImporterCache::get_frame(
+	const FileSystem::Identifier &identifier,
+	const RendDesc &renddesc,
+	Frame &out_frame,
+	Importer::Handle &out_importer )
+{
+	assert(cache);
+	out_frame = Frame();
+	out_importer.reset();
+
+	Stamp stamp = Stamp::get(identifier);
+
+	{
+		Glib::Threads::Mutex::Lock lock(cache->mutex);
+		Cache::Map::iterator i = cache->entries.find(identifier);
+		if (i != cache->entries.end())
+		{
+			if (i->second.stamp == stamp)
+			{
+				Entry &entry = i->second;
+				entry.last_use = ++cache->uses;
+				if (!entry.frame.surface)
+				{
+					// expand compact copy
+					assert(entry.packed);
+					cache->reserve(entry.packed->get_width()*entry.packed->get_height()*sizeof(Color), &entry);
+					rendering::SurfaceSW::Handle surface(new rendering::SurfaceSW());
+					entry.packed->unpack(surface->get_surface());
+					surface->update_from_surface();
+					entry.frame.surface = surface;
+					cache->memory_used += Entry::get_surface_size(surface);
+				}
+				out_frame = entry.frame;
+				return true;
+			}
+
+			// file was changed
+			cache->erase(i);
+		}
+	}
+
+	// decode without lock, so other images are available meanwhile
+	Importer::Handle importer = Importer::open(identifier);
+	if (!importer)
+		return false;
+	if (importer->is_animated())
+		{ out_importer = importer; return false; }
+
+	Entry entry;
+	entry.stamp = stamp;
+	entry.frame.surface = new rendering::SurfaceSW();
+	synfig::Surface &surface = entry.frame.surface->get_surface();
+	if (!importer->get_frame(
+			surface, renddesc, Time(0),
+			entry.frame.trimmed,
+			entry.frame.width,
+			entry.frame.height,
+			entry.frame.top,
+			entry.frame.left ))
+	{
+		warning(strprintf("Unable to get frame from \"%s\"", identifier.filename.c_str()));
+		out_frame.surface = new rendering::SurfaceSW();
+		return true;
+	}
+	entry.frame.surface->update_from_surface();
+	entry.gamma = importer->gamma();
+
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	Cache::Map::iterator i = cache->entries.find(identifier);
+	if (i != cache->entries.end())
+	{
+		// decoded concurrently by another thread
+		if (i->second.stamp == stamp && i->second.frame.surface)
+		{
+			i->second.last_use = ++cache->uses;
+			out_frame = i->second.frame;
+			return true;
+		}
+		cache->erase(i);
+	}
+
+	cache->reserve(entry.get_size(), NULL);
+	entry.last_use = ++cache->uses;
+	cache->memory_used += entry.get_size();
+	cache->entries[identifier] = entry;
+	out_frame = entry.frame;
+	return true;
+}
+
+void
+ImporterCache::forget(const FileSystem::Identifier &identifier)
+{
+	if (!cache) return;
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	Cache::Map::iterator i = cache->entries.find(identifier);
+	if (i != cache->entries.end())
+		cache->erase(i);
+}
+
+void
+ImporterCache::clear()
+{
+	if (!cache) return;
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	cache->entries.clear();
+	cache->memory_used = 0;
+}
+
+size_t
+ImporterCache::get_memory_limit()
+{
+	assert(cache);
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	return cache->memory_limit;
+}
+
+void
+ImporterCache::set_memory_limit(size_t memory_limit)
+{
+	assert(cache);
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	cache->memory_limit = memory_limit;
+	cache->reserve(0, NULL);
+}
+
+size_t
+ImporterCache::get_memory_used()
+{
+	assert(cache);
+	Glib::Threads::Mutex::Lock lock(cache->mutex);
+	return cache->memory_used;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,93 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file importercache.h
+**	\brief Process-wide cache of decoded images
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_IMPORTERCACHE_H
+#define __SYNFIG_IMPORTERCACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <cstddef>
+
+#include "filesystem.h"
+#include "importer.h"
+#include "renddesc.h"
+#include "rendering/software/surfacesw.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+//! Decoded static images shared by identical FileSystem::Identifier.
+//! Each file is decoded once for all Import layers of all canvases,
+//! and layers share the same surface instead of own copies.
+//! Surface which is not used by layers may be released, then only
+//! the compact lossless copy of pixels (8 or 16 bits per channel) is kept
+//! and expanded back on demand. Compact copy is made at the first release.
+//! Compact copies of very large images are stored in memory-mapped
+//! temporary files, so system may page them out.
+//! Entries are released in LRU order when memory limit is exceeded.
+class ImporterCache
+{
+public:
+	struct Frame
+	{
+		//! shared surface, must not be modified
+		rendering::SurfaceSW::Handle surface;
+		bool trimmed;
+		unsigned int width, height, top, left;
+
+		Frame(): trimmed(), width(), height(), top(), left() { }
+	};
+
+	static bool subsys_init();
+	static bool subsys_stop();
+
+	//! Gets frame of static image, importer is opened and image is decoded only on cache miss.
+	//! Returns false when importer cannot be opened or when image is animated,
+	//! for animated image the opened importer is stored into out_importer.
+	//! When frame cannot be decoded returns true with empty surface.
+	static bool get_frame(
+		const FileSystem::Identifier &identifier,
+		const RendDesc &renddesc,
+		Frame &out_frame,
+		Importer::Handle &out_importer );
+
+	//! Drops cached image, should be called when file was overwritten
+	static void forget(const FileSystem::Identifier &identifier);
+	static void clear();
+
+	static size_t get_memory_limit();
+	static void set_memory_limit(size_t memory_limit);
+	static size_t get_memory_used();
+};
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
@@ -31,6 +31,8 @@
 #	include <config.h>
 #endif
 
+#include <cmath>
+
 #include <sigc++/adaptors/bind.h>
 
 #include "layer.h"
@@ -47,6 +49,8 @@
 #include "paramdesc.h"
 #include "transform.h"
 
+#include "debug/profiler.h"
+
 #include "layers/layer_composite.h"
 #include "layers/layer_bitmap.h"
 #include "layers/layer_duplicate.h"
@@ -162,7 +166,11 @@ Layer::Layer():
 	exclude_from_rendering_(false),
 	param_z_depth(Real(0.0f)),
 	time_mark(Time::end()),
-	outline_grow_mark(0.0)
+	outline_grow_mark(0.0),
+	pixel_size_mark(0.0),
+	params_time_mark(Time::end()),
+	params_constant_begin(Time::end()),
+	params_constant_end(Time::begin())
 {
 	_LayerCounter::counter++;
 	SET_INTERPOLATION_DEFAULTS();
@@ -459,6 +467,7 @@ Layer::clone(Canvas::LooseHandle canvas, const GUID& deriv_guid) const
 
 	ret->set_time_mark(get_time_mark());
 	ret->set_outline_grow_mark(get_outline_grow_mark());
+	ret->set_pixel_size_mark(get_pixel_size_mark());
 
 	//ret->set_param_list(get_param_list());
 	// Process the parameter list so that
@@ -523,6 +532,12 @@ Layer::reads_context() const
 	return false;
 }
 
+bool
+Layer::is_splittable() const
+{
+	return false;
+}
+
 Rect
 Layer::get_full_bounding_rect(Context context)const
 {
@@ -595,17 +610,44 @@ Layer::reset_version()
 void
 Layer::set_time(IndependentContext context, Time time)const
 {
-	Layer::ParamList params;
-	Layer::DynamicParamList::const_iterator iter;
-	// For each parameter of the layer sets the time by the operator()(time)
-	for(iter=dynamic_param_list().begin();iter!=dynamic_param_list().end();iter++)
-		params[iter->first]=(*iter->second)(time);
-	// Sets the modified parameter list to the current context layer
-	const_cast<Layer*>(this)->set_param_list(params);
+	// Parameters are not reevaluated (and layer is not resynced)
+	// while time stays in the interval where all of them are constant
+	if ( !(params_constant_begin < params_constant_end)
+	  || time < params_constant_begin
+	  || time > params_constant_end )
+	{
+		Time begin = Time::begin();
+		Time end = Time::end();
+
+		Layer::ParamList params;
+		Layer::DynamicParamList::const_iterator iter;
+		// For each parameter of the layer sets the time by the operator()(time)
+		for(iter=dynamic_param_list().begin();iter!=dynamic_param_list().end();iter++)
+		{
+			params[iter->first]=(*iter->second)(time);
+			if (begin < end)
+			{
+				Time b, e;
+				iter->second->get_constant_interval(time, b, e);
+				if (begin < b) begin = b;
+				if (end > e) end = e;
+			}
+		}
+		// Sets the modified parameter list to the current context layer
+		const_cast<Layer*>(this)->set_param_list(params);
+
+		params_time_mark = time;
+		params_constant_begin = begin;
+		params_constant_end = end;
+	}
 
 	set_time_mark(time);
 
 	set_time_vfunc(context, time);
+
+	// scale of the transforming layer may be changed with time
+	if (get_pixel_size_mark() > 0.0 && get_transform())
+		set_pixel_size_vfunc(context, get_pixel_size_mark());
 }
 
 void
@@ -627,6 +669,47 @@ Layer::set_outline_grow_vfunc(IndependentContext context, Real outline_grow)cons
 	context.set_outline_grow(outline_grow);
 }
 
+void
+Layer::set_pixel_size(IndependentContext context, Real pixel_size)const
+{
+	set_pixel_size_mark(pixel_size);
+	set_pixel_size_vfunc(context, pixel_size);
+}
+
+void
+Layer::set_pixel_size_vfunc(IndependentContext context, Real pixel_size)const
+{
+	context.set_pixel_size(get_transformed_pixel_size(pixel_size));
+}
+
+Real
+Layer::get_transformed_pixel_size(Real pixel_size)const
+{
+	if (pixel_size <= 0.0) return pixel_size;
+	etl::handle<Transform> transform = get_transform();
+	if (!transform) return pixel_size;
+
+	// measure the pixel in units of the layers under this one at few points,
+	// size is unknown if transformation is not affine
+	Real size = 0.0;
+	for(int i = 0; i < 4; ++i)
+	{
+		Vector p(i == 1 ? 1.0 : i == 3 ? -1.0 : 0.0, i == 2 ? 1.0 : i == 3 ? -1.0 : 0.0);
+		Vector o = transform->unperform(p);
+		Vector dx = transform->unperform(p + Vector(pixel_size, 0.0)) - o;
+		Vector dy = transform->unperform(p + Vector(0.0, pixel_size)) - o;
+		Real s = sqrt(fabs(dx[0]*dy[1] - dx[1]*dy[0]));
+		if (!(s > 1e-12) || std::isinf(s))
+			return 0.0;
+		if (i == 0)
+			size = s;
+		else
+		if (fabs(s - size) > 1e-6*size)
+			return 0.0;
+	}
+	return size;
+}
+
 void
 Layer::set_render_method(Context context, RenderMethod x)
 {
@@ -908,10 +991,22 @@ Layer::build_rendering_task_vfunc(Context context)const
 	return task;
 }
 
+static void
+set_task_source(const rendering::Task::Handle &task, const String &source)
+{
+	// tasks of the context under the layer are already marked by their layers
+	if (!task || !task->source.empty()) return;
+	task->source = source;
+	for(rendering::Task::List::const_iterator i = task->sub_tasks.begin(); i != task->sub_tasks.end(); ++i)
+		set_task_source(*i, source);
+}
+
 rendering::Task::Handle
 Layer::build_rendering_task(Context context)const
 {
 	rendering::Task::Handle task = build_rendering_task_vfunc(context);
+	if (debug::Profiler::is_enabled())
+		set_task_source(task, get_non_empty_description() + " (" + get_name() + ")");
 	return task ? task : rendering::Task::Handle(new rendering::TaskSurfaceEmpty());
 }
 
@@ -307,6 +307,14 @@ private:
 	//! \writeme
 	mutable Time time_mark;
 	mutable Real outline_grow_mark;
+	//! Size of the target pixel in units of the layer, zero when unknown
+	mutable Real pixel_size_mark;
+
+	//! Time of the last evaluation of dynamic parameters
+	mutable Time params_time_mark;
+	//! Interval around params_time_mark where all dynamic parameters are constant
+	mutable Time params_constant_begin;
+	mutable Time params_constant_end;
 
 	//! Contains the name of the group that this layer belongs to
 	String group_;
@@ -548,12 +556,24 @@ public:
 
 	Time get_time_mark() const { return time_mark; }
 	void set_time_mark(Time time) const { time_mark = time; }
-	void clear_time_mark() const { time_mark = Time::end(); }
+	void clear_time_mark() const
+	{
+		time_mark = params_time_mark = Time::end();
+		params_constant_begin = Time::end();
+		params_constant_end = Time::begin();
+	}
+
+	//! Returns time when dynamic parameters was changed by set_time() last time
+	Time get_params_time_mark() const { return params_time_mark; }
 
 	Real get_outline_grow_mark() const { return outline_grow_mark; }
 	void set_outline_grow_mark(Real outline_grow) const { outline_grow_mark = outline_grow; }
 	void clear_outline_grow_mark() const { outline_grow_mark = 0.0; }
 
+	Real get_pixel_size_mark() const { return pixel_size_mark; }
+	void set_pixel_size_mark(Real pixel_size) const { pixel_size_mark = pixel_size; }
+	void clear_pixel_size_mark() const { pixel_size_mark = 0.0; }
+
 	//! Sets the \a time for the Layer and those under it
 	/*!	\param context		Context iterator referring to next Layer.
 	**	\param time			writeme
@@ -568,6 +588,13 @@ public:
 	*/
 	void set_outline_grow(IndependentContext context, Real outline_grow)const;
 
+	//! Sets the size of the target pixel for the Layer and those under it
+	/*!	\param context		Context iterator referring to next Layer.
+	**	\param pixel_size	Size of the pixel in units, zero when unknown
+	**	\see Context::set_pixel_size()
+	*/
+	void set_pixel_size(IndependentContext context, Real pixel_size)const;
+
 	//! Gets the blend color of the Layer in the context at \a pos
 	/*!	\param context		Context iterator referring to next Layer.
 	**	\param pos		Point which indicates where the Color should come from
@@ -597,6 +624,11 @@ public:
 protected:
 	virtual void set_time_vfunc(IndependentContext context, Time time) const;
 	virtual void set_outline_grow_vfunc(IndependentContext context, Real outline_grow) const;
+	//! Passes the pixel size to the layers under this one, scaled by get_transform()
+	virtual void set_pixel_size_vfunc(IndependentContext context, Real pixel_size) const;
+	//! Returns the pixel size in units of the layers under this one,
+	//! or zero if it varies, when layer transforms them not affinely
+	Real get_transformed_pixel_size(Real pixel_size) const;
 	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context) const;
 
 	virtual RendDesc get_sub_renddesc_vfunc(const RendDesc &renddesc) const;
@@ -633,6 +665,14 @@ public:
 	**  context until the final blend operation. */
 	virtual bool reads_context()const;
 
+	//! Returns true if parts of the layer may be rendered independently in parallel threads.
+	/*! The layer declares that accelerated_render() is safe to call simultaneously
+	**  for different parts of the same frame, and that any part of the result is
+	**  equal to the corresponding part of the whole image. The context is provided
+	**  within get_sub_renddesc() of the whole image, so layers which read
+	**  neighbourhood of pixels (like distortions) may be splitted too. */
+	virtual bool is_splittable()const;
+
 	//! Duplicates the Layer without duplicating the value nodes
 	virtual Handle simple_clone()const;
 
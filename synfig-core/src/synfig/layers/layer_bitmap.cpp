@@ -52,6 +52,7 @@
 #include <synfig/rendering/common/task/tasksurface.h>
 #include <synfig/rendering/common/task/tasksurfaceempty.h>
 #include <synfig/rendering/common/task/tasksurfaceresample.h>
+#include <synfig/rendering/software/surfacesw.h>
 
 #endif
 
@@ -829,6 +830,18 @@ Layer_Bitmap::set_cairo_surface(cairo_surface_t *cs)
 	csurface.map_cairo_image();
 }
 
+void
+Layer_Bitmap::make_surface_unique()
+{
+	rendering::SurfaceSW::Handle surface_sw =
+		rendering::SurfaceSW::Handle::cast_dynamic(rendering_surface);
+	if ( surface_sw
+	  && surface.is_valid()
+	  && surface_sw->get_surface().is_valid()
+	  && &surface[0][0] == &surface_sw->get_surface()[0][0] )
+		surface = Surface(surface);
+}
+
 rendering::Task::Handle
 Layer_Bitmap::build_composite_task_vfunc(ContextParams /* context_params */) const
 {
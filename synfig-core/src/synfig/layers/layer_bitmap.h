@@ -92,6 +92,11 @@ public:
 	
 	void set_cairo_surface(cairo_surface_t* cs);
 
+	//! Makes own copy of pixels of surface, when they are shared with rendering_surface
+	//! (Import layers share decoded images, see ImporterCache).
+	//! Should be called before modification of surface.
+	void make_surface_unique();
+
 protected:
 	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 }; // END of class Layer_Bitmap
@@ -40,6 +40,8 @@
 #include <synfig/cairo_renddesc.h>
 #include <synfig/canvas.h>
 #include <synfig/context.h>
+#include <synfig/guid.h>
+#include <synfig/mutex.h>
 #include <synfig/paramdesc.h>
 #include <synfig/renddesc.h>
 #include <synfig/time.h>
@@ -53,6 +55,9 @@
 #include <synfig/rendering/common/task/tasktransformation.h>
 #include <synfig/rendering/primitive/affinetransformation.h>
 
+#include <map>
+#include <vector>
+
 #endif
 
 /* === U S I N G =========================================================== */
@@ -82,6 +87,166 @@ public:
 	~depth_counter() { (*depth)--; }
 };
 
+// Evaluated instances of exported canvases. Exported canvas itself is
+// evaluated at the local time of one group of pasting layers, layers
+// with other local time receive evaluated clones. Layers with the same
+// local time, pixel size and outline grow share one instance.
+class SubCanvasInstances
+{
+public:
+	struct Key
+	{
+		Time time;
+		Real pixel_size;
+		Real outline_grow;
+
+		Key(Time time, Real pixel_size, Real outline_grow):
+			time(time), pixel_size(pixel_size), outline_grow(outline_grow) { }
+
+		bool operator==(const Key &other)const
+		{
+			return time.is_equal(other.time)
+				&& fabs(pixel_size - other.pixel_size) <= 1e-12
+				&& fabs(outline_grow - other.outline_grow) <= 1e-8;
+		}
+	};
+
+private:
+	struct Entry
+	{
+		Canvas::Handle canvas;
+		Key key;
+		int revision;
+		int users;
+
+		Entry(const Canvas::Handle &canvas, const Key &key, int revision):
+			canvas(canvas), key(key), revision(revision), users(1) { }
+	};
+
+	struct Pool
+	{
+		Canvas::Handle source;
+		int revision;
+		std::vector<Entry> entries;
+
+		Pool(): revision() { }
+
+		//! clones become outdated when the source is changed
+		bool is_actual(const Entry &entry)const
+			{ return entry.canvas == source || entry.revision == revision; }
+		std::vector<Entry>::iterator find(const Canvas::Handle &canvas)
+		{
+			for(std::vector<Entry>::iterator i = entries.begin(); i != entries.end(); ++i)
+				if (i->canvas == canvas) return i;
+			return entries.end();
+		}
+	};
+
+	typedef std::map<const Canvas*, Pool> PoolMap;
+
+	static Mutex mutex;
+	static PoolMap pools;
+
+	static void release(PoolMap::iterator pool, const Canvas::Handle &instance)
+	{
+		std::vector<Entry>::iterator i = pool->second.find(instance);
+		if (i != pool->second.entries.end() && --i->users <= 0)
+			pool->second.entries.erase(i);
+		if (pool->second.entries.empty())
+			pools.erase(pool);
+	}
+
+	static Canvas::Handle clone(const Canvas::Handle &source)
+	{
+		Canvas::Handle canvas = Canvas::create();
+		canvas->set_identifier(source->get_root()->get_identifier());
+		canvas->set_file_name(source->get_file_name());
+		canvas->rend_desc() = source->rend_desc();
+		GUID deriv_guid;
+		for(Canvas::const_iterator i = source->begin(); i != source->end(); ++i)
+		{
+			Layer::Handle layer = (*i)->clone(canvas, deriv_guid);
+			if (layer)
+				canvas->push_back(layer);
+			else
+				synfig::error("Layer_PasteCanvas: Unable to clone layer");
+		}
+		return canvas;
+	}
+
+public:
+	//! Returns instance of \a source for \a key, releases previous \a instance
+	static Canvas::Handle acquire(const Canvas::Handle &source, const Canvas::Handle &instance, const Key &key)
+	{
+		int revision;
+		{
+			Mutex::Lock lock(mutex);
+			Pool &pool = pools[source.get()];
+			pool.source = source;
+			std::vector<Entry>::iterator current = pool.find(instance);
+
+			// instance with the same parameters
+			for(std::vector<Entry>::iterator i = pool.entries.begin(); i != pool.entries.end(); ++i)
+			{
+				if (!(i->key == key) || !pool.is_actual(*i)) continue;
+				if (i == current) return instance;
+				Canvas::Handle canvas = i->canvas;
+				++i->users;
+				if (current != pool.entries.end() && --current->users <= 0)
+					pool.entries.erase(current);
+				return canvas;
+			}
+
+			// instance used only by this layer may be reevaluated
+			if (current != pool.entries.end() && current->users == 1 && pool.is_actual(*current))
+			{
+				current->key = key;
+				return instance;
+			}
+
+			if (current != pool.entries.end() && --current->users <= 0)
+				pool.entries.erase(current);
+
+			// source is not used by other layers
+			if (pool.find(source) == pool.entries.end())
+			{
+				pool.entries.push_back(Entry(source, key, pool.revision));
+				return source;
+			}
+			revision = pool.revision;
+		}
+
+		// layers of cloned canvas may paste other canvases, so lock is released
+		Canvas::Handle canvas = clone(source);
+
+		Mutex::Lock lock(mutex);
+		Pool &pool = pools[source.get()];
+		pool.source = source;
+		pool.entries.push_back(Entry(canvas, key, revision));
+		return canvas;
+	}
+
+	static void release(const Canvas::Handle &source, const Canvas::Handle &instance)
+	{
+		Mutex::Lock lock(mutex);
+		PoolMap::iterator pool = pools.find(source.get());
+		if (pool != pools.end())
+			release(pool, instance);
+	}
+
+	//! Source canvas is changed, so all of its clones should be recreated
+	static void invalidate(const Canvas::Handle &source)
+	{
+		Mutex::Lock lock(mutex);
+		PoolMap::iterator pool = pools.find(source.get());
+		if (pool != pools.end())
+			++pool->second.revision;
+	}
+};
+
+Mutex SubCanvasInstances::mutex;
+SubCanvasInstances::PoolMap SubCanvasInstances::pools;
+
 /* === G L O B A L S ======================================================= */
 
 /* === M E T H O D S ======================================================= */
@@ -175,7 +340,9 @@ bool
 Layer_PasteCanvas::set_param(const String & param, const ValueBase &value)
 {
 	IMPORT_VALUE(param_origin);
-	IMPORT_VALUE(param_transformation);
+	IMPORT_VALUE_PLUS(param_transformation,
+		if (sub_canvas_instance) update_sub_canvas_instance();
+	);
 
 	// IMPORT(canvas);
 	if(param=="canvas" && value.can_get(Canvas::Handle()))
@@ -208,18 +375,18 @@ Layer_PasteCanvas::set_param(const String & param, const ValueBase &value)
 
 	IMPORT_VALUE(param_children_lock);
 	IMPORT_VALUE_PLUS(param_outline_grow,
-		if (canvas)
-		{
-			Real sub_outline_grow = param_outline_grow.get(Real());
-			canvas->set_outline_grow(get_outline_grow_mark() + sub_outline_grow);
-		}
+		if (sub_canvas_instance) update_sub_canvas_instance();
 	);
 	return Layer_Composite::set_param(param,value);
 }
 
 void
 Layer_PasteCanvas::childs_changed()
-	{ on_childs_changed(); }
+{
+	if (canvas && !canvas->is_inline())
+		SubCanvasInstances::invalidate(canvas);
+	on_childs_changed();
+}
 
 void
 Layer_PasteCanvas::set_sub_canvas(etl::handle<synfig::Canvas> x)
@@ -227,6 +394,10 @@ Layer_PasteCanvas::set_sub_canvas(etl::handle<synfig::Canvas> x)
 	if (canvas)
 		remove_child(canvas.get());
 
+	if (canvas && !canvas->is_inline() && sub_canvas_instance)
+		SubCanvasInstances::release(canvas, sub_canvas_instance);
+	sub_canvas_instance = NULL;
+
 	// if(canvas && (canvas->is_inline() || !get_canvas() || get_canvas()->get_root()!=canvas->get_root()))
 	if (extra_reference)
 		canvas->unref();
@@ -309,12 +480,31 @@ Layer_PasteCanvas::set_time_vfunc(IndependentContext context, Time time)const
 	depth_counter counter(depth);
 
 	context.set_time(time);
-	if (canvas)
-	{
-		Real time_dilation=param_time_dilation.get(Real());
-		Time time_offset=param_time_offset.get(Time());
-		canvas->set_time(time*time_dilation + time_offset);
-	}
+	update_sub_canvas_instance();
+}
+
+void
+Layer_PasteCanvas::update_sub_canvas_instance()const
+{
+	if (!canvas) return;
+
+	Time sub_time = get_sub_time();
+	// transformation may be changed with time
+	Real sub_pixel_size = get_sub_pixel_size(get_pixel_size_mark());
+	Real sub_outline_grow = get_outline_grow_mark() + param_outline_grow.get(Real());
+
+	if (canvas->is_inline())
+		sub_canvas_instance = canvas;
+	else
+		sub_canvas_instance = SubCanvasInstances::acquire(
+			canvas,
+			sub_canvas_instance,
+			SubCanvasInstances::Key(sub_time, sub_pixel_size, sub_outline_grow) );
+
+	// canvas is reevaluated only when parameters differs
+	sub_canvas_instance->set_time(sub_time);
+	sub_canvas_instance->set_outline_grow(sub_outline_grow);
+	sub_canvas_instance->set_pixel_size(sub_pixel_size);
 }
 
 void
@@ -324,11 +514,26 @@ Layer_PasteCanvas::set_outline_grow_vfunc(IndependentContext context, Real outli
 	depth_counter counter(depth);
 
 	context.set_outline_grow(outline_grow);
-	if (canvas)
-	{
-		Real sub_outline_grow = param_outline_grow.get(Real());
-		canvas->set_outline_grow(outline_grow + sub_outline_grow);
-	}
+	update_sub_canvas_instance();
+}
+
+void
+Layer_PasteCanvas::set_pixel_size_vfunc(IndependentContext context, Real pixel_size)const
+{
+	if (depth==MAX_DEPTH) return;
+	depth_counter counter(depth);
+
+	context.set_pixel_size(pixel_size);
+	update_sub_canvas_instance();
+}
+
+Real
+Layer_PasteCanvas::get_sub_pixel_size(Real pixel_size)const
+{
+	if (pixel_size <= 0.0) return 0.0;
+	Matrix matrix = get_summary_transformation().get_matrix();
+	Real scale = sqrt(fabs(matrix.m00*matrix.m11 - matrix.m01*matrix.m10));
+	return scale > 1e-8 ? pixel_size/scale : pixel_size;
 }
 
 void
@@ -354,10 +559,11 @@ Layer_PasteCanvas::hit_check(synfig::Context context, const synfig::Point &pos)c
 	if (canvas) {
 		Point target_pos = transformation.back_transform(pos);
 
-		if(canvas && get_amount() && canvas->get_context(cp).get_color(target_pos).get_a()>=0.25)
+		if(canvas && get_amount() && get_sub_canvas_instance()->get_context(cp).get_color(target_pos).get_a()>=0.25)
 		{
 			if(!children_lock)
 			{
+				// layers of the canvas itself, clones are not editable
 				return canvas->get_context(cp).hit_check(target_pos);
 			}
 			return const_cast<Layer_PasteCanvas*>(this);
@@ -380,7 +586,7 @@ Layer_PasteCanvas::get_color(Context context, const Point &pos)const
 
 	Point target_pos = transformation.back_transform(pos);
 
-	return Color::blend(canvas->get_context(cp).get_color(target_pos),context.get_color(pos),get_amount(),get_blend_method());
+	return Color::blend(get_sub_canvas_instance()->get_context(cp).get_color(target_pos),context.get_color(pos),get_amount(),get_blend_method());
 }
 
 Rect
@@ -393,7 +599,7 @@ Layer_PasteCanvas::get_bounding_rect_context_dependent(const ContextParams &cont
 
 		return get_summary_transformation()
 			.transform_bounds(
-				canvas->get_context(cp).get_full_bounding_rect() );
+				get_sub_canvas_instance()->get_context(cp).get_full_bounding_rect() );
 	}
 	return Rect::zero();
 }
@@ -430,7 +636,7 @@ Layer_PasteCanvas::accelerated_render(Context context,Surface *surface,int quali
 	SuperCallback stagetwo(cb,4500,9000,10000);
 	SuperCallback stagethree(cb,9000,9999,10000);
 
-	Context canvasContext = canvas->get_context(context);
+	Context canvasContext = get_sub_canvas_instance()->get_context(context);
 
 	if (is_solid_color())
 	{
@@ -617,7 +823,7 @@ Layer_PasteCanvas::accelerated_cairorender(Context context,cairo_t *cr, int qual
 	cairo_transform(subcr, &cairo_transformation_matrix);
 
 	// Effectively render the canvas content
-	ret=canvas->get_context(context).accelerated_cairorender(subcr, quality, workdesc, &stagetwo);
+	ret=get_sub_canvas_instance()->get_context(context).accelerated_cairorender(subcr, quality, workdesc, &stagetwo);
 	// we are done apply the result to the source
 	cairo_destroy(subcr);
 
@@ -683,7 +889,11 @@ void
 Layer_PasteCanvas::set_render_method(Context context, RenderMethod x)
 {
 	if(canvas) // if there is a canvas pass down to it
+	{
 		canvas->get_context(context).set_render_method(x);
+		if (get_sub_canvas_instance() != canvas)
+			get_sub_canvas_instance()->get_context(context).set_render_method(x);
+	}
 
 	// in any case pass it down
 	context.set_render_method(x);
@@ -701,16 +911,44 @@ Layer_PasteCanvas::build_composite_task_vfunc(ContextParams context_params) cons
 	if (!canvas)
 		return new rendering::TaskSurfaceEmpty();
 
-	CanvasBase sub_queue;
-	Context sub_context;
 	apply_z_range_to_params(context_params);
-	canvas->get_context_sorted(context_params, sub_queue, sub_context);
+
+	// instances with the same local time share one evaluation of the canvas
+	Canvas::Handle sub_canvas = get_sub_canvas_instance();
+	rendering::Task::Handle sub_task;
+	ContextInstanceCache::Key key;
+	if (context_params.instance_cache)
+	{
+		key.canvas = sub_canvas.get();
+		key.time = get_sub_time();
+		key.pixel_size = get_sub_pixel_size(get_pixel_size_mark());
+		key.outline_grow = get_outline_grow_mark() + param_outline_grow.get(Real());
+		key.render_excluded_contexts = context_params.render_excluded_contexts;
+		key.z_range = context_params.z_range;
+		key.z_range_position = context_params.z_range_position;
+		key.z_range_depth = context_params.z_range_depth;
+		key.z_range_blur = context_params.z_range_blur;
+
+		ContextInstanceCache::TaskMap::const_iterator i = context_params.instance_cache->tasks.find(key);
+		if (i != context_params.instance_cache->tasks.end())
+			sub_task = i->second->clone_recursive(); // optimizers may modify tasks
+	}
+
+	if (!sub_task)
+	{
+		CanvasBase sub_queue;
+		Context sub_context;
+		sub_canvas->get_context_sorted(context_params, sub_queue, sub_context);
+		sub_task = sub_context.build_rendering_task();
+		if (context_params.instance_cache)
+			context_params.instance_cache->tasks[key] = sub_task;
+	}
 
 	rendering::TaskTransformation::Handle task_transformation(new rendering::TaskTransformation());
 	rendering::AffineTransformation::Handle affine_transformation(new rendering::AffineTransformation());
 	affine_transformation->matrix = get_summary_transformation().get_matrix();
 	task_transformation->transformation = affine_transformation;
-	task_transformation->sub_task() = sub_context.build_rendering_task();
+	task_transformation->sub_task() = sub_task;
 	return task_transformation;
 }
 
@@ -103,8 +103,22 @@ private:
 	// 'extra_reference' member to store that decision.
 	bool extra_reference;
 
+	//! Sub canvas evaluated at the local time of this layer.
+	//! Exported canvas may be pasted by several layers with different
+	//! local time, so each distinct time has own evaluated canvas,
+	//! it's the exported canvas itself or its clone.
+	//! Inline canvas is always evaluated in place.
+	mutable etl::handle<synfig::Canvas> sub_canvas_instance;
+
 	void childs_changed();
 
+	//! Chooses and evaluates sub_canvas_instance for the current time,
+	//! pixel size and outline grow of this layer
+	void update_sub_canvas_instance()const;
+	//! Returns canvas which should be rendered by this layer
+	etl::handle<synfig::Canvas> get_sub_canvas_instance()const
+		{ return sub_canvas_instance ? sub_canvas_instance : etl::handle<synfig::Canvas>(canvas); }
+
 	/*
  -- ** -- S I G N A L S -------------------------------------------------------
 	*/
@@ -142,6 +156,8 @@ public:
 	Real get_time_dilation()const { return param_time_dilation.get(Real()); }
 	//! Gets time offset parameter
 	Time get_time_offset()const { return param_time_offset.get(Time()); }
+	//! Gets time of the sub canvas for the current time of the layer
+	Time get_sub_time()const { return get_time_mark()*get_time_dilation() + get_time_offset(); }
 
 	//! Get origin parameter
 	Point get_origin()const { return param_origin.get(Point()); }
@@ -192,6 +208,10 @@ protected:
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
 	//! Sets the outline_grow of the Paste Canvas Layer and those under it
 	virtual void set_outline_grow_vfunc(IndependentContext context, Real outline_grow)const;
+	//! Sets the pixel size of the Paste Canvas Layer and scaled one for the layers under it
+	virtual void set_pixel_size_vfunc(IndependentContext context, Real pixel_size)const;
+	//! Returns the pixel size in units of the sub canvas
+	Real get_sub_pixel_size(Real pixel_size)const;
 	//!	Function to be overloaded that fills the Time Point Set with
 	//! all the children Time Points. In this case the children Time Points
 	//! are the canvas parameter children layers Time points and the Paste Canvas
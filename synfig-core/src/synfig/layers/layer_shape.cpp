@@ -31,7 +31,9 @@
 #	include <config.h>
 #endif
 
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 
 #include <deque>
 #include <vector>
@@ -77,6 +79,13 @@ SYNFIG_LAYER_SET_CVS_ID(Layer_Shape,"$Id$");
 
 #define EPSILON	1e-12
 
+//! Allowed deviation of the flattened curves, in pixels
+#define FLATTENING_TOLERANCE	0.25
+//! Adaptive step may be up to this times smaller than the default one
+#define FLATTENING_MAX_DETAIL	4
+//! Count of shapes kept for other tolerances
+#define FLATTENED_SHAPES_COUNT	4
+
 template < class T >
 inline bool IsZero(const T &n)
 {
@@ -803,12 +812,15 @@ Layer_Shape::Layer_Shape(const Real &a, const Color::BlendMethod m):
 	param_feather        (Real(0.0)),
 	param_winding_style	 (int(rendering::Contour::WINDING_NON_ZERO)),
 	edge_table	         (new Intersector),
-	contour				 (new rendering::Contour)
+	contour				 (new rendering::Contour),
+	last_sync_tolerance  (0.0),
+	last_sync_used_tolerance(false)
 {
 }
 
 Layer_Shape::~Layer_Shape()
 {
+	clear_flattened_shapes();
 	delete edge_table;
 }
 
@@ -1055,14 +1067,130 @@ Layer_Shape::set_time_vfunc(IndependentContext context, Time time)const
 void
 Layer_Shape::sync(bool force) const
 {
+	// round tolerance down to the power of two,
+	// so small changes of zoom will not cause resync
+	Real tolerance = get_pixel_size_mark() > 0.0
+	               ? FLATTENING_TOLERANCE*pow(2.0, floor(log(get_pixel_size_mark())/log(2.0)))
+	               : 0.0;
+
 	if ( force
-	  || !last_sync_time.is_equal(get_time_mark())
+	  || !last_sync_time.is_equal(get_params_time_mark())
 	  || fabs(last_sync_outline_grow - get_outline_grow_mark()) > 1e-8 )
 	{
-		last_sync_time = get_time_mark();
+		clear_flattened_shapes();
+		last_sync_time = get_params_time_mark();
 		last_sync_outline_grow = get_outline_grow_mark();
+		last_sync_tolerance = tolerance;
+		last_sync_used_tolerance = false;
 		const_cast<Layer_Shape*>(this)->sync_vfunc();
 	}
+	else
+	if (last_sync_used_tolerance && last_sync_tolerance != tolerance)
+	{
+		if (!swap_flattened_shape(tolerance))
+		{
+			last_sync_used_tolerance = false;
+			const_cast<Layer_Shape*>(this)->sync_vfunc();
+		}
+	}
+}
+
+void
+Layer_Shape::clear_flattened_shapes() const
+{
+	for(std::vector<FlattenedShape>::iterator i = flattened_shapes.begin(); i != flattened_shapes.end(); ++i)
+		delete i->edge_table;
+	flattened_shapes.clear();
+}
+
+bool
+Layer_Shape::swap_flattened_shape(Real tolerance) const
+{
+	Layer_Shape *shape = const_cast<Layer_Shape*>(this);
+
+	FlattenedShape current;
+	current.tolerance = last_sync_tolerance;
+	current.edge_table = shape->edge_table;
+	current.contour = shape->contour;
+
+	std::vector<FlattenedShape>::iterator i = flattened_shapes.begin();
+	while(i != flattened_shapes.end() && i->tolerance != tolerance) ++i;
+	bool found = i != flattened_shapes.end();
+	if (found)
+	{
+		shape->edge_table = i->edge_table;
+		shape->contour = i->contour;
+		flattened_shapes.erase(i);
+	}
+	else
+	{
+		shape->edge_table = new Intersector();
+		shape->contour = new rendering::Contour();
+	}
+
+	if (flattened_shapes.size() >= FLATTENED_SHAPES_COUNT)
+	{
+		delete flattened_shapes.front().edge_table;
+		flattened_shapes.erase(flattened_shapes.begin());
+	}
+	flattened_shapes.push_back(current);
+
+	last_sync_tolerance = tolerance;
+	return found;
+}
+
+Real
+Layer_Shape::get_flattening_tolerance() const
+{
+	last_sync_used_tolerance = true;
+	return last_sync_tolerance;
+}
+
+Real
+Layer_Shape::get_flattening_step(
+	const Vector &p0,
+	const Vector &p1,
+	const Vector &t0,
+	const Vector &t1,
+	Real width,
+	Real width_range,
+	Real tolerance,
+	Real default_step )
+{
+	if (tolerance <= 0.0)
+		return default_step;
+
+	// control points of the same curve in bezier form
+	const Vector b[] = { p0, p0 + t0/3.0, p1 - t1/3.0, p1 };
+
+	// second derivative of cubic curve is linear,
+	// so it's maximum is at one of the ends
+	Real k = std::max(
+		((b[0] - b[1]*2.0 + b[2])*6.0).mag(),
+		((b[1] - b[2]*2.0 + b[3])*6.0).mag() );
+
+	// curve turns not more than its control polygon,
+	// and side at distance w turned by angle a deviates from chord by w*a^2/8
+	Real angle = 0.0;
+	Vector prev = Vector::zero();
+	for(int i = 1; i < 4; ++i)
+	{
+		Vector d = b[i] - b[i-1];
+		if (d.mag_squared() <= EPSILON) continue;
+		if (prev.mag_squared() > EPSILON)
+			angle += fabs(atan2(prev*d.perp(), prev*d));
+		prev = d;
+	}
+	k += fabs(width)*angle*angle;
+
+	// smooth variation of width
+	k += 6.0*fabs(width_range);
+
+	// n chords deviate from curve not more than k/(8*n^2)
+	Real count = ceil(sqrt(k/(8.0*tolerance)));
+	Real min_step = default_step/FLATTENING_MAX_DETAIL;
+	return count*min_step >= 1.0 ? min_step
+	     : count > 1.0 ? 1.0/count : 1.0;
 }
 
 void
@@ -77,6 +77,25 @@ private:
 
 	mutable Time last_sync_time;
 	mutable Real last_sync_outline_grow;
+	mutable Real last_sync_tolerance;
+	//! True when the last sync_vfunc() used the flattening tolerance
+	mutable bool last_sync_used_tolerance;
+
+	//! Shape flattened with other tolerance for the same time and outline grow
+	struct FlattenedShape
+	{
+		Real tolerance;
+		Intersector *edge_table;
+		rendering::Contour::Handle contour;
+	};
+	//! Shapes for other tolerances, oldest first,
+	//! so views with different zoom don't resync each other
+	mutable std::vector<FlattenedShape> flattened_shapes;
+
+	void clear_flattened_shapes() const;
+	//! Stores the current shape and takes one for \a tolerance,
+	//! returns false if there is no such shape and sync is needed
+	bool swap_flattened_shape(Real tolerance) const;
 
 protected:
 	Layer_Shape(const Real &a = 1.0, const Color::BlendMethod m = Color::BLEND_COMPOSITE);
@@ -99,6 +118,24 @@ protected:
 	Vector get_feather() const { return feather; }
 	void set_feather(const Vector &x) { feather = x; }
 
+	//! Returns the allowed distance between the flattened and the exact curves
+	//! for the current pixel size, or zero if the pixel size is unknown.
+	//! Shape will be resynced when the tolerance changes, if sync_vfunc() called it.
+	Real get_flattening_tolerance() const;
+
+	//! Returns parameter step to flatten the hermite curve (p0, p1, t0, t1)
+	//! with sides offset by \a width, which smoothly varies inside \a width_range.
+	//! Returns \a default_step when tolerance is zero.
+	static Real get_flattening_step(
+		const Vector &p0,
+		const Vector &p1,
+		const Vector &t0,
+		const Vector &t1,
+		Real width,
+		Real width_range,
+		Real tolerance,
+		Real default_step );
+
 public:
 	void sync(bool force = false) const;
 	void force_sync() const { sync(true); }
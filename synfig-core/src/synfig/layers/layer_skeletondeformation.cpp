@@ -73,7 +73,8 @@ Layer_SkeletonDeformation::Layer_SkeletonDeformation():
 	param_point1(ValueBase(Point(-4,4))),
 	param_point2(ValueBase(Point(4,-4))),
 	param_x_subdivisions(32),
-	param_y_subdivisions(32)
+	param_y_subdivisions(32),
+	weight_cache(new WeightCache())
 {
 	max_texture_scale = 1.f;
 	param_bones.set_list_of(std::vector<BonePair>(1));
@@ -82,9 +83,9 @@ Layer_SkeletonDeformation::Layer_SkeletonDeformation():
 	SET_STATIC_DEFAULTS();
 }
 
+// defined here, where WeightCache is complete
 Layer_SkeletonDeformation::~Layer_SkeletonDeformation()
-{
-}
+	{ }
 
 String
 Layer_SkeletonDeformation::get_local_name()const
@@ -195,18 +196,31 @@ Layer_SkeletonDeformation::prepare_mask()
  	}
 }
 
-struct Layer_SkeletonDeformation::GridPoint {
-	Vector initial_position;
-	Vector summary_position;
-	Real summary_depth;
-	Real summary_weight;
-	Real average_depth;
-	bool used;
-
-	inline GridPoint():
-		summary_depth(0.0), summary_weight(0.0), average_depth(0.0), used(false) { }
-	inline explicit GridPoint(const Vector &initial_position):
-		initial_position(initial_position), summary_depth(0.0), summary_weight(0.0), average_depth(0.0), used(false) { }
+struct Layer_SkeletonDeformation::WeightCache {
+	struct Influence {
+		int bone;
+		Real weight;
+		inline Influence(): bone(), weight() { }
+		inline Influence(int bone, Real weight): bone(bone), weight(weight) { }
+	};
+
+	//! Grid parameters and setup shapes of bones used to build the cache
+	std::vector<Real> key;
+	//! Initial positions of the used points of grid
+	std::vector<Vector> vertices;
+	//! Influences of vertex i are in range [first_influence[i], first_influence[i+1])
+	std::vector<int> first_influence;
+	std::vector<Influence> influences;
+	//! Vertices of the used cells of grid, four per cell
+	std::vector<int> cells;
+
+	//! Triangles sorted for bone depths
+	bool sorted;
+	std::vector<Real> depths;
+	Mesh::TriangleList triangles;
+
+	inline WeightCache(): sorted(false) { }
+
 	static bool compare_triagles(const std::pair<Real, Mesh::Triangle> &a, const std::pair<Real, Mesh::Triangle> &b)
 	{
 		return a.first < b.first ? false
@@ -241,13 +255,12 @@ Real Layer_SkeletonDeformation::distance_to_line(const Vector &p0, const Vector
 }
 
 void
-Layer_SkeletonDeformation::prepare_mesh()
+Layer_SkeletonDeformation::prepare_weights(const std::vector<Bone::Shape> &setup_shapes)
 {
 	static const Real precision = 1e-10;
 
-	mesh.clear();
-
-	// TODO: build grid with dynamic size
+	WeightCache &cache = *weight_cache;
+	cache = WeightCache();
 
 	const Point grid_p0 = param_point1.get(Point());
 	const Point grid_p1 = param_point2.get(Point());
@@ -258,16 +271,104 @@ Layer_SkeletonDeformation::prepare_mesh()
 	const Real grid_step_y = (grid_p1[1] - grid_p0[1]) / (Real)(grid_side_count_y - 1);
 	const Real grid_step_diagonal = sqrt(grid_step_x*grid_step_x + grid_step_y*grid_step_y);
 
-	// build grid
-	std::vector<GridPoint> grid;
-	grid.reserve(grid_side_count_x * grid_side_count_y);
+	// calculate weights only for the points of grid near the bones,
+	// other points are not used and stay empty
+	std::vector< std::vector<WeightCache::Influence> > grid(grid_side_count_x * grid_side_count_y);
+	for(int b = 0; b < (int)setup_shapes.size(); ++b)
+	{
+		const Bone::Shape &shape = setup_shapes[b];
+		Bone::Shape expanded_shape = shape;
+		expanded_shape.r0 += 2.0*grid_step_diagonal;
+		expanded_shape.r1 += 2.0*grid_step_diagonal;
+
+		Real r0 = fabs(expanded_shape.r0);
+		Real r1 = fabs(expanded_shape.r1);
+		Rect bounds(shape.p0 - Vector(r0, r0), shape.p0 + Vector(r0, r0));
+		bounds.expand(shape.p1 - Vector(r1, r1));
+		bounds.expand(shape.p1 + Vector(r1, r1));
+
+		int i0 = 0, i1 = grid_side_count_x - 1;
+		if (fabs(grid_step_x) > precision)
+		{
+			Real a = (bounds.minx - grid_p0[0])/grid_step_x;
+			Real b = (bounds.maxx - grid_p0[0])/grid_step_x;
+			i0 = std::max(i0, (int)floor(std::min(a, b)));
+			i1 = std::min(i1, (int)ceil(std::max(a, b)));
+		}
+		int j0 = 0, j1 = grid_side_count_y - 1;
+		if (fabs(grid_step_y) > precision)
+		{
+			Real a = (bounds.miny - grid_p0[1])/grid_step_y;
+			Real b = (bounds.maxy - grid_p0[1])/grid_step_y;
+			j0 = std::max(j0, (int)floor(std::min(a, b)));
+			j1 = std::min(j1, (int)ceil(std::max(a, b)));
+		}
+
+		for(int j = j0; j <= j1; ++j)
+		{
+			for(int i = i0; i <= i1; ++i)
+			{
+				Vector position(grid_p0[0] + i*grid_step_x, grid_p0[1] + j*grid_step_y);
+				Real percent = Bone::distance_to_shape_center_percent(expanded_shape, position);
+				if (percent > precision) {
+					Real distance = distance_to_line(shape.p0, shape.p1, position);
+					if (distance < precision) distance = precision;
+					Real weight =
+						percent/(distance*distance);
+						// 1.0/distance;
+						// 1.0/(distance*distance);
+						// 1.0/(distance*distance*distance);
+						// exp(-4.0*distance);
+					grid[j*grid_side_count_x + i].push_back(WeightCache::Influence(b, weight));
+				}
+			}
+		}
+	}
+
+	// collect used points
+	std::vector<int> grid_vertices(grid.size(), -1);
+	cache.first_influence.push_back(0);
 	for(int j = 0; j < grid_side_count_y; ++j)
+	{
 		for(int i = 0; i < grid_side_count_x; ++i)
-			grid.push_back(GridPoint(Vector(
-				grid_p0[0] + i*grid_step_x,
-				grid_p0[1] + j*grid_step_y )));
+		{
+			const std::vector<WeightCache::Influence> &point = grid[j*grid_side_count_x + i];
+			if (point.empty()) continue;
+			grid_vertices[j*grid_side_count_x + i] = (int)cache.vertices.size();
+			cache.vertices.push_back(Vector(grid_p0[0] + i*grid_step_x, grid_p0[1] + j*grid_step_y));
+			cache.influences.insert(cache.influences.end(), point.begin(), point.end());
+			cache.first_influence.push_back((int)cache.influences.size());
+		}
+	}
 
-	// apply deformation
+	// collect cells with all used corners
+	for(int j = 1; j < grid_side_count_y; ++j)
+	{
+		for(int i = 1; i < grid_side_count_x; ++i)
+		{
+			int v[] = {
+				grid_vertices[(j-1)*grid_side_count_x + (i-1)],
+				grid_vertices[(j-1)*grid_side_count_x +  i   ],
+				grid_vertices[ j   *grid_side_count_x +  i   ],
+				grid_vertices[ j   *grid_side_count_x + (i-1)],
+			};
+			if (v[0] >= 0 && v[1] >= 0 && v[2] >= 0 && v[3] >= 0)
+				cache.cells.insert(cache.cells.end(), v, v + 4);
+		}
+	}
+}
+
+void
+Layer_SkeletonDeformation::prepare_mesh()
+{
+	static const Real precision = 1e-10;
+
+	mesh.clear();
+
+	// collect bones
+	std::vector<Bone::Shape> setup_shapes;
+	std::vector<Matrix> matrices;
+	std::vector<Real> depths;
 	if (param_bones.can_get(ValueBase::List()))
 	{
 		const ValueBase::List &bones = param_bones.get_list();
@@ -278,10 +379,6 @@ Layer_SkeletonDeformation::prepare_mesh()
 				const BonePair &bone_pair = i->get(BonePair());
 				Bone::Shape shape0 = bone_pair.first.get_shape();
 				Bone::Shape shape1 = bone_pair.second.get_shape();
-				Bone::Shape expandedShape0 = shape0;
-				expandedShape0.r0 += 2.0*grid_step_diagonal;
-				expandedShape0.r1 += 2.0*grid_step_diagonal;
-				Real depth = bone_pair.second.get_depth();
 
 				Matrix into_bone(
 					shape0.p1[0] - shape0.p0[0], shape0.p1[1] - shape0.p0[1], 0.0,
@@ -294,68 +391,86 @@ Layer_SkeletonDeformation::prepare_mesh()
 					shape1.p0[1] - shape1.p1[1], shape1.p1[0] - shape1.p0[0], 0.0,
 					shape1.p0[0], shape1.p0[1], 1.0
 				);
-				Matrix matrix = into_bone * from_bone;
-
-				for(std::vector<GridPoint>::iterator j = grid.begin(); j != grid.end(); ++j)
-				{
-					Real percent = Bone::distance_to_shape_center_percent(expandedShape0, j->initial_position);
-					if (percent > precision) {
-						Real distance = distance_to_line(shape0.p0, shape0.p1, j->initial_position);
-						if (distance < precision) distance = precision;
-						Real weight =
-							percent/(distance*distance);
-							// 1.0/distance;
-							// 1.0/(distance*distance);
-							// 1.0/(distance*distance*distance);
-							// exp(-4.0*distance);
-						j->summary_position += matrix.get_transformed(j->initial_position) * weight;
-						j->summary_depth += depth * weight;
-						j->summary_weight += weight;
-						j->used = true;
-					}
-				}
+
+				setup_shapes.push_back(shape0);
+				matrices.push_back(into_bone * from_bone);
+				depths.push_back(bone_pair.second.get_depth());
 			}
 		}
 	}
 
-	// build vertices
-	mesh.vertices.reserve(grid.size());
-	for(std::vector<GridPoint>::iterator i = grid.begin(); i != grid.end(); ++i) {
-		Vector average_position = i->summary_weight > precision ? i->summary_position/i->summary_weight : i->initial_position;
-		i->average_depth = i->summary_weight > precision ? i->summary_depth/i->summary_weight : 0.0;
-		mesh.vertices.push_back(Mesh::Vertex(average_position, i->initial_position));
+	// weights depends only on grid and setup pose of bones,
+	// so usually they are calculated once
+	std::vector<Real> key;
+	key.push_back(param_point1.get(Point())[0]);
+	key.push_back(param_point1.get(Point())[1]);
+	key.push_back(param_point2.get(Point())[0]);
+	key.push_back(param_point2.get(Point())[1]);
+	key.push_back(param_x_subdivisions.get(int()));
+	key.push_back(param_y_subdivisions.get(int()));
+	for(std::vector<Bone::Shape>::const_iterator i = setup_shapes.begin(); i != setup_shapes.end(); ++i)
+	{
+		key.push_back(i->p0[0]);
+		key.push_back(i->p0[1]);
+		key.push_back(i->r0);
+		key.push_back(i->p1[0]);
+		key.push_back(i->p1[1]);
+		key.push_back(i->r1);
 	}
+	if (weight_cache->key != key)
+	{
+		prepare_weights(setup_shapes);
+		weight_cache->key = key;
+	}
+	WeightCache &cache = *weight_cache;
 
-	// build triangles
-	std::vector< std::pair<Real, Mesh::Triangle> > triangles;
-	triangles.reserve(2*(grid_side_count_x-1)*(grid_side_count_y-1));
-	for(int j = 1; j < grid_side_count_y; ++j)
+	// build vertices
+	std::vector<Real> vertex_depths(cache.vertices.size(), 0.0);
+	mesh.vertices.reserve(cache.vertices.size());
+	for(int i = 0; i < (int)cache.vertices.size(); ++i)
 	{
-		for(int i = 1; i < grid_side_count_x; ++i)
+		const Vector &initial_position = cache.vertices[i];
+		Vector summary_position;
+		Real summary_depth = 0.0;
+		Real summary_weight = 0.0;
+		for(int j = cache.first_influence[i]; j < cache.first_influence[i+1]; ++j)
 		{
-			int v[] = {
-				(j-1)*grid_side_count_x + (i-1),
-				(j-1)*grid_side_count_x +  i,
-				 j   *grid_side_count_x +  i,
-				 j   *grid_side_count_x + (i-1),
-			};
-			if (grid[v[0]].used && grid[v[1]].used && grid[v[2]].used && grid[v[3]].used)
-			{
-				Real depth = 0.25*(grid[v[0]].average_depth
-						         + grid[v[1]].average_depth
-								 + grid[v[2]].average_depth
-								 + grid[v[3]].average_depth);
-				triangles.push_back(std::make_pair(depth, Mesh::Triangle(v[0], v[1], v[3])));
-				triangles.push_back(std::make_pair(depth, Mesh::Triangle(v[1], v[2], v[3])));
-			}
+			const WeightCache::Influence &influence = cache.influences[j];
+			summary_position += matrices[influence.bone].get_transformed(initial_position) * influence.weight;
+			summary_depth += depths[influence.bone] * influence.weight;
+			summary_weight += influence.weight;
 		}
+
+		Vector average_position = summary_weight > precision ? summary_position/summary_weight : initial_position;
+		vertex_depths[i] = summary_weight > precision ? summary_depth/summary_weight : 0.0;
+		mesh.vertices.push_back(Mesh::Vertex(average_position, initial_position));
 	}
 
-	// sort triangles
-	std::sort(triangles.begin(), triangles.end(), GridPoint::compare_triagles);
-	mesh.triangles.reserve(triangles.size());
-	for(std::vector< std::pair<Real, Mesh::Triangle> >::iterator i = triangles.begin(); i != triangles.end(); ++i)
-		mesh.triangles.push_back(i->second);
+	// build and sort triangles, order depends only on depths of bones
+	if (!cache.sorted || cache.depths != depths)
+	{
+		std::vector< std::pair<Real, Mesh::Triangle> > triangles;
+		triangles.reserve(cache.cells.size()/2);
+		for(std::vector<int>::const_iterator i = cache.cells.begin(); i != cache.cells.end(); i += 4)
+		{
+			const int *v = &*i;
+			Real depth = 0.25*(vertex_depths[v[0]]
+							 + vertex_depths[v[1]]
+							 + vertex_depths[v[2]]
+							 + vertex_depths[v[3]]);
+			triangles.push_back(std::make_pair(depth, Mesh::Triangle(v[0], v[1], v[3])));
+			triangles.push_back(std::make_pair(depth, Mesh::Triangle(v[1], v[2], v[3])));
+		}
+
+		std::sort(triangles.begin(), triangles.end(), WeightCache::compare_triagles);
+		cache.triangles.clear();
+		cache.triangles.reserve(triangles.size());
+		for(std::vector< std::pair<Real, Mesh::Triangle> >::iterator i = triangles.begin(); i != triangles.end(); ++i)
+			cache.triangles.push_back(i->second);
+		cache.depths = depths;
+		cache.sorted = true;
+	}
+	mesh.triangles = cache.triangles;
 
 	prepare_mask();
 	update_mesh_and_mask();
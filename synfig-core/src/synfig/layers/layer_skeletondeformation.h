@@ -27,6 +27,8 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <ETL/smart_ptr>
+
 #include "layer_meshtransform.h"
 #include <synfig/pair.h>
 #include <synfig/bone.h>
@@ -58,9 +60,13 @@ private:
 	//! Parameter: (Integer)
 	synfig::ValueBase param_y_subdivisions;
 
-	struct GridPoint;
+	//! Grid and weights of bones, depends only on the setup pose of bones
+	struct WeightCache;
+	etl::smart_ptr<WeightCache> weight_cache;
+
 	static Real distance_to_line(const Vector &p0, const Vector &p1, const Vector &x);
 	void prepare_mask();
+	void prepare_weights(const std::vector<Bone::Shape> &setup_shapes);
 
 public:
 	typedef std::pair<Bone, Bone> BonePair;
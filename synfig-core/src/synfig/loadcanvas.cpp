@@ -3533,6 +3533,12 @@ CanvasParser::parse_from_file_as(const FileSystem::Identifier &identifier,const
 
 Canvas::Handle
 CanvasParser::parse_as(xmlpp::Element* node,String &errors)
+{
+	return parse_as(node,FileSystemNative::instance()->get_identifier(std::string()),"",errors);
+}
+
+Canvas::Handle
+CanvasParser::parse_as(xmlpp::Element* node,const FileSystem::Identifier &identifier,const String &as,String &errors)
 {
 	ChangeLocale change_locale(LC_NUMERIC, "C");
 	try
@@ -3540,7 +3546,7 @@ CanvasParser::parse_as(xmlpp::Element* node,String &errors)
 		total_warnings_=0;
 		if(node)
 		{
-			Canvas::Handle canvas(parse_canvas(node,0,false,FileSystemNative::instance()->get_identifier(std::string()),""));
+			Canvas::Handle canvas(parse_canvas(node,0,false,identifier,as));
 			if (!canvas) return canvas;
 
 			const ValueNodeList& value_node_list(canvas->value_node_list());
@@ -3611,4 +3617,35 @@ synfig::open_canvas(xmlpp::Element* node,String &errors,String &warnings){
 	return canvas;
 }
 
+//extern
+Canvas::Handle
+synfig::string_to_canvas(const String &data,const FileSystem::Identifier &identifier,const String &as,String &errors,String &warnings)
+{
+	xmlpp::DomParser document;
+	try
+	{
+		document.parse_memory(data);
+	}
+	catch(const std::exception& ex)
+	{
+		errors = ex.what();
+		return Canvas::Handle();
+	}
+	if(!document)
+	{
+		errors = _("Unable to parse canvas");
+		return Canvas::Handle();
+	}
+
+	CanvasParser parser;
+	Canvas::Handle canvas=parser.parse_as(document.get_document()->get_root_node(),identifier,as,errors);
+	warnings = parser.get_warnings_text();
+	if(parser.error_count())
+	{
+		errors = parser.get_errors_text();
+		return Canvas::Handle();
+	}
+	return canvas;
+}
+
 
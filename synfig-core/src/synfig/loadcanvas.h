@@ -144,6 +144,9 @@ public:
 	Canvas::Handle parse_from_file_as(const FileSystem::Identifier &identifier,const String &as,String &errors);
 	//! Parse a Canvas from a xmlpp root node
 	Canvas::Handle parse_as(xmlpp::Element* node,String &errors);
+	//! Parse a Canvas from a xmlpp root node, as it is the content of the file 'as'
+	//! opened by 'identifier', so relative paths of imported files are resolved from it
+	Canvas::Handle parse_as(xmlpp::Element* node,const FileSystem::Identifier &identifier,const String &as,String &errors);
 
 	//! Set of absolute file names of the canvases currently being parsed
 	static std::set<FileSystem::Identifier> loading_;
@@ -242,6 +245,10 @@ extern Canvas::Handle open_canvas(xmlpp::Element* node,String &errors,String &wa
 //!	Loads a canvas from \a filename and its absolute path
 /*!	\return	The Canvas's handle on success, an empty handle on failure */
 extern Canvas::Handle open_canvas_as(const FileSystem::Identifier &identifier,const String &as,String &errors,String &warnings);
+//!	Loads a canvas from \a data saved by canvas_to_string() as the content of file \a as,
+//!	the canvas is not registered in the open canvases map
+/*!	\return	The Canvas's handle on success, an empty handle on failure */
+extern Canvas::Handle string_to_canvas(const String &data,const FileSystem::Identifier &identifier,const String &as,String &errors,String &warnings);
 
 //! Returns the Open Canvases Map.
 //! \see open_canvas_map_
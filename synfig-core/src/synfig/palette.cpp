@@ -39,6 +39,8 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 
 #endif
 
@@ -246,6 +248,109 @@ Palette::find_closest(const Color& color, float* dist)
 }
 
 
+PaletteIndex::PaletteIndex():
+	root(-1)
+{ }
+
+PaletteIndex::PaletteIndex(const Palette& palette):
+	root(-1)
+{
+	std::vector<Node> items(palette.size());
+	for(int i = 0; i < (int)items.size(); ++i)
+	{
+		prepare(palette[i].color, items[i].point);
+		items[i].index = i;
+		items[i].axis = 0;
+		items[i].left = -1;
+		items[i].right = -1;
+	}
+	nodes.reserve(items.size());
+	root = build(items, 0, (int)items.size());
+}
+
+void
+PaletteIndex::prepare(const Color& color, float *point)
+{
+	// scaled to make squared distance the same as in Palette::find_closest()
+	static const float k = sqrtf(1.5f);
+	point[0] = powf(color.get_y(),2.2f)*color.get_a()*k;
+	point[1] = color.get_u();
+	point[2] = color.get_v();
+	point[3] = color.get_a();
+}
+
+int
+PaletteIndex::build(std::vector<Node> &items, int begin, int end)
+{
+	if (begin >= end) return -1;
+
+	// split by the axis with the largest spread
+	int axis = 0;
+	float best_spread = -1.f;
+	for(int a = 0; a < 4; ++a)
+	{
+		float min = items[begin].point[a], max = min;
+		for(int i = begin + 1; i < end; ++i)
+		{
+			min = std::min(min, items[i].point[a]);
+			max = std::max(max, items[i].point[a]);
+		}
+		if (max - min > best_spread) { best_spread = max - min; axis = a; }
+	}
+
+	int middle = (begin + end)/2;
+	std::nth_element(
+		items.begin() + begin,
+		items.begin() + middle,
+		items.begin() + end,
+		AxisLess(axis) );
+
+	int node = (int)nodes.size();
+	nodes.push_back(items[middle]);
+	nodes[node].axis = axis;
+	int left = build(items, begin, middle);
+	int right = build(items, middle + 1, end);
+	nodes[node].left = left;
+	nodes[node].right = right;
+	return node;
+}
+
+void
+PaletteIndex::search(int node, const float *point, int &best, float &best_dist)const
+{
+	if (node < 0) return;
+	const Node &n = nodes[node];
+
+	float d0 = point[0] - n.point[0];
+	float d1 = point[1] - n.point[1];
+	float d2 = point[2] - n.point[2];
+	float d3 = point[3] - n.point[3];
+	float dist = d0*d0 + d1*d1 + d2*d2 + d3*d3;
+	// on equal distance the first entry of palette wins, like in Palette::find_closest()
+	if (dist < best_dist || (dist == best_dist && n.index < best))
+		{ best_dist = dist; best = n.index; }
+
+	float diff = point[n.axis] - n.point[n.axis];
+	search(diff < 0.f ? n.left : n.right, point, best, best_dist);
+	if (diff*diff <= best_dist)
+		search(diff < 0.f ? n.right : n.left, point, best, best_dist);
+}
+
+int
+PaletteIndex::find_closest(const Color& color, float* dist)const
+{
+	float point[4];
+	prepare(color, point);
+
+	int best = -1;
+	float best_dist = 1000000.f;
+	search(root, point, best, best_dist);
+
+	if (dist)
+		*dist = best_dist;
+	return best;
+}
+
 Palette::iterator
 Palette::find_heavy()
 {
@@ -87,6 +87,47 @@ public:
 	static Palette load_from_file(const synfig::String& filename);
 }; // END of class Palette
 
+/*! \class PaletteIndex
+**	\brief k-d tree for fast search of the closest color in the palette.
+**
+**	Uses the same metric as Palette::find_closest() and returns the same
+**	entry, but visits only a few entries instead of the whole palette.
+**	Index is not updated when palette changes, it should be rebuilt.
+*/
+class PaletteIndex
+{
+	struct Node
+	{
+		float point[4];
+		int index;
+		int axis;
+		int left;
+		int right;
+	};
+
+	struct AxisLess
+	{
+		int axis;
+		explicit AxisLess(int axis): axis(axis) { }
+		bool operator()(const Node &a, const Node &b)const
+			{ return a.point[axis] < b.point[axis]; }
+	};
+
+	std::vector<Node> nodes;
+	int root;
+
+	static void prepare(const Color& color, float *point);
+	int build(std::vector<Node> &items, int begin, int end);
+	void search(int node, const float *point, int &best, float &best_dist)const;
+
+public:
+	PaletteIndex();
+	explicit PaletteIndex(const Palette& palette);
+
+	//! Returns index of the closest entry in palette, or -1 if palette is empty
+	int find_closest(const Color& color, float* dist=0)const;
+}; // END of class PaletteIndex
+
 }; // END of namespace synfig
 
 /* === E N D =============================================================== */
@@ -33,6 +33,8 @@
 
 #include "renddesc.h"
 #include <ETL/misc>
+#include <algorithm>
+#include <cmath>
 
 #endif
 
@@ -684,6 +686,13 @@ RendDesc::get_ph()const
 	return (br_[1] - tl_[1]) / h_;
 }
 
+Real
+RendDesc::get_pixel_size()const
+{
+	if (w_ <= 0 || h_ <= 0) return 0.0;
+	return std::min(fabs(get_pw()), fabs(get_ph()));
+}
+
 RendDesc &
 RendDesc::set_subwindow(int x, int y, int w, int h)
 {
@@ -337,6 +337,8 @@ public:
 	Real get_pw()const;
 	//! Returns the height of one pixel
 	Real get_ph()const;
+	//! Returns the smallest dimension of one pixel, zero for empty image
+	Real get_pixel_size()const;
 	//! Sets viewport to represent the screen at the given pixel coordinates
 	RendDesc &set_subwindow(int x, int y, int w, int h);
 	//! Sets the duration of the animation. 
@@ -0,0 +1,70 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/cancellation.h
+**	\brief Cancellation Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_CANCELLATION_H
+#define __SYNFIG_RENDERING_CANCELLATION_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <glib.h>
+
+#include <ETL/handle>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Shared flag of rendering request which result is not needed anymore.
+//! Renderer and RenderQueue check it between tasks, so cancelled request
+//! stops after tasks which are already running.
+class Cancellation: public etl::shared_object
+{
+private:
+	mutable gint cancelled;
+
+public:
+	typedef etl::handle<Cancellation> Handle;
+
+	Cancellation(): cancelled(0) { }
+
+	void cancel() { g_atomic_int_set(&cancelled, 1); }
+	bool is_cancelled() const { return g_atomic_int_get(&cancelled) != 0; }
+
+	static bool is_cancelled(const Handle &cancellation)
+		{ return cancellation && cancellation->is_cancelled(); }
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -64,6 +64,7 @@ OptimizerSurfaceResample::run(const RunParams& params) const
 			TaskSurfaceResample::Handle resample = new TaskSurfaceResample();
 			assign(resample, Task::Handle(transformation));
 			resample->transformation = affine->matrix;
+			resample->interpolation = transformation->interpolation;
 			apply(params, resample);
 		}
 	}
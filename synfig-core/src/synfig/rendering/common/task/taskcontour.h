@@ -53,6 +53,8 @@ public:
 		{ return !contour ? Rect::zero()
 			   : contour->invert ? Rect::infinite()
 		       : contour->calc_bounds(transformation); }
+	virtual TargetPrecision get_target_precision() const
+		{ return TARGET_PRECISION_MASK; }
 
 };
 
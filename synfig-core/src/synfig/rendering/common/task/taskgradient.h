@@ -0,0 +1,83 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskgradient.h
+**	\brief TaskGradient Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKGRADIENT_H
+#define __SYNFIG_RENDERING_TASKGRADIENT_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/angle.h>
+#include <synfig/gradient.h>
+
+#include "../../task.h"
+#include "tasktransformableaffine.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Fills whole plane by gradient, shapes are the same as in gradient layers
+class TaskGradient: public Task, public TaskTransformableAffine
+{
+public:
+	typedef etl::handle<TaskGradient> Handle;
+
+	enum Type
+	{
+		TYPE_LINEAR,  //!< from p1 to p2
+		TYPE_RADIAL,  //!< from center p1 to radius
+		TYPE_CONICAL, //!< around center p1 starting from angle
+		TYPE_SPIRAL   //!< around center p1 starting from angle, one turn per radius
+	};
+
+	Type type;
+	Gradient gradient;
+	Point p1;
+	Point p2;
+	Real radius;
+	Angle angle;
+	bool loop;      //!< linear and radial gradients only, conical and spiral are always looped
+	bool zigzag;    //!< for conical gradient it means 'symmetric'
+	bool clockwise; //!< spiral gradient only
+
+	TaskGradient(): type(TYPE_LINEAR), radius(1.0), loop(false), zigzag(false), clockwise(false) { }
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	virtual Rect calc_bounds() const
+		{ return gradient.empty() ? Rect::zero() : Rect::infinite(); }
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
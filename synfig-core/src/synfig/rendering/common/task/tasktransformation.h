@@ -47,9 +47,21 @@ public:
 	typedef etl::handle<TaskTransformation> Handle;
 
 	Transformation::Handle transformation;
+	Color::Interpolation interpolation;
+
+	TaskTransformation(): interpolation(Color::INTERPOLATION_CUBIC) { }
 
 	Task::Handle clone() const { return clone_pointer(this); }
 
+	//! Interpolation which legacy renderer used for given render quality
+	static Color::Interpolation get_interpolation_by_quality(int quality)
+	{
+		return quality <= 4 ? Color::INTERPOLATION_CUBIC
+		     : quality <= 5 ? Color::INTERPOLATION_COSINE
+		     : quality <= 6 ? Color::INTERPOLATION_LINEAR
+		     : Color::INTERPOLATION_NEAREST;
+	}
+
 	const Task::Handle& sub_task() const { return Task::sub_task(0); }
 	Task::Handle& sub_task() { return Task::sub_task(0); }
 };
@@ -532,7 +532,7 @@ Renderer::find_deps(const Task::List &list) const
 }
 
 bool
-Renderer::run(const Task::List &list) const
+Renderer::run(const Task::List &list, int priority, const Cancellation::Handle &cancellation, int frame) const
 {
 	//info("renderer: %s", get_name().c_str());
 	//info("renderer.debug.task_list_log: %s", get_debug_options().task_list_log.c_str());
@@ -555,6 +555,9 @@ Renderer::run(const Task::List &list) const
 	if (!get_debug_options().task_list_log.empty())
 		log(get_debug_options().task_list_log, list, "input list");
 
+	if (Cancellation::is_cancelled(cancellation))
+		return false;
+
 	Task::List optimized_list(list);
 	{
 		#ifdef DEBUG_TASK_MEASURE
@@ -563,6 +566,9 @@ Renderer::run(const Task::List &list) const
 		optimize(optimized_list);
 	}
 
+	if (Cancellation::is_cancelled(cancellation))
+		return false;
+
 	{
 		#ifdef DEBUG_TASK_MEASURE
 		debug::Measure t("find deps");
@@ -596,10 +602,11 @@ Renderer::run(const Task::List &list) const
 				++task_cond->deps_count;
 		optimized_list.push_back(task_cond);
 
-		queue->enqueue(optimized_list, Task::RunParams(this));
+		queue->enqueue(optimized_list, Task::RunParams(this, priority, cancellation, frame));
 
 		task_cond->cond->wait(mutex);
 		if (!task_cond->success) success = false;
+		if (Cancellation::is_cancelled(cancellation)) success = false;
 
 		if (!get_debug_options().result_image.empty())
 			debug::DebugSurface::save_to_file(
@@ -624,14 +631,20 @@ Renderer::enqueue(const Task::List &list, const Task::Handle &finish_signal_task
 	Task::List optimized_list(list);
 	optimize(optimized_list);
 	find_deps(optimized_list);
+
+	// sub-tasks inherit priority, cancellation and frame of the parent task
+	Task::RunParams params(this);
 	if (finish_signal_task)
 	{
+		params.priority = finish_signal_task->params.priority;
+		params.cancellation = finish_signal_task->params.cancellation;
+		params.frame = finish_signal_task->params.frame;
 		for(Task::List::const_iterator i = optimized_list.begin(); i != optimized_list.end(); ++i)
 			if ((*i)->back_deps.insert(finish_signal_task).second)
 				++finish_signal_task->deps_count;
 		optimized_list.push_back(finish_signal_task);
 	}
-	queue->enqueue(optimized_list, Task::RunParams(this));
+	queue->enqueue(optimized_list, params);
 }
 
 void
@@ -111,7 +111,7 @@ private:
 public:
 	int get_max_simultaneous_threads() const;
 	void optimize(Task::List &list) const;
-	bool run(const Task::List &list) const;
+	bool run(const Task::List &list, int priority = 0, const Cancellation::Handle &cancellation = Cancellation::Handle(), int frame = 0) const;
 	void enqueue(const Task::List &list, const Task::Handle &finish_signal_task = Task::Handle()) const;
 
 	static void initialize();
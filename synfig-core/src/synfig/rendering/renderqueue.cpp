@@ -39,15 +39,20 @@
 #include <climits>
 
 #include <typeinfo>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
 
 #include <synfig/general.h>
 #include <synfig/localization.h>
 #include <synfig/debug/debugsurface.h>
 #include <synfig/debug/log.h>
 #include <synfig/debug/measure.h>
+#include <synfig/debug/profiler.h>
 
 #include "renderqueue.h"
 #include "renderer.h"
+#include "common/task/tasksurfacedestroy.h"
 
 #ifdef WITH_OPENGL
 #include "opengl/task/taskgl.h"
@@ -74,6 +79,24 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+	//! Returns unqualified name of class of the task
+	String get_task_name(const Task &task)
+	{
+		String name = typeid(task).name();
+		#ifdef __GNUC__
+		int status = 0;
+		if (char *demangled = abi::__cxa_demangle(name.c_str(), NULL, NULL, &status))
+		{
+			if (status == 0) name = demangled;
+			free(demangled);
+		}
+		#endif
+		String::size_type pos = name.rfind("::");
+		return pos == String::npos ? name : name.substr(pos + 2);
+	}
+}
+
 /* === M E T H O D S ======================================================= */
 
 RenderQueue::RenderQueue(): started(false) { start(); }
@@ -138,6 +161,35 @@ RenderQueue::process(int thread_index)
 
 		assert( task->check() );
 
+		// result of cancelled request is not needed, so skip the work,
+		// but keep tasks without surfaces, because they signal the end of rendering,
+		// and TaskSurfaceDestroy, because it releases memory of temporary surfaces
+		if ( task->target_surface
+		  && !task.type_is<TaskSurfaceDestroy>()
+		  && Cancellation::is_cancelled(task->params.cancellation) )
+		{
+			task->success = false;
+		}
+		else
+		if (debug::Profiler::is_enabled())
+		{
+			debug::Profiler::Record record;
+			record.name = get_task_name(*task);
+			record.source = task->source;
+			record.frame = task->params.frame;
+			record.thread = thread_index;
+			bool created = task->target_surface && task->target_surface->is_created();
+			record.begin = debug::Profiler::get_time();
+
+			if (!task->run(task->params))
+				task->success = false;
+
+			record.duration = debug::Profiler::get_time() - record.begin;
+			if (!created && task->target_surface && task->target_surface->is_created())
+				record.bytes = task->target_surface->get_buffer_size();
+			debug::Profiler::add(record);
+		}
+		else
 		if (!task->run(task->params))
 			task->success = false;
 
@@ -185,7 +237,7 @@ RenderQueue::done(int thread_index, const Task::Handle &task)
 			TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
 			TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
 			wait.erase(*i);
-			queue.push_back(*i);
+			push(queue, *i);
 
 			// current process will take one task,
 			// so we don't need to call signal by first time
@@ -242,6 +294,20 @@ RenderQueue::fix_task(const Task &task, const Task::RunParams &params)
 	task.success = true;
 }
 
+void
+RenderQueue::push(TaskQueue &queue, const Task::Handle &task)
+{
+	// keep order of tasks with the same priority
+	TaskQueue::iterator i = queue.end();
+	while(i != queue.begin())
+	{
+		TaskQueue::iterator prev = i;
+		if ((*--prev)->params.priority >= task->params.priority) break;
+		i = prev;
+	}
+	queue.insert(i, task);
+}
+
 int
 RenderQueue::get_threads_count() const
 {
@@ -263,7 +329,7 @@ RenderQueue::enqueue(const Task::Handle &task, const Task::RunParams &params)
 	TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
 	TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
 	if (task->deps_count == 0) {
-		queue.push_back(task);
+		push(queue, task);
 		(gl ? condgl : cond).signal();
 	}
 	else
@@ -298,7 +364,7 @@ RenderQueue::enqueue(const Task::List &tasks, const Task::RunParams &params)
 			TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
 			TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
 			if ((*i)->deps_count == 0) {
-				queue.push_back(*i);
+				push(queue, *i);
 				if (gl)
 				{
 					if (glsignals < 1) { condgl.signal(); ++glsignals; }
@@ -89,6 +89,7 @@ private:
 	Task::Handle get(int thread_index);
 
 	static void fix_task(const Task &task, const Task::RunParams &params);
+	static void push(TaskQueue &queue, const Task::Handle &task);
 
 public:
 	RenderQueue();
@@ -35,8 +35,11 @@
 #include <signal.h>
 #endif
 
+#include <algorithm>
+
 #include "contour.h"
 
+#include <synfig/color/colorblendingfunctions.h>
 #include <synfig/debug/debugsurface.h>
 
 #endif
@@ -50,6 +53,99 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+	//! Writes spans of constant color into the rows of surface.
+	//! Opaque fill and COMPOSITE blending have dedicated loops over the row
+	//! with the source color prepared once per span, other blend methods
+	//! are done per pixel by Color::blend
+	class SpanWriter
+	{
+	private:
+		synfig::Surface &surface;
+		const Color color;
+		const Color::value_type opacity;
+		const Color::BlendMethod blend_method;
+		//! blending gives the color itself, so pixels are just overwritten
+		const bool fill;
+
+		void composite(Color *dst, int count, Color::value_type amount) const
+		{
+			// same as blendfunc_COMPOSITE
+			const Color::value_type a = color.get_a()*amount;
+			const Color::value_type r = color.get_r()*a;
+			const Color::value_type g = color.get_g()*a;
+			const Color::value_type b = color.get_b()*a;
+			const Color::value_type inv_a = 1 - a;
+			for(Color *end = dst + count; dst < end; ++dst)
+			{
+				Color::value_type k = dst->get_a()*inv_a;
+				Color::value_type dst_a = a + k;
+				if (fabsf(dst_a) > COLOR_EPSILON)
+				{
+					Color::value_type kk = 1/dst_a;
+					*dst = Color(
+						(r + dst->get_r()*k)*kk,
+						(g + dst->get_g()*k)*kk,
+						(b + dst->get_b()*k)*kk,
+						dst_a );
+				}
+				else
+				{
+					*dst = Color::alpha();
+				}
+			}
+		}
+
+		void blend(Color *dst, int count, Color::value_type amount) const
+		{
+			// Color::blend keeps the destination if amount is zero
+			if (fabsf(amount) <= COLOR_EPSILON)
+				return;
+			if (blend_method == Color::BLEND_COMPOSITE)
+				composite(dst, count, amount);
+			else
+				for(Color *end = dst + count; dst < end; ++dst)
+					*dst = Color::blend(color, *dst, amount, blend_method);
+		}
+
+	public:
+		SpanWriter(
+			synfig::Surface &surface,
+			const Color &color,
+			Color::value_type opacity,
+			Color::BlendMethod blend_method
+		):
+			surface(surface),
+			color(color),
+			opacity(opacity),
+			blend_method(blend_method),
+			fill( (Color::BLEND_METHODS_OVERWRITE_ON_ALPHA_ONE & (1 << blend_method))
+			   && fabsf(1.f - opacity*color.get_a()) <= 1e-6 )
+			{ }
+
+		//! Puts fully covered pixels
+		void put_span(int x, int y, int count) const
+		{
+			if (count <= 0) return;
+			Color *dst = &surface[y][x];
+			if (fill)
+				std::fill(dst, dst + count, color);
+			else
+				blend(dst, count, opacity);
+		}
+
+		void put_block(int x, int y, int w, int h) const
+		{
+			for(int yy = y; yy < y + h; ++yy)
+				put_span(x, yy, w);
+		}
+
+		//! Puts partially covered pixel
+		void put_pixel(int x, int y, Color::value_type alpha) const
+			{ blend(&surface[y][x], 1, opacity*alpha); }
+	};
+}
+
 /* === M E T H O D S ======================================================= */
 
 void
@@ -63,11 +159,7 @@ software::Contour::render_polyspan(
 	Color::value_type opacity,
 	Color::BlendMethod blend_method )
 {
-	bool simple_fill = (Color::BLEND_METHODS_OVERWRITE_ON_ALPHA_ONE & (1 << blend_method))
-			        && fabsf(1.f - opacity*color.get_a()) <= 1e-6;
-
-	synfig::Surface::alpha_pen p(target_surface.begin(), opacity, blend_method);
-	synfig::Surface::pen sp(target_surface.begin());
+	SpanWriter writer(target_surface, color, opacity, blend_method);
 	const RectInt &window = polyspan.get_window();
 	const Polyspan::cover_array &covers = polyspan.get_covers();
 
@@ -77,60 +169,22 @@ software::Contour::render_polyspan(
 	Real cover = 0, area = 0, alpha = 0;
 	int	y = 0, x = 0;
 
-	p.set_value(color);
-	sp.set_value(color);
-	cover = 0;
-
 	if (cur_mark == end_mark)
 	{
 		// no marks at all
 		if (invert)
-		{
-			if (simple_fill)
-			{
-				sp.move_to(window.minx, window.miny);
-				sp.put_block(window.maxy - window.miny, window.maxx - window.minx);
-			}
-			else
-			{
-				p.move_to(window.minx, window.miny);
-				p.put_block(window.maxy - window.miny, window.maxx - window.minx);
-			}
-		}
+			writer.put_block(window.minx, window.miny, window.maxx - window.minx, window.maxy - window.miny);
 		return;
 	}
 
 	// fill initial rect / line
 	if (invert)
 	{
-		if (simple_fill)
-		{
-			// fill all the area above the first vertex
-			sp.move_to(window.minx, window.miny);
-			y = window.miny;
-			int l = window.maxx - window.minx;
-
-			sp.put_block(cur_mark->y - window.miny, l);
+		// fill all the area above the first vertex
+		writer.put_block(window.minx, window.miny, window.maxx - window.minx, cur_mark->y - window.miny);
 
-			// fill the area to the left of the first vertex on that line
-			l = cur_mark->x - window.minx;
-			sp.move_to(window.minx, cur_mark->y);
-			if (l) sp.put_hline(l);
-		}
-		else
-		{
-			// fill all the area above the first vertex
-			p.move_to(window.minx, window.miny);
-			y = window.miny;
-			int l = window.maxx - window.minx;
-
-			p.put_block(cur_mark->y - window.miny, l);
-
-			// fill the area to the left of the first vertex on that line
-			l = cur_mark->x - window.minx;
-			p.move_to(window.minx, cur_mark->y);
-			if (l) p.put_hline(l);
-		}
+		// fill the area to the left of the first vertex on that line
+		writer.put_span(window.minx, cur_mark->y, cur_mark->x - window.minx);
 	}
 
 	while(true)
@@ -138,8 +192,6 @@ software::Contour::render_polyspan(
 		y = cur_mark->y;
 		x = cur_mark->x;
 
-		p.move_to(x,y);
-
 		area = cur_mark->area;
 		cover += cur_mark->cover;
 
@@ -161,14 +213,13 @@ software::Contour::render_polyspan(
 
 			if (antialias)
 			{
-				if (alpha) p.put_value_alpha(alpha);
+				if (alpha) writer.put_pixel(x, y, alpha);
 			}
 			else
 			{
-				if (alpha >= .5) p.put_value();
+				if (alpha >= .5) writer.put_pixel(x, y, 1);
 			}
 
-			p.inc_x();
 			++x;
 		}
 
@@ -181,88 +232,35 @@ software::Contour::render_polyspan(
 			if (invert)
 			{
 				// fill the area at the end of the line
-				if (simple_fill)
-				{
-					sp.move_to(p);
-					sp.put_hline(window.maxx - x);
-				}
-				else
-				{
-					p.put_hline(window.maxx - x);
-				}
+				writer.put_span(x, y, window.maxx - x);
 
 				// fill area at the beginning of the next line
-				if (simple_fill)
-				{
-					sp.move_to(window.minx, cur_mark->y);
-					sp.put_hline(cur_mark->x - window.minx);
-				}
-				else
-				{
-					p.move_to(window.minx, cur_mark->y);
-					p.put_hline(cur_mark->x - window.minx);
-				}
+				writer.put_span(window.minx, cur_mark->y, cur_mark->x - window.minx);
 			}
 
 			cover = 0;
 			continue;
 		}
 
-		// draw span to next pixel - based on total amount of pixel cover
+		// draw span to next pixel - based on total amount of pixel cover,
+		// winding rule is applied once for the whole span
 		if (x < cur_mark->x)
 		{
 			alpha = polyspan.extract_alpha(cover, winding_style);
 			if (invert) alpha = 1 - alpha;
 			if (alpha >= .5)
-			{
-				if (simple_fill)
-				{
-					sp.move_to(p);
-					sp.put_hline(cur_mark->x - x);
-					p.move_to(sp);
-				}
-				else
-				{
-					p.put_hline(cur_mark->x - x);
-				}
-			}
-
-			/*
-			if (antialias)
-			{
-				if (alpha) p.put_hline(cur_mark->x - x, alpha);
-			}
-			else
-			{
-				if (alpha >= .5) p.put_hline(cur_mark->x - x);
-			}
-			*/
+				writer.put_span(x, y, cur_mark->x - x);
 		}
 	}
 
 	// fill the after stuff
 	if (invert)
 	{
-		if (simple_fill)
-		{
-			sp.move_to(p);
-
-			//fill the area at the end of the line
-			sp.put_hline(window.maxx - x);
+		//fill the area at the end of the line
+		writer.put_span(x, y, window.maxx - x);
 
-			//fill area at the beginning of the next line
-			sp.move_to(window.minx, y+1);
-			sp.put_block(window.maxy - y - 1, window.maxx - window.minx);
-		}
-		else
-		{
-			//fill the area at the end of the line
-			p.put_hline(window.maxx - x);
-
-			//fill area at the beginning of the next line
-			p.move_to(window.minx, y+1);
-			p.put_block(window.maxy - y - 1, window.maxx - window.minx);
-		}
+		//fill area at the beginning of the next line
+		writer.put_block(window.minx, y + 1, window.maxx - window.minx, window.maxy - y - 1);
 	}
 }
 
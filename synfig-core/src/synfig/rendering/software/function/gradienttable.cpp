@@ -0,0 +1,159 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/gradienttable.cpp
+**	\brief GradientTable
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include <synfig/real.h>
+
+#include "gradienttable.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+GradientTable::GradientTable():
+	begin(), end(), step(), k(), sums(1) { }
+
+GradientTable::GradientTable(const Gradient &gradient, int size):
+	begin(), end(), step(), k()
+{
+	set(gradient, size);
+}
+
+void
+GradientTable::set(const Gradient &gradient, int size)
+{
+	begin = end = step = k = 0.0;
+	front = back = Sum();
+	sums.clear();
+
+	if (gradient.empty())
+		{ sums.resize(1); return; }
+
+	front = Sum(gradient.begin()->color);
+	back = Sum(gradient.rbegin()->color);
+	begin = gradient.begin()->pos;
+	end = gradient.rbegin()->pos;
+
+	// single point or all points at the same position
+	if (!(end - begin > real_low_precision<Real>()))
+		{ end = begin; sums.resize(1); return; }
+
+	size = std::max(1, size);
+	step = (end - begin)/size;
+	k = size/(end - begin);
+	sums.resize(size + 1);
+
+	// integrate piecewise-linear premultiplied colors segment by segment,
+	// and store the accumulated value in every node passed by
+	Sum sum;
+	int j = 1;
+	Real xj = j < size ? begin + j*step : end;
+	for(Gradient::const_iterator i = gradient.begin(), next = i + 1; next != gradient.end() && j <= size; i = next++)
+	{
+		const Real x0 = i->pos, x1 = next->pos;
+		if (!(x1 > x0)) continue;
+
+		const Sum c0(i->color), c1(next->color);
+		const Real kx = 1.0/(x1 - x0);
+		Real x = x0;
+		Sum cx = c0;
+		while(j <= size)
+		{
+			const Real b = std::min(x1, xj);
+			const Sum cb = b < x1 ? c0 + (c1 - c0)*((b - x0)*kx) : c1;
+			sum = sum + (cx + cb)*(0.5*(b - x));
+			x = b;
+			cx = cb;
+			if (b < xj) break;
+
+			sums[j++] = sum;
+			xj = j < size ? begin + j*step : end;
+			if (!(x < x1)) break;
+		}
+	}
+	for(; j <= size; ++j)
+		sums[j] = sum;
+}
+
+void
+GradientTable::integral(Real x, Sum &out) const
+{
+	if (!(x > begin))
+		{ out = front*(x - begin); return; }
+	if (!(x < end))
+		{ out = sums.back() + back*(x - end); return; }
+
+	Real f = (x - begin)*k;
+	int i = std::min((int)f, (int)sums.size() - 2);
+	f -= i;
+	out = sums[i] + (sums[i + 1] - sums[i])*f;
+}
+
+Color
+GradientTable::get_premult(Real x, Real supersample) const
+{
+	if (std::isnan(x))
+		return Color(front.r, front.g, front.b, front.a);
+
+	supersample = std::min(2.0, std::max(step, fabs(supersample)));
+	if (supersample < real_low_precision<Real>() || x + 0.5*supersample <= begin || x - 0.5*supersample >= end)
+	{
+		// whole sample is outside of gradient
+		const Sum &c = x < begin ? front : back;
+		return Color(c.r, c.g, c.b, c.a);
+	}
+
+	Sum a, b;
+	integral(x - 0.5*supersample, a);
+	integral(x + 0.5*supersample, b);
+	const Sum c = (b - a)*(1.0/supersample);
+	return Color(c.r, c.g, c.b, c.a);
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,100 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/gradienttable.h
+**	\brief GradientTable Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SOFTWARE_GRADIENTTABLE_H
+#define __SYNFIG_RENDERING_SOFTWARE_GRADIENTTABLE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <vector>
+
+#include <synfig/color.h>
+#include <synfig/gradient.h>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+namespace software
+{
+
+//! Precomputed gradient for fast sampling with supersampling.
+//! Stores the integral of premultiplied colors in uniform cells,
+//! so averaging over any width costs the same as a single lookup.
+class GradientTable
+{
+public:
+	enum { DEFAULT_SIZE = 4096 };
+
+private:
+	struct Sum
+	{
+		Real r, g, b, a;
+		Sum(): r(), g(), b(), a() { }
+		explicit Sum(const Color &c):
+			r(c.get_r()*c.get_a()), g(c.get_g()*c.get_a()), b(c.get_b()*c.get_a()), a(c.get_a()) { }
+		Sum(Real r, Real g, Real b, Real a): r(r), g(g), b(b), a(a) { }
+
+		Sum operator+(const Sum &x) const { return Sum(r + x.r, g + x.g, b + x.b, a + x.a); }
+		Sum operator-(const Sum &x) const { return Sum(r - x.r, g - x.g, b - x.b, a - x.a); }
+		Sum operator*(Real x) const { return Sum(r*x, g*x, b*x, a*x); }
+	};
+
+	Real begin;
+	Real end;
+	Real step;
+	Real k;
+	Sum front;
+	Sum back;
+	std::vector<Sum> sums;
+
+	void integral(Real x, Sum &out) const;
+
+public:
+	GradientTable();
+	explicit GradientTable(const Gradient &gradient, int size = DEFAULT_SIZE);
+
+	void set(const Gradient &gradient, int size = DEFAULT_SIZE);
+
+	//! Premultiplied color averaged over [x - supersample/2, x + supersample/2],
+	//! supersample is limited by 2.0 like in Gradient::operator()
+	Color get_premult(Real x, Real supersample) const;
+
+	Color get(Real x, Real supersample) const
+		{ return get_premult(x, supersample).demult_alpha(); }
+};
+
+} /* end namespace software */
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
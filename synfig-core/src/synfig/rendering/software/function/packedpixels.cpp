@@ -0,0 +1,276 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/packedpixels.cpp
+**	\brief PackedPixels
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include "packedpixels.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	inline float byte_to_alpha(unsigned char x)
+		{ return x/255.f; }
+
+	inline bool alpha_to_byte(float x, unsigned char &out_byte)
+	{
+		if (!(x >= 0.f && x <= 1.f)) return false;
+		out_byte = (unsigned char)(int)roundf(x*255.f);
+		return byte_to_alpha(out_byte) == x;
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+int
+PackedPixels::get_pixel_size(Format format)
+{
+	switch(format)
+	{
+	case FORMAT_RGBA32F: return sizeof(Color);
+	case FORMAT_ALPHA32F: return sizeof(float);
+	case FORMAT_ALPHA8:  return 1;
+	}
+	return 0;
+}
+
+unsigned short
+PackedPixels::float_to_half(float x)
+{
+	unsigned int f;
+	memcpy(&f, &x, sizeof(f));
+
+	unsigned int sign = (f >> 16) & 0x8000;
+	unsigned int exponent = (f >> 23) & 0xff;
+	unsigned int mantissa = f & 0x7fffff;
+
+	// infinity and NaN
+	if (exponent == 0xff)
+		return (unsigned short)(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+	int e = (int)exponent - 127 + 15;
+
+	// overflow
+	if (e >= 31)
+		return (unsigned short)(sign | 0x7c00);
+
+	// subnormal or zero
+	if (e <= 0)
+	{
+		if (e < -10) return (unsigned short)sign;
+		mantissa |= 0x800000;
+		int shift = 14 - e;
+		unsigned int h = mantissa >> shift;
+		unsigned int rest = mantissa & ((1u << shift) - 1);
+		unsigned int middle = 1u << (shift - 1);
+		if (rest > middle || (rest == middle && (h & 1))) ++h;
+		return (unsigned short)(sign | h);
+	}
+
+	// normal, rounding may carry into exponent, it's valid (up to infinity)
+	unsigned int h = ((unsigned int)e << 10) | (mantissa >> 13);
+	unsigned int rest = mantissa & 0x1fff;
+	if (rest > 0x1000 || (rest == 0x1000 && (h & 1))) ++h;
+	return (unsigned short)(sign | h);
+}
+
+float
+PackedPixels::half_to_float(unsigned short x)
+{
+	unsigned int sign = ((unsigned int)x & 0x8000) << 16;
+	int exponent = (x >> 10) & 0x1f;
+	unsigned int mantissa = x & 0x3ff;
+
+	unsigned int f;
+	if (exponent == 0)
+	{
+		if (mantissa == 0)
+		{
+			f = sign;
+		}
+		else
+		{
+			// normalize subnormal
+			exponent = 1;
+			while(!(mantissa & 0x400)) { mantissa <<= 1; --exponent; }
+			mantissa &= 0x3ff;
+			f = sign | ((unsigned int)(exponent + 127 - 15) << 23) | (mantissa << 13);
+		}
+	}
+	else
+	if (exponent == 31)
+	{
+		f = sign | 0x7f800000 | (mantissa << 13);
+	}
+	else
+	{
+		f = sign | ((unsigned int)(exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	memcpy(&result, &f, sizeof(result));
+	return result;
+}
+
+PackedPixels::Format
+PackedPixels::choose_format(
+	Format desired,
+	const Color *src,
+	int count,
+	Color &out_mask_color )
+{
+	// check all formats in one pass, and stop
+	// when nothing more compact than RGBA32F remains
+	bool mask = desired >= FORMAT_ALPHA32F;
+	bool mask8 = desired >= FORMAT_ALPHA8;
+	bool found = false;
+	Color color = Color::alpha();
+	unsigned char byte;
+
+	for(const Color *c = src, *end = src + count; c < end && mask; ++c)
+	{
+		Color::value_type a = c->get_a();
+		if (a == 0)
+		{
+			// transparent pixels should be clean
+			if (c->get_r() != 0 || c->get_g() != 0 || c->get_b() != 0)
+				mask = false;
+		}
+		else
+		if (!found)
+		{
+			// NaN in color channels breaks the mask
+			color = Color(c->get_r(), c->get_g(), c->get_b(), 1);
+			found = c->get_r() == color.get_r()
+				 && c->get_g() == color.get_g()
+				 && c->get_b() == color.get_b();
+			mask = found;
+		}
+		else
+		if ( c->get_r() != color.get_r()
+		  || c->get_g() != color.get_g()
+		  || c->get_b() != color.get_b() )
+			mask = false;
+
+		if (mask && mask8)
+			mask8 = alpha_to_byte(a, byte);
+	}
+
+	if (mask)
+	{
+		out_mask_color = color;
+		return mask8 ? FORMAT_ALPHA8 : FORMAT_ALPHA32F;
+	}
+	return FORMAT_RGBA32F;
+}
+
+void
+PackedPixels::pack(
+	Format format,
+	const Color & /* mask_color */,
+	void *dst,
+	const Color *src,
+	int count )
+{
+	const Color *end = src + count;
+	switch(format)
+	{
+	case FORMAT_RGBA32F:
+		memcpy(dst, src, count*sizeof(Color));
+		break;
+	case FORMAT_ALPHA32F:
+		{
+			float *d = (float*)dst;
+			for(const Color *c = src; c < end; ++c, ++d)
+				*d = c->get_a();
+		}
+		break;
+	case FORMAT_ALPHA8:
+		{
+			unsigned char *d = (unsigned char*)dst;
+			for(const Color *c = src; c < end; ++c, ++d)
+				alpha_to_byte(c->get_a(), *d);
+		}
+		break;
+	}
+}
+
+void
+PackedPixels::unpack(
+	Format format,
+	const Color &mask_color,
+	Color *dst,
+	const void *src,
+	int count )
+{
+	Color *end = dst + count;
+	switch(format)
+	{
+	case FORMAT_RGBA32F:
+		memcpy(dst, src, count*sizeof(Color));
+		break;
+	case FORMAT_ALPHA32F:
+		{
+			const float *s = (const float*)src;
+			for(Color *c = dst; c < end; ++c, ++s)
+				*c = *s ? Color(mask_color.get_r(), mask_color.get_g(), mask_color.get_b(), *s)
+				        : Color::alpha();
+		}
+		break;
+	case FORMAT_ALPHA8:
+		{
+			const unsigned char *s = (const unsigned char*)src;
+			for(Color *c = dst; c < end; ++c, ++s)
+				*c = *s ? Color(mask_color.get_r(), mask_color.get_g(), mask_color.get_b(), byte_to_alpha(*s))
+				        : Color::alpha();
+		}
+		break;
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,92 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/packedpixels.h
+**	\brief PackedPixels Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SOFTWARE_PACKEDPIXELS_H
+#define __SYNFIG_RENDERING_SOFTWARE_PACKEDPIXELS_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/color.h>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+namespace software
+{
+
+//! Lossless conversion of rows of Color into compact pixel formats and back
+class PackedPixels
+{
+public:
+	//! Formats ordered from the least compact to the most compact
+	enum Format
+	{
+		FORMAT_RGBA32F, //!< straight RGBA, copy of Color (16 bytes per pixel)
+		FORMAT_ALPHA32F, //!< alpha only, color is constant for whole surface (4 bytes per pixel)
+		FORMAT_ALPHA8   //!< alpha only, multiple of 1/255, color is constant (1 byte per pixel)
+	};
+
+	static int get_pixel_size(Format format);
+
+	static unsigned short float_to_half(float x);
+	static float half_to_float(unsigned short x);
+
+	//! Returns the most compact format which is not more compact than 'desired'
+	//! and can store all pixels exactly, unpack(pack(src)) is equal to src.
+	//! For alpha formats the common color of pixels stored into out_mask_color.
+	static Format choose_format(
+		Format desired,
+		const Color *src,
+		int count,
+		Color &out_mask_color );
+
+	static void pack(
+		Format format,
+		const Color &mask_color,
+		void *dst,
+		const Color *src,
+		int count );
+
+	static void unpack(
+		Format format,
+		const Color &mask_color,
+		Color *dst,
+		const void *src,
+		int count );
+};
+
+} /* end namespace software */
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -41,6 +41,9 @@
 
 #include "../surfacesw.h"
 #include "../task/tasklayersw.h"
+#include "../../common/task/tasklist.h"
+#include "../../common/task/tasksurface.h"
+#include "../../renderer.h"
 
 #include <synfig/renddesc.h>
 
@@ -63,6 +66,38 @@ OptimizerLayerSW::renddesc_less(const RendDesc &a, const RendDesc &b)
 	return fabs(a.get_pw()*a.get_ph()) > fabs(b.get_pw()*b.get_ph());
 }
 
+Task::Handle
+OptimizerLayerSW::split(const TaskLayerSW::Handle &layer_sw, int count)
+{
+	TaskList::Handle list = new TaskList();
+	assign(list, Task::Handle(layer_sw));
+	list->sub_tasks.clear();
+
+	// context under the layer will be rendered once by the first part,
+	// and other parts will read the same surfaces
+	Task::List surfaces;
+	for(Task::List::const_iterator i = layer_sw->sub_tasks.begin(); i != layer_sw->sub_tasks.end(); ++i)
+	{
+		Task::Handle surface = new TaskSurface();
+		assign(surface, *i);
+		surface->sub_tasks.clear();
+		surfaces.push_back(surface);
+	}
+
+	// parts are horizontal stripes of the target rect
+	RectInt r = layer_sw->get_target_rect();
+	int h = r.maxy - r.miny;
+	for(int j = 0; j < count; ++j)
+	{
+		TaskLayerSW::Handle part = TaskLayerSW::Handle::cast_dynamic(layer_sw->clone());
+		if (j) part->sub_tasks = surfaces;
+		part->trunc_target_rect(RectInt(r.minx, r.miny + h*j/count, r.maxx, r.miny + h*(j + 1)/count));
+		list->sub_tasks.push_back(part);
+	}
+
+	return list;
+}
+
 void
 OptimizerLayerSW::run(const RunParams& params) const
 {
@@ -97,6 +132,21 @@ OptimizerLayerSW::run(const RunParams& params) const
 			}
 		}
 
+		if (layer_sw->layer->is_splittable())
+		{
+			bool valid = true;
+			for(Task::List::const_iterator i = layer_sw->sub_tasks.begin(); i != layer_sw->sub_tasks.end(); ++i)
+				if (!*i || !(*i)->valid_target()) valid = false;
+
+			VectorInt size = layer_sw->get_target_rect().get_size();
+			int count = std::min(
+				size[1],
+				std::min( size[0]*size[1]/min_part_pixels_count,
+				          params.renderer.get_max_simultaneous_threads() ));
+			if (valid && count > 1)
+				{ apply(params, split(layer_sw, count)); return; }
+		}
+
 		apply(params, layer_sw);
 	}
 }
@@ -45,10 +45,17 @@ namespace synfig
 namespace rendering
 {
 
+class TaskLayerSW;
+
+//! Specializes TaskLayer for software renderer, large layers which declared
+//! as splittable (see Layer::is_splittable) are rendered by parts in parallel
 class OptimizerLayerSW: public Optimizer
 {
 private:
+	static const int min_part_pixels_count = 128*128;
+
 	static bool renddesc_less(const RendDesc &a, const RendDesc &b);
+	static Task::Handle split(const etl::handle<TaskLayerSW> &layer_sw, int count);
 
 public:
 	OptimizerLayerSW()
@@ -0,0 +1,121 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizerpixelchainsw.cpp
+**	\brief OptimizerPixelChainSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <synfig/real.h>
+
+#include "optimizerpixelchainsw.h"
+
+#include "../task/taskpixelchainsw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	TaskPixelProcessor::Handle get_fusable(const Task::Handle &task)
+	{
+		TaskPixelProcessor::Handle processor = TaskPixelProcessor::Handle::cast_dynamic(task);
+		if ( processor
+		  && processor->target_surface
+		  && processor->valid_target()
+		  && processor->sub_task()
+		  && processor->sub_task()->target_surface
+		  && !processor->is_affects_transparent()
+		  && ( TaskPixelChainSW::Handle::cast_dynamic(processor)
+		    || dynamic_cast<const TaskPixelFunctionSW*>(processor.get()) ))
+			return processor;
+		return TaskPixelProcessor::Handle();
+	}
+
+	void add_processors(Task::List &list, const TaskPixelProcessor::Handle &processor)
+	{
+		if (TaskPixelChainSW::Handle chain = TaskPixelChainSW::Handle::cast_dynamic(processor))
+		{
+			list.insert(list.end(), chain->processors.begin(), chain->processors.end());
+			return;
+		}
+		// only parameters of processor are needed
+		Task::Handle task = processor->clone();
+		task->sub_tasks.clear();
+		list.push_back(task);
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+void
+OptimizerPixelChainSW::run(const RunParams& params) const
+{
+	TaskPixelProcessor::Handle outer = get_fusable(params.ref_task);
+	if (!outer) return;
+	TaskPixelProcessor::Handle inner = get_fusable(outer->sub_task());
+	if (!inner) return;
+
+	// processors should use the same pixels grid
+	Vector outer_ppu = outer->get_pixels_per_unit();
+	Vector inner_ppu = inner->get_pixels_per_unit();
+	if ( !approximate_equal_lp(outer_ppu[0], inner_ppu[0])
+	  || !approximate_equal_lp(outer_ppu[1], inner_ppu[1]) )
+		return;
+
+	TaskPixelChainSW::Handle chain(new TaskPixelChainSW());
+	assign(chain, outer);
+	chain->sub_task() = inner->sub_task();
+	if ( chain->get_offset()
+	  != inner->get_target_offset() + inner->get_offset() + outer->get_offset() )
+		return;
+
+	// outer processor changes only pixels produced by inner one
+	chain->trunc_target_rect(
+		inner->get_target_rect()
+		+ outer->get_target_offset()
+		+ outer->get_offset() );
+
+	add_processors(chain->processors, inner);
+	add_processors(chain->processors, outer);
+
+	apply(params, chain);
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,205 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizersurfacepacksw.cpp
+**	\brief OptimizerSurfacePackSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+
+#include "optimizersurfacepacksw.h"
+
+#include "../surfacesw.h"
+#include "../surfaceswpacked.h"
+#include "../../common/task/tasksurface.h"
+#include "../../common/task/tasksurfaceconvert.h"
+#include "../../common/task/tasksurfacecreate.h"
+#include "../../common/task/tasksurfacedestroy.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	bool insertion_greater(const std::pair<int, Task::Handle> &a, const std::pair<int, Task::Handle> &b)
+		{ return a.first > b.first; }
+}
+
+/* === M E T H O D S ======================================================= */
+
+Task::Handle
+OptimizerSurfacePackSW::create_task(Task *task, const Task::Handle &sample, const Surface::Handle &surface)
+{
+	// task covers whole surface (like as in OptimizerSurfaceCreate)
+	*task = *sample;
+	task->sub_tasks.clear();
+	task->target_surface = surface;
+
+	VectorInt size = surface->get_size();
+	RectInt rect = sample->get_target_rect();
+	Vector lt = sample->get_source_rect_lt();
+	Vector rb = sample->get_source_rect_rb();
+	Vector k( (rb[0] - lt[0])/(rect.maxx - rect.minx),
+			  (rb[1] - lt[1])/(rect.maxy - rect.miny) );
+	Vector nlt( lt[0] - k[0]*rect.minx,
+			    lt[1] - k[1]*rect.miny);
+	Vector nrb( lt[0] + k[0]*(size[0] - rect.minx),
+			    lt[1] + k[1]*(size[1] - rect.miny) );
+	task->init_target_rect(RectInt(VectorInt::zero(), size), nlt, nrb);
+	assert( task->check() );
+	return task;
+}
+
+void
+OptimizerSurfacePackSW::run(const RunParams& params) const
+{
+	// find writers and readers of surfaces,
+	// task depends from all previous tasks which touch the same surfaces
+	// (see Renderer::find_deps), so level of task is greater than levels of them
+	UsageMap usages;
+	for(Task::List::const_iterator i = params.list.begin(); i != params.list.end(); ++i)
+	{
+		if (!*i || !(*i)->valid_target() || i->type_is<TaskSurfaceCreate>())
+			continue;
+
+		int index = i - params.list.begin();
+		Usage &usage = usages[(*i)->target_surface];
+
+		int level = usage.last_level;
+		for(Task::List::const_iterator j = (*i)->sub_tasks.begin(); j != (*i)->sub_tasks.end(); ++j)
+			if (*j && (*j)->target_surface)
+				level = std::max(level, usages[(*j)->target_surface].last_level);
+		++level;
+
+		// don't touch surfaces which already converted or destroyed
+		if (i->type_is<TaskSurfaceConvert>() || i->type_is<TaskSurfaceDestroy>())
+			usage.locked = true;
+
+		++usage.writers;
+		usage.writer = index;
+		usage.writer_level = level;
+		usage.last_level = level;
+
+		for(Task::List::const_iterator j = (*i)->sub_tasks.begin(); j != (*i)->sub_tasks.end(); ++j)
+		{
+			if (!*j || !(*j)->target_surface) continue;
+			Usage &sub_usage = usages[(*j)->target_surface];
+			if ((*j)->target_surface == (*i)->target_surface || sub_usage.writers == 0)
+				sub_usage.locked = true;
+			if (sub_usage.first_reader < 0)
+			{
+				sub_usage.first_reader = index;
+				sub_usage.first_reader_level = level;
+			}
+			sub_usage.last_level = level;
+		}
+	}
+
+	// select surfaces to pack, pack and unpack copy whole surface twice,
+	// so only surfaces which wait for reader during many levels of
+	// parallel execution are worth it, and only when they hold masks
+	// (4 or 1 byte per pixel instead of 16)
+	typedef std::pair<int, Task::Handle> Insertion;
+	std::vector<Insertion> insertions;
+	for(UsageMap::const_iterator i = usages.begin(); i != usages.end(); ++i)
+	{
+		const Surface::Handle &surface = i->first;
+		const Usage &usage = i->second;
+		if ( usage.locked
+		  || usage.writers != 1
+		  || usage.first_reader < 0
+		  || usage.first_reader_level - usage.writer_level <= min_distance
+		  || !surface->is_temporary
+		  || surface->is_created()
+		  || surface->get_pixels_count() < min_pixels_count
+		  || !SurfaceSW::Handle::cast_dynamic(surface) )
+			continue;
+
+		// packing is lossless, precision of writer only
+		// tells which formats are worth to try
+		const Task::Handle &writer = params.list[usage.writer];
+		SurfaceSWPacked::Format format;
+		switch(writer->get_target_precision())
+		{
+		case Task::TARGET_PRECISION_MASK: format = software::PackedPixels::FORMAT_ALPHA8; break;
+		default: continue;
+		}
+
+		SurfaceSWPacked::Handle packed = new SurfaceSWPacked(format);
+		packed->is_temporary = true;
+		packed->set_size(surface->get_size());
+
+		// pack surface after writing, and free the original one
+		TaskSurfaceConvert::Handle pack = new TaskSurfaceConvert();
+		create_task(pack.get(), writer, packed);
+		pack->sub_task() = create_task(new TaskSurface(), writer, surface);
+
+		TaskSurfaceDestroy::Handle destroy = new TaskSurfaceDestroy();
+		create_task(destroy.get(), writer, surface);
+		destroy->sub_task(0) = create_task(new TaskSurface(), writer, packed);
+
+		// unpack surface before first reading
+		TaskSurfaceConvert::Handle unpack = new TaskSurfaceConvert();
+		create_task(unpack.get(), writer, surface);
+		unpack->sub_task() = create_task(new TaskSurface(), writer, packed);
+
+		TaskSurfaceDestroy::Handle destroy_packed = new TaskSurfaceDestroy();
+		create_task(destroy_packed.get(), writer, packed);
+		destroy_packed->sub_task(0) = create_task(new TaskSurface(), writer, surface);
+
+		insertions.push_back(Insertion(usage.first_reader, destroy_packed));
+		insertions.push_back(Insertion(usage.first_reader, unpack));
+		insertions.push_back(Insertion(usage.writer + 1, destroy));
+		insertions.push_back(Insertion(usage.writer + 1, pack));
+	}
+
+	if (insertions.empty())
+		return;
+
+	// insert tasks from the end of list, so indices stay valid,
+	// tasks with same position inserted in reverse order
+	std::stable_sort(insertions.begin(), insertions.end(), insertion_greater);
+	for(std::vector<Insertion>::const_iterator i = insertions.begin(); i != insertions.end(); ++i)
+		params.list.insert(params.list.begin() + i->first, i->second);
+
+	apply(params);
+}
+
+/* === E N T R Y P O I N T ================================================= */
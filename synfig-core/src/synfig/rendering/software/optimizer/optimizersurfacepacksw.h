@@ -0,0 +1,91 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizersurfacepacksw.h
+**	\brief OptimizerSurfacePackSW Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_OPTIMIZERSURFACEPACKSW_H
+#define __SYNFIG_RENDERING_OPTIMIZERSURFACEPACKSW_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <map>
+
+#include "../../optimizer.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Stores long-lived intermediate masks in compact formats (see SurfaceSWPacked)
+//! while they are waiting for their readers
+class OptimizerSurfacePackSW: public Optimizer
+{
+private:
+	//! Positions of tasks are indices in list, levels are depths in graph of
+	//! dependencies, tasks of the same level may run in parallel by RenderQueue
+	struct Usage
+	{
+		int writers;
+		int writer;
+		int writer_level;
+		int first_reader;
+		int first_reader_level;
+		int last_level;
+		bool locked;
+		Usage():
+			writers(), writer(-1), writer_level(),
+			first_reader(-1), first_reader_level(), last_level(), locked() { }
+	};
+
+	typedef std::map<Surface::Handle, Usage> UsageMap;
+
+	static const int min_pixels_count = 64*64;
+	//! pack and unpack cost about 34 bytes of memory traffic per pixel,
+	//! so surface should be long-lived to return it by lower peak of memory
+	static const int min_distance = 4;
+
+	static Task::Handle create_task(Task *task, const Task::Handle &sample, const Surface::Handle &surface);
+
+public:
+	OptimizerSurfacePackSW()
+	{
+		category_id = CATEGORY_ID_LIST;
+		depends_from = CATEGORY_LINEAR;
+		for_list = true;
+	}
+
+	virtual void run(const RunParams &params) const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -0,0 +1,251 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizertransformationsw.cpp
+**	\brief OptimizerTransformationSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "optimizertransformationsw.h"
+
+#include "../surfacesw.h"
+#include "../task/tasktransformationsw.h"
+#include "../../common/task/tasklist.h"
+#include "../../common/task/tasksurface.h"
+#include "../../primitive/affinetransformation.h"
+#include "../../renderer.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+Task::Handle
+OptimizerTransformationSW::split(const TaskTransformationSW::Handle &transformation_sw, int count)
+{
+	TaskList::Handle list = new TaskList();
+	assign(list, Task::Handle(transformation_sw));
+	list->sub_tasks.clear();
+
+	// sub-task will be rendered once by the first part,
+	// and other parts will read the same surface
+	Task::Handle surface = new TaskSurface();
+	assign(surface, transformation_sw->sub_task());
+	surface->sub_tasks.clear();
+
+	// parts are horizontal stripes of the target rect
+	RectInt r = transformation_sw->get_target_rect();
+	int h = r.maxy - r.miny;
+	for(int j = 0; j < count; ++j)
+	{
+		TaskTransformationSW::Handle part = TaskTransformationSW::Handle::cast_dynamic(transformation_sw->clone());
+		if (j) part->sub_task() = surface;
+		part->trunc_target_rect(RectInt(r.minx, r.miny + h*j/count, r.maxx, r.miny + h*(j + 1)/count));
+		list->sub_tasks.push_back(part);
+	}
+
+	return list;
+}
+
+void
+OptimizerTransformationSW::run(const RunParams& params) const
+{
+	TaskTransformation::Handle transformation = TaskTransformation::Handle::cast_dynamic(params.ref_task);
+	if ( transformation
+	  && transformation->target_surface
+	  && transformation->transformation
+	  && !AffineTransformation::Handle::cast_dynamic(transformation->transformation)
+	  && transformation.type_equal<TaskTransformation>() )
+	{
+		TaskTransformationSW::Handle transformation_sw;
+		init_and_assign_all<SurfaceSW>(transformation_sw, transformation);
+
+		// init target of sub-task
+		if (transformation->valid_target_rect()
+		 && transformation->sub_task()
+		 && !transformation->sub_task()->target_surface )
+		{
+			const Real precision = 1e-10;
+			const int border_size = 4;
+			const int max_sub_surface_size = 4096;
+
+			RectInt target = transformation->get_target_rect();
+			Vector src_lt = transformation->get_source_rect_lt();
+			Vector src_rb = transformation->get_source_rect_rb();
+
+			// back-transform nodes of coarse grid over the target
+			int cols = std::min((int)grid_size, target.maxx - target.minx);
+			int rows = std::min((int)grid_size, target.maxy - target.miny);
+			Vector cell_pixels(
+				Real(target.maxx - target.minx)/Real(cols),
+				Real(target.maxy - target.miny)/Real(rows) );
+
+			std::vector<Transformation::TransformedPoint> nodes;
+			nodes.reserve((cols + 1)*(rows + 1));
+			for(int j = 0; j <= rows; ++j)
+				for(int i = 0; i <= cols; ++i)
+					nodes.push_back( transformation->transformation->back_transform( Vector(
+						src_lt[0] + (src_rb[0] - src_lt[0])*Real(i)/Real(cols),
+						src_lt[1] + (src_rb[1] - src_lt[1])*Real(j)/Real(rows) )));
+
+			// calculate source-rect of sub-task and range of depth
+			bool visible = false;
+			Rect sub_src;
+			Real min_depth = 0.0, max_depth = 0.0;
+			for(std::vector<Transformation::TransformedPoint>::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+				if (i->visible)
+				{
+					if (visible)
+					{
+						sub_src.expand(i->p);
+						min_depth = std::min(min_depth, i->depth);
+						max_depth = std::max(max_depth, i->depth);
+					}
+					else
+					{
+						sub_src = Rect(i->p);
+						min_depth = max_depth = i->depth;
+					}
+					visible = true;
+				}
+
+			// calculate size of pixels of sub-task by the most detailed cell
+			Vector max_cell_size;
+			Vector sub_units_per_pixel;
+			for(int j = 0; j < rows; ++j)
+			{
+				for(int i = 0; i < cols; ++i)
+				{
+					const Transformation::TransformedPoint &a = nodes[j*(cols + 1) + i];
+					const Transformation::TransformedPoint &b = nodes[j*(cols + 1) + i + 1];
+					const Transformation::TransformedPoint &c = nodes[(j + 1)*(cols + 1) + i];
+					if (!a.visible || !b.visible || !c.visible)
+						continue;
+
+					Vector dx = b.p - a.p;
+					Vector dy = c.p - a.p;
+					Vector size(
+						std::max(fabs(dx[0]), fabs(dy[0])),
+						std::max(fabs(dx[1]), fabs(dy[1])) );
+					max_cell_size[0] = std::max(max_cell_size[0], size[0]);
+					max_cell_size[1] = std::max(max_cell_size[1], size[1]);
+
+					Vector units_per_pixel(
+						std::max(fabs(dx[0])/cell_pixels[0], fabs(dy[0])/cell_pixels[1]),
+						std::max(fabs(dx[1])/cell_pixels[0], fabs(dy[1])/cell_pixels[1]) );
+					for(int k = 0; k < 2; ++k)
+						if ( units_per_pixel[k] > precision
+						  && (sub_units_per_pixel[k] <= precision || units_per_pixel[k] < sub_units_per_pixel[k]) )
+							sub_units_per_pixel[k] = units_per_pixel[k];
+				}
+			}
+
+			// transformation is not linear inside cells, so source-rect is expanded by the largest cell
+			sub_src.minx -= max_cell_size[0];
+			sub_src.miny -= max_cell_size[1];
+			sub_src.maxx += max_cell_size[0];
+			sub_src.maxy += max_cell_size[1];
+			if (transformation->sub_task()->get_bounds().valid())
+				sub_src &= transformation->sub_task()->get_bounds();
+
+			if ( visible
+			  && sub_src.valid()
+			  && sub_units_per_pixel[0] > precision
+			  && sub_units_per_pixel[1] > precision )
+			{
+				// the most detailed cell may be much smaller than others (near the horizon of Warp),
+				// so size is limited relative to the target, like zoom_factor of legacy Warp
+				const Real zoom_factor = 1.0 + (max_depth - min_depth);
+				const int max_size = std::min( max_sub_surface_size,
+					(int)ceil(Real(std::max(target.maxx - target.minx, target.maxy - target.miny))*zoom_factor - precision) );
+
+				int sub_w = (int)ceil( (sub_src.maxx - sub_src.minx)/sub_units_per_pixel[0] - precision);
+				int sub_h = (int)ceil( (sub_src.maxy - sub_src.miny)/sub_units_per_pixel[1] - precision);
+				if (sub_w > max_size) sub_w = max_size;
+				if (sub_h > max_size) sub_h = max_size;
+				if (sub_w < 1) sub_w = 1;
+				if (sub_h < 1) sub_h = 1;
+
+				// add border
+				Vector border( (sub_src.maxx - sub_src.minx)/Real(sub_w),
+						       (sub_src.maxy - sub_src.miny)/Real(sub_h) );
+				border *= Real(border_size);
+				sub_src.minx -= border[0];
+				sub_src.miny -= border[1];
+				sub_src.maxx += border[0];
+				sub_src.maxy += border[1];
+				sub_w += 2*border_size;
+				sub_h += 2*border_size;
+
+				// set target
+				transformation_sw->sub_task()->target_surface->set_size(sub_w, sub_h);
+				transformation_sw->sub_task()->init_target_rect(RectInt(0, 0, sub_w, sub_h), sub_src.get_min(), sub_src.get_max());
+				assert(transformation_sw->sub_task()->check());
+				transformation_sw->sub_task()->trunc_target_by_bounds();
+			}
+			else
+			{
+				// reset target
+				transformation_sw->sub_task()->target_surface->set_size(0, 0);
+				transformation_sw->sub_task()->clear_target_rect();
+			}
+		}
+
+		if ( transformation_sw->valid_target()
+		  && transformation_sw->sub_task()
+		  && transformation_sw->sub_task()->valid_target() )
+		{
+			VectorInt size = transformation_sw->get_target_rect().get_size();
+			int count = std::min(
+				size[1],
+				std::min( size[0]*size[1]/min_part_pixels_count,
+				          params.renderer.get_max_simultaneous_threads() ));
+			if (count > 1)
+				{ apply(params, split(transformation_sw, count)); return; }
+		}
+
+		apply(params, transformation_sw);
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -61,9 +61,13 @@
 #include "optimizer/optimizerblendsw.h"
 #include "optimizer/optimizerblursw.h"
 #include "optimizer/optimizercontoursw.h"
+#include "optimizer/optimizergradientsw.h"
 #include "optimizer/optimizerlayersw.h"
 #include "optimizer/optimizermeshsw.h"
+#include "optimizer/optimizerpixelchainsw.h"
+#include "optimizer/optimizersurfacepacksw.h"
 #include "optimizer/optimizersurfaceresamplesw.h"
+#include "optimizer/optimizertransformationsw.h"
 
 #include "function/fft.h"
 
@@ -90,8 +94,10 @@ RendererSW::RendererSW()
 	register_optimizer(new OptimizerBlendSW());
 	register_optimizer(new OptimizerBlurSW());
 	register_optimizer(new OptimizerContourSW());
+	register_optimizer(new OptimizerGradientSW());
 	register_optimizer(new OptimizerLayerSW());
 	register_optimizer(new OptimizerSurfaceResampleSW());
+	register_optimizer(new OptimizerTransformationSW());
 
 	register_optimizer(new OptimizerBlendZero());
 	register_optimizer(new OptimizerBlendBlend());
@@ -100,11 +106,13 @@ RendererSW::RendererSW()
 	register_optimizer(new OptimizerBlendAssociative());
 	register_optimizer(new OptimizerBlendSeparate());
 	register_optimizer(new OptimizerBlendSplit());
+	register_optimizer(new OptimizerPixelChainSW());
 	register_optimizer(new OptimizerPixelProcessorSplit());
 	register_optimizer(new OptimizerSurfaceConvert());
 
 	register_optimizer(new OptimizerLinear());
 	register_optimizer(new OptimizerSurfaceCreate());
+	register_optimizer(new OptimizerSurfacePackSW());
 	//register_optimizer(new OptimizerSplit());
 }
 
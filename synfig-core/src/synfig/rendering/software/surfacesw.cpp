@@ -117,6 +117,15 @@ SurfaceSW::set_surface(synfig::Surface &surface, bool own_surface)
 	mark_as_created(this->surface->get_w() > 0 && this->surface->get_h() > 0);
 }
 
+void
+SurfaceSW::update_from_surface()
+{
+	unset_alternative();
+	mark_as_created(false);
+	set_size(surface->get_w(), surface->get_h());
+	mark_as_created(surface->get_w() > 0 && surface->get_h() > 0);
+}
+
 void
 SurfaceSW::reset_surface()
 {
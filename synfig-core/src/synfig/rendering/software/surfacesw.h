@@ -68,6 +68,8 @@ public:
 	bool is_own_surface() const { return own_surface; }
 
 	void set_surface(synfig::Surface &surface, bool own_surface = false);
+	//! Updates size and created flag, when pixels was written directly into get_surface()
+	void update_from_surface();
 	void reset_surface();
 };
 
@@ -0,0 +1,132 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/surfaceswpacked.cpp
+**	\brief SurfaceSWPacked
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <synfig/rendering/software/surfaceswpacked.h>
+#include <synfig/rendering/software/surfacesw.h>
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+SurfaceSWPacked::SurfaceSWPacked(Format desired_format):
+	desired_format(desired_format),
+	format(desired_format),
+	mask_color(Color::alpha())
+{ }
+
+SurfaceSWPacked::SurfaceSWPacked(const Surface &other):
+	desired_format(software::PackedPixels::FORMAT_ALPHA8),
+	format(software::PackedPixels::FORMAT_ALPHA8),
+	mask_color(Color::alpha())
+{
+	assign(other);
+}
+
+SurfaceSWPacked::~SurfaceSWPacked()
+	{ destroy(); }
+
+void
+SurfaceSWPacked::set_desired_format(Format desired_format)
+{
+	assert(!is_created());
+	this->desired_format = desired_format;
+}
+
+bool
+SurfaceSWPacked::create_vfunc()
+{
+	// all formats represents transparent pixel by zeros
+	format = desired_format;
+	mask_color = Color::alpha();
+	data.assign(get_pixels_count()*software::PackedPixels::get_pixel_size(format), 0);
+	return true;
+}
+
+bool
+SurfaceSWPacked::assign_vfunc(const rendering::Surface &surface)
+{
+	const Color *pixels = NULL;
+	std::vector<Color> buffer;
+
+	// read pixels of software surface directly, without extra copying
+	const SurfaceSW *surface_sw = dynamic_cast<const SurfaceSW*>(&surface);
+	if ( surface_sw
+	  && surface_sw->is_created()
+	  && (int)surface_sw->get_surface().get_pitch() == (int)sizeof(Color)*get_width() )
+	{
+		pixels = &surface_sw->get_surface()[0][0];
+	}
+	else
+	{
+		buffer.resize(get_pixels_count());
+		if (!surface.get_pixels(&buffer.front()))
+			return false;
+		pixels = &buffer.front();
+	}
+
+	format = software::PackedPixels::choose_format(
+		desired_format, pixels, get_pixels_count(), mask_color );
+	data.resize(get_pixels_count()*software::PackedPixels::get_pixel_size(format));
+	software::PackedPixels::pack(format, mask_color, &data.front(), pixels, get_pixels_count());
+	return true;
+}
+
+void
+SurfaceSWPacked::destroy_vfunc()
+{
+	std::vector<unsigned char>().swap(data);
+	mask_color = Color::alpha();
+}
+
+bool
+SurfaceSWPacked::get_pixels_vfunc(Color *buffer) const
+{
+	assert(!data.empty());
+	software::PackedPixels::unpack(format, mask_color, buffer, &data.front(), get_pixels_count());
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
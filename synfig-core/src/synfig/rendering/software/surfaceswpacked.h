@@ -0,0 +1,86 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/surfaceswpacked.h
+**	\brief SurfaceSWPacked Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SURFACESWPACKED_H
+#define __SYNFIG_RENDERING_SURFACESWPACKED_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <vector>
+
+#include "../surface.h"
+#include "function/packedpixels.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Software surface which stores pixels in compact format,
+//! see software::PackedPixels::Format
+class SurfaceSWPacked: public Surface
+{
+public:
+	typedef etl::handle<SurfaceSWPacked> Handle;
+	typedef software::PackedPixels::Format Format;
+
+private:
+	Format desired_format;
+	Format format;
+	Color mask_color;
+	std::vector<unsigned char> data;
+
+protected:
+	virtual bool create_vfunc();
+	virtual bool assign_vfunc(const Surface &surface);
+	virtual void destroy_vfunc();
+	virtual bool get_pixels_vfunc(Color *buffer) const;
+
+public:
+	explicit SurfaceSWPacked(Format desired_format = software::PackedPixels::FORMAT_ALPHA8);
+	explicit SurfaceSWPacked(const Surface &other);
+	~SurfaceSWPacked();
+
+	//! Format requested by optimizer, actual format may be less compact
+	//! when pixels cannot be stored in desired format without loss
+	Format get_desired_format() const { return desired_format; }
+	void set_desired_format(Format desired_format);
+
+	Format get_format() const { return format; }
+	const Color& get_mask_color() const { return mask_color; }
+	size_t get_packed_size() const { return data.size(); }
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -0,0 +1,224 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskgradientsw.cpp
+**	\brief TaskGradientSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+#include "taskgradientsw.h"
+
+#include "../surfacesw.h"
+#include "../function/gradienttable.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	// Following functions reproduce color_func() of gradient layers,
+	// but read colors from precomputed table instead of Gradient::operator()
+
+	//! dist should be in range [0, 1], samples crossed the seam are mixed from both sides
+	Color sample_looped(const software::GradientTable &table, Real dist, Real supersample, bool zigzag)
+	{
+		// weights of both sides don't depend on this limit, see also GradientTable::get_premult()
+		supersample = std::min(supersample, 2.0);
+		if (dist + supersample*0.5 > 1.0)
+		{
+			Real left = supersample*0.5 - (dist - 1.0);
+			Real right = supersample*0.5 + (dist - 1.0);
+			Color pool = table.get_premult(1.0 - left*0.5, left)*(left/supersample);
+			pool += table.get_premult(zigzag ? 1.0 - right*0.5 : right*0.5, right)*(right/supersample);
+			return pool.demult_alpha();
+		}
+		if (dist - supersample*0.5 < 0.0)
+		{
+			Real left = supersample*0.5 - dist;
+			Real right = supersample*0.5 + dist;
+			Color pool = table.get_premult(right*0.5, right)*(right/supersample);
+			pool += table.get_premult(zigzag ? left*0.5 : 1.0 - left*0.5, left)*(left/supersample);
+			return pool.demult_alpha();
+		}
+		return table.get(dist, supersample);
+	}
+
+	inline Color sample(const software::GradientTable &table, Real dist, Real supersample, bool loop, bool zigzag)
+	{
+		if (loop)
+			dist -= floor(dist);
+		if (zigzag)
+		{
+			dist *= 2.0;
+			supersample *= 2.0;
+			if (dist > 1.0) dist = 2.0 - dist;
+		}
+		return loop ? sample_looped(table, dist, supersample, zigzag)
+		            : table.get(dist, supersample);
+	}
+
+	//! angle of point in rotations
+	inline Real get_rotations(const Vector &v, Real angle)
+	{
+		Real a = (atan2(-v[1], v[0]) + angle)*(0.5/PI);
+		return a - floor(a);
+	}
+
+	inline void put(Color &dst, const Color &src, bool blend, Color::value_type amount, Color::BlendMethod blend_method)
+		{ dst = blend ? Color::blend(src, dst, amount, blend_method) : src; }
+}
+
+/* === M E T H O D S ======================================================= */
+
+void
+TaskGradientSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+}
+
+bool
+TaskGradientSW::run(RunParams & /* params */) const
+{
+	synfig::Surface &a =
+		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+
+	if (valid_target())
+	{
+		Matrix bounds_transfromation;
+		bounds_transfromation.m00 = get_pixels_per_unit()[0];
+		bounds_transfromation.m11 = get_pixels_per_unit()[1];
+		bounds_transfromation.m20 = -get_source_rect_lt()[0]*bounds_transfromation.m00 + get_target_rect().minx;
+		bounds_transfromation.m21 = -get_source_rect_lt()[1]*bounds_transfromation.m11 + get_target_rect().miny;
+
+		// from pixels into units of gradient
+		Matrix matrix = transformation * bounds_transfromation;
+		if (!matrix.is_invertible())
+			return true;
+		matrix.invert();
+
+		const Vector dx = matrix.get_axis_x();
+		const Vector dy = matrix.get_axis_y();
+		const Real pw = sqrt(fabs(dx[0]*dy[1] - dx[1]*dy[0]));
+		const Real k_radius = fabs(radius) > real_low_precision<Real>() ? 1.0/radius : 0.0;
+		const Real angle_rad = Angle::rad(angle).get();
+
+		// parameter of linear gradient changes by constant step along the row
+		Vector diff = p2 - p1;
+		Real mag_squared = diff.mag_squared();
+		if (mag_squared > 0.0) diff /= mag_squared;
+		const Real linear_supersample = mag_squared > 0.0 ? pw/sqrt(mag_squared) : 2.0;
+		const Real linear_step = dx*diff;
+
+		const software::GradientTable table(gradient);
+		const RectInt r = get_target_rect();
+		const int width = r.maxx - r.minx;
+
+		for(int y = r.miny; y < r.maxy; ++y)
+		{
+			Color *c = &a[y][r.minx];
+			Color *end = c + width;
+			Vector p = matrix.get_transformed(Vector(r.minx + 0.5, y + 0.5)) - p1;
+
+			switch(type)
+			{
+			case TYPE_LINEAR:
+				{
+					Real dist = p*diff;
+					if (approximate_equal(linear_step, 0.0))
+					{
+						const Color color = sample(table, dist, linear_supersample, loop, zigzag);
+						for(; c < end; ++c)
+							put(*c, color, blend, amount, blend_method);
+					}
+					else
+					{
+						for(; c < end; ++c, dist += linear_step)
+							put(*c, sample(table, dist, linear_supersample, loop, zigzag), blend, amount, blend_method);
+					}
+				}
+				break;
+			case TYPE_RADIAL:
+				{
+					const Real supersample = 1.2*pw*fabs(k_radius);
+					for(; c < end; ++c, p += dx)
+						put(*c, sample(table, p.mag()*k_radius, supersample, loop, zigzag), blend, amount, blend_method);
+				}
+				break;
+			case TYPE_CONICAL:
+				{
+					for(; c < end; ++c, p += dx)
+					{
+						Real supersample = fabs(p[0]) < pw*0.5 && fabs(p[1]) < pw*0.5
+						                 ? 0.5 : pw/(p.mag()*2.0*PI);
+						Real dist = get_rotations(p, angle_rad);
+						if (zigzag)
+						{
+							dist *= 2.0;
+							supersample *= 2.0;
+							if (dist > 1.0) dist = 2.0 - dist;
+						}
+						put(*c, sample_looped(table, dist, supersample, false), blend, amount, blend_method);
+					}
+				}
+				break;
+			case TYPE_SPIRAL:
+				{
+					for(; c < end; ++c, p += dx)
+					{
+						const Real mag = p.mag();
+						const Real supersample = std::max(Real(0.00001),
+							Real((1.41421*pw*fabs(k_radius) + 1.41421*pw/(mag*2.0*PI))*0.5) );
+						const Real rotations = get_rotations(p, angle_rad);
+						Real dist = mag*k_radius + (clockwise ? rotations : -rotations);
+						dist -= floor(dist);
+						put(*c, sample_looped(table, dist, supersample, false), blend, amount, blend_method);
+					}
+				}
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -65,20 +65,6 @@ TaskLayerSW::run(RunParams & /* params */) const
 	synfig::Surface &target =
 		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
 
-	Vector upp = get_units_per_pixel();
-	Vector lt = get_source_rect_lt();
-	Vector rb = get_source_rect_rb();
-	lt[0] -= get_target_rect().minx*upp[0];
-	lt[1] -= get_target_rect().miny*upp[1];
-	rb[0] += (target.get_w() - get_target_rect().maxx)*upp[0];
-	rb[1] += (target.get_h() - get_target_rect().maxy)*upp[1];
-
-	RendDesc desc;
-	desc.set_tl(lt);
-	desc.set_br(rb);
-	desc.set_wh(target.get_w(), target.get_h());
-	desc.set_antialias(1);
-
 	etl::handle<Layer_RenderingTask> sub_layer(new Layer_RenderingTask());
 	sub_layer->tasks = sub_tasks;
 
@@ -88,7 +74,33 @@ TaskLayerSW::run(RunParams & /* params */) const
 	fake_canvas_base.push_back(Layer::Handle());
 
 	Context context(fake_canvas_base.begin(), ContextParams());
-	return context.accelerated_render(&target, 4, desc, NULL);
+
+	const RectInt &r = get_target_rect();
+	if (r == RectInt(0, 0, target.get_w(), target.get_h()))
+	{
+		RendDesc desc;
+		desc.set_tl(get_source_rect_lt());
+		desc.set_br(get_source_rect_rb());
+		desc.set_wh(target.get_w(), target.get_h());
+		desc.set_antialias(1);
+		return context.accelerated_render(&target, 4, desc, NULL);
+	}
+
+	// task covers only the part of surface (see OptimizerLayerSW),
+	// other parts may be rendered by other threads at the same time
+	RendDesc desc;
+	desc.set_tl(get_source_rect_lt());
+	desc.set_br(get_source_rect_rb());
+	desc.set_wh(r.maxx - r.minx, r.maxy - r.miny);
+	desc.set_antialias(1);
+
+	synfig::Surface surface;
+	if (!context.accelerated_render(&surface, 4, desc, NULL))
+		return false;
+
+	synfig::Surface::pen p = target.get_pen(r.minx, r.miny);
+	surface.blit_to(p, 0, 0, r.maxx - r.minx, r.maxy - r.miny);
+	return true;
 }
 
 /* === E N T R Y P O I N T ================================================= */
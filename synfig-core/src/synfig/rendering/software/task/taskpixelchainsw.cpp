@@ -0,0 +1,118 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskpixelchainsw.cpp
+**	\brief TaskPixelChainSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+
+#include "taskpixelchainsw.h"
+
+#include "../surfacesw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+void
+TaskPixelChainSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+	if (valid_target() && sub_task() && sub_task()->valid_target())
+	{
+		sub_task() = sub_task()->clone();
+		sub_task()->trunc_target_rect(
+			get_target_rect()
+			- get_target_offset()
+			- get_offset() );
+	}
+}
+
+bool
+TaskPixelChainSW::run(RunParams & /* params */) const
+{
+	std::vector<const TaskPixelFunctionSW*> functions;
+	functions.reserve(processors.size());
+	for(Task::List::const_iterator i = processors.begin(); i != processors.end(); ++i)
+		if (const TaskPixelFunctionSW *function = dynamic_cast<const TaskPixelFunctionSW*>(i->get()))
+			functions.push_back(function);
+	if (functions.empty())
+		return false;
+
+	const synfig::Surface &a =
+		SurfaceSW::Handle::cast_dynamic( sub_task()->target_surface )->get_surface();
+	synfig::Surface &c =
+		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+
+	RectInt r = get_target_rect();
+	if (r.valid())
+	{
+		VectorInt offset = get_offset();
+		RectInt ra = sub_task()->get_target_rect() + r.get_min() + offset;
+		if (ra.valid())
+		{
+			etl::set_intersect(ra, ra, r);
+			if (ra.valid())
+			{
+				for(int y = ra.miny; y < ra.maxy; ++y)
+				{
+					const Color *ca = &a[y - r.miny - offset[1]][ra.minx - r.minx - offset[0]];
+					Color *cc = &c[y][ra.minx];
+					for(int x = ra.minx; x < ra.maxx; x += BLOCK_SIZE, ca += BLOCK_SIZE, cc += BLOCK_SIZE)
+					{
+						// first processor reads sub-task, others work in place
+						int count = std::min((int)BLOCK_SIZE, ra.maxx - x);
+						std::vector<const TaskPixelFunctionSW*>::const_iterator i = functions.begin();
+						(*i)->process_pixels(cc, ca, count);
+						for(++i; i != functions.end(); ++i)
+							(*i)->process_pixels(cc, cc, count);
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
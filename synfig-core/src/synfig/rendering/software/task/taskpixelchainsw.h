@@ -0,0 +1,81 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskpixelchainsw.h
+**	\brief TaskPixelChainSW Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKPIXELCHAINSW_H
+#define __SYNFIG_RENDERING_TASKPIXELCHAINSW_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/color.h>
+
+#include "tasksw.h"
+#include "../../common/task/taskpixelprocessor.h"
+#include "../../common/task/tasksplittable.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Software pixel processor, which result for each pixel depends only on
+//! the same pixel of sub-task. Consecutive processors with this interface
+//! are fused into TaskPixelChainSW by OptimizerPixelChainSW.
+class TaskPixelFunctionSW
+{
+public:
+	//! dst and src may point to the same pixels
+	virtual void process_pixels(Color *dst, const Color *src, int count) const = 0;
+	virtual ~TaskPixelFunctionSW() { }
+};
+
+//! Applies several pixel processors in single pass.
+//! Processors are called block by block, so intermediate colors stay in cache.
+class TaskPixelChainSW: public TaskPixelProcessor, public TaskSW, public TaskSplittable
+{
+public:
+	typedef etl::handle<TaskPixelChainSW> Handle;
+
+	enum { BLOCK_SIZE = 256 };
+
+	//! Processors in order of application, each one should implement TaskPixelFunctionSW,
+	//! sub-tasks of processors are not used
+	Task::List processors;
+
+	Task::Handle clone() const { return clone_pointer(this); }
+	virtual void split(const RectInt &sub_target_rect);
+	virtual bool run(RunParams &params) const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
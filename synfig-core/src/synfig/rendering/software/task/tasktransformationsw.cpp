@@ -0,0 +1,214 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/tasktransformationsw.cpp
+**	\brief TaskTransformationSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tasktransformationsw.h"
+
+#include "../surfacesw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	//! allowed difference between interpolated and exact position, in pixels of sub-task
+	const Real max_error = 0.1;
+
+	struct Node
+	{
+		Vector pos;
+		bool visible;
+		Node(): visible() { }
+	};
+
+	//! Maps pixels of target surface into pixels of surface of sub-task
+	class Mapper
+	{
+	public:
+		const Transformation &transformation;
+		Vector lt, upp;
+		Vector sub_lt, sub_ppu, sub_origin;
+
+		explicit Mapper(const Transformation &transformation):
+			transformation(transformation) { }
+
+		bool map(Real x, Real y, Vector &pos) const
+		{
+			Transformation::TransformedPoint tp = transformation.back_transform(
+				Vector(lt[0] + x*upp[0], lt[1] + y*upp[1]) );
+			pos[0] = (tp.p[0] - sub_lt[0])*sub_ppu[0] + sub_origin[0];
+			pos[1] = (tp.p[1] - sub_lt[1])*sub_ppu[1] + sub_origin[1];
+			return tp.visible;
+		}
+
+		void map_nodes(std::vector<Node> &nodes, Real x, Real y, Real step) const
+		{
+			for(std::vector<Node>::iterator i = nodes.begin(); i != nodes.end(); ++i, x += step)
+				i->visible = map(x, y, i->pos);
+		}
+	};
+
+	inline void put(Color &dst, const synfig::Surface &surface, const Vector &pos, Color::Interpolation interpolation)
+	{
+		// pos is already shifted by half of pixel
+		if ( pos[0] > -1.0 && pos[0] < (Real)surface.get_w()
+		  && pos[1] > -1.0 && pos[1] < (Real)surface.get_h() )
+		{
+			switch(interpolation)
+			{
+			case Color::INTERPOLATION_LINEAR:
+				dst = surface.linear_sample((float)pos[0], (float)pos[1]); break;
+			case Color::INTERPOLATION_COSINE:
+				dst = surface.cosine_sample((float)pos[0], (float)pos[1]); break;
+			case Color::INTERPOLATION_CUBIC:
+				dst = surface.cubic_sample((float)pos[0], (float)pos[1]); break;
+			default:
+				dst = surface[ std::max(0, std::min(surface.get_h() - 1, (int)floor(pos[1] + 0.5))) ]
+				             [ std::max(0, std::min(surface.get_w() - 1, (int)floor(pos[0] + 0.5))) ];
+				break;
+			}
+		}
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+void
+TaskTransformationSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+}
+
+bool
+TaskTransformationSW::run(RunParams & /* params */) const
+{
+	if ( !transformation
+	  || !valid_target()
+	  || !sub_task()
+	  || !sub_task()->valid_target() )
+		return true;
+
+	const synfig::Surface &a =
+		SurfaceSW::Handle::cast_dynamic( sub_task()->target_surface )->get_surface();
+	synfig::Surface &c =
+		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+
+	const RectInt r = get_target_rect();
+
+	Mapper mapper(*transformation);
+	mapper.upp = get_units_per_pixel();
+	mapper.lt = get_source_rect_lt() - Vector(r.minx*mapper.upp[0], r.miny*mapper.upp[1]);
+	mapper.sub_lt = sub_task()->get_source_rect_lt();
+	mapper.sub_ppu = sub_task()->get_pixels_per_unit();
+	mapper.sub_origin = Vector(
+		(Real)sub_task()->get_target_offset()[0] - 0.5,
+		(Real)sub_task()->get_target_offset()[1] - 0.5 );
+
+	// nodes are placed into centers of pixels,
+	// nodes of the last column and row may be outside of target rect
+	const Real step = (Real)GRID_STEP;
+	const Real k_step = 1.0/step;
+	const int cols = (r.maxx - r.minx - 1)/GRID_STEP + 2;
+	const int rows = (r.maxy - r.miny - 1)/GRID_STEP + 2;
+
+	std::vector<Node> top(cols), bottom(cols);
+	std::vector<bool> precise(cols - 1);
+	mapper.map_nodes(top, r.minx + 0.5, r.miny + 0.5, step);
+
+	for(int j = 0; j < rows - 1; ++j)
+	{
+		const int y0 = r.miny + j*GRID_STEP;
+		const int y1 = std::min(y0 + GRID_STEP, r.maxy);
+		mapper.map_nodes(bottom, r.minx + 0.5, y0 + step + 0.5, step);
+
+		// check interpolation in the center of each cell
+		for(int i = 0; i < cols - 1; ++i)
+		{
+			precise[i] = false;
+			if (top[i].visible && top[i+1].visible && bottom[i].visible && bottom[i+1].visible)
+			{
+				Vector pos;
+				Vector interpolated = (top[i].pos + top[i+1].pos + bottom[i].pos + bottom[i+1].pos)*0.25;
+				if ( mapper.map(r.minx + i*step + 0.5*step + 0.5, y0 + 0.5*step + 0.5, pos)
+				  && (pos - interpolated).mag_squared() < max_error*max_error )
+					precise[i] = true;
+			}
+		}
+
+		for(int y = y0; y < y1; ++y)
+		{
+			const Real fy = (y - y0)*k_step;
+			Color *cc = &c[y][r.minx];
+			for(int i = 0; i < cols - 1; ++i)
+			{
+				const int x0 = r.minx + i*GRID_STEP;
+				const int x1 = std::min(x0 + GRID_STEP, r.maxx);
+				if (precise[i])
+				{
+					Vector pos = top[i].pos + (bottom[i].pos - top[i].pos)*fy;
+					Vector right = top[i+1].pos + (bottom[i+1].pos - top[i+1].pos)*fy;
+					Vector dx = (right - pos)*k_step;
+					for(int x = x0; x < x1; ++x, ++cc, pos += dx)
+						put(*cc, a, pos, interpolation);
+				}
+				else
+				{
+					Vector pos;
+					for(int x = x0; x < x1; ++x, ++cc)
+						if (mapper.map(x + 0.5, y + 0.5, pos))
+							put(*cc, a, pos, interpolation);
+				}
+			}
+		}
+
+		top.swap(bottom);
+	}
+
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -31,8 +31,10 @@
 #include <set>
 
 #include <synfig/rect.h>
+#include <synfig/string.h>
 #include <synfig/vector.h>
 
+#include "cancellation.h"
 #include "surface.h"
 
 /* === M A C R O S ========================================================= */
@@ -58,10 +60,30 @@ public:
 	typedef std::vector<Handle> List;
 	typedef std::set<Handle> Set;
 
+	//! Hint about the most compact format which may fit result of task,
+	//! optimizers may use it to pack intermediate surfaces (see OptimizerSurfacePackSW),
+	//! packed format is chosen by actual pixels and never loses precision
+	enum TargetPrecision
+	{
+		TARGET_PRECISION_FULL, //!< float per channel, don't try to pack
+		TARGET_PRECISION_MASK  //!< color may be the same for all pixels
+	};
+
 	struct RunParams {
 		const Renderer *renderer;
 		mutable Task::List sub_queue;
-		explicit RunParams(const Renderer *renderer = NULL): renderer(renderer) { }
+		//! tasks with greater priority are taken from the queue first
+		int priority;
+		Cancellation::Handle cancellation;
+		//! number of rendered frame, used by debug::Profiler
+		int frame;
+		explicit RunParams(
+			const Renderer *renderer = NULL,
+			int priority = 0,
+			const Cancellation::Handle &cancellation = Cancellation::Handle(),
+			int frame = 0
+		):
+			renderer(renderer), priority(priority), cancellation(cancellation), frame(frame) { }
 	};
 
 private:
@@ -89,6 +111,9 @@ public:
 	Surface::Handle target_surface;
 	List sub_tasks;
 
+	//! Name of layer which built this task, filled only while profiling (see debug::Profiler)
+	String source;
+
 	mutable int index;
 	mutable int deps_count;
 	mutable Set back_deps;
@@ -118,6 +143,8 @@ public:
 
 	//! calls from update_bounds()
 	virtual Rect calc_bounds() const { return Rect::infinite(); }
+	//! result of task written into clean surface may fit this precision
+	virtual TargetPrecision get_target_precision() const { return TARGET_PRECISION_FULL; }
 	//! use OptimizerCalcBounds and to avoid multiple calculation of bounds of same task
 	void update_bounds() const { bounds = calc_bounds(); }
 	void update_bounds_recursive() const;
@@ -98,7 +98,10 @@ Target::Target():
 	gamma_(*default_gamma_),
 	alpha_mode(TARGET_ALPHA_MODE_KEEP),
 	avoid_time_sync_(false),
-	curr_frame_(0)
+	curr_frame_(0),
+	priority_(0),
+	cancellation_(new rendering::Cancellation()),
+	rendering_frame_(0)
 {
 }
 
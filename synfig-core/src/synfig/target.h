@@ -42,6 +42,7 @@
 #include "renddesc.h"
 #include "string.h"
 #include "targetparam.h"
+#include "rendering/cancellation.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -187,6 +188,14 @@ public:
 	//! The current frame being rendered
 	int curr_frame_;
 
+	//! Priority of rendering tasks, see rendering::Task::RunParams
+	int priority_;
+	//! Stops rendering tasks when result of the target is not needed anymore
+	rendering::Cancellation::Handle cancellation_;
+
+	//! Number of frame which is rendered now, see rendering::Task::RunParams
+	int rendering_frame_;
+
 protected:
 	//! Default constructor
 	Target();
@@ -197,6 +206,20 @@ public:
 	int get_quality()const { return quality_; }
 	//! Sets the target quality
 	void set_quality(int q) { quality_=q; }
+	//! Gets the priority of rendering tasks
+	int get_priority()const { return priority_; }
+	//! Sets the priority of rendering tasks, tasks with greater priority are rendered first
+	void set_priority(int x) { priority_=x; }
+	//! Gets the cancellation flag shared with rendering tasks
+	const rendering::Cancellation::Handle& get_cancellation()const { return cancellation_; }
+	//! Stops rendering tasks of the target, tasks which are already running will be finished
+	void cancel() { cancellation_->cancel(); }
+	//! Tells whether the target was cancelled
+	bool is_cancelled()const { return cancellation_->is_cancelled(); }
+	//! Gets the number of frame which is rendered now
+	int get_rendering_frame()const { return rendering_frame_; }
+	//! Sets the number of frame which is rendered now, it's passed to rendering tasks
+	void set_rendering_frame(int x) { rendering_frame_=x; }
 	//! Sets the target avoid time synchronization
 	void set_avoid_time_sync(bool x=true) { avoid_time_sync_=x; }
 	//! Gets the target avoid time synchronization
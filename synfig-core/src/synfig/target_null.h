@@ -49,12 +49,12 @@ class Target_Null : public Target_Scanline
 
 public:
 
-	~Target_Null() { delete buffer; }
+	~Target_Null() { delete[] buffer; }
 
 	virtual bool start_frame(ProgressCallback */*cb*/=NULL)
-		{ delete buffer; buffer=new Color[desc.get_w()*sizeof(Color)]; return true; }
+		{ delete[] buffer; buffer=new Color[desc.get_w()]; return true; }
 
-	virtual void end_frame() { delete buffer; buffer=0; return; }
+	virtual void end_frame() { delete[] buffer; buffer=0; return; }
 
 	virtual Color * start_scanline(int /*scanline*/) { return buffer; }
 
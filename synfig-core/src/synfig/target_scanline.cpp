@@ -42,6 +42,8 @@
 #include "string.h"
 #include "surface.h"
 #include "rendering/software/surfacesw.h"
+#include <ETL/misc>
+
 #include "rendering/renderer.h"
 
 #endif
@@ -115,10 +117,10 @@ synfig::Target_Scanline::call_renderer(Context &context, const etl::handle<rende
 
 			rendering::Task::List list;
 			list.push_back(task);
-			renderer->run(list);
+			renderer->run(list, get_priority(), get_cancellation(), get_rendering_frame());
 		}
 	}
-	return true;
+	return !is_cancelled();
 }
 
 bool
@@ -146,6 +148,7 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 	frame_end=desc.get_frame_end();
 
 	ContextParams context_params(desc.get_render_excluded_contexts());
+	context_params.quality=get_quality();
 
 	// Calculate the number of frames
 	total_frames=frame_end-frame_start+1;
@@ -160,6 +163,7 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 		do{
 			// Grab the time
 			frames=next_frame(t);
+			set_rendering_frame(round_to_int((double)t*desc.get_frame_rate()));
 
 			// If we have a callback, and it returns
 			// false, go ahead and bail. (it may be a user cancel)
@@ -175,6 +179,7 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 			if(!get_avoid_time_sync() || canvas->get_time()!=t)
 				canvas->set_time(t);
 			canvas->set_outline_grow(desc.get_outline_grow());
+			canvas->set_pixel_size(desc.get_pixel_size());
 
 	#ifdef SYNFIG_OPTIMIZE_LAYER_TREE
 			Canvas::Handle op_canvas;
@@ -332,6 +337,7 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 		if(!get_avoid_time_sync() || canvas->get_time()!=t)
 			canvas->set_time(t);
 		canvas->set_outline_grow(desc.get_outline_grow());
+		canvas->set_pixel_size(desc.get_pixel_size());
 		Context context;
 
 #ifdef SYNFIG_OPTIMIZE_LAYER_TREE
@@ -35,6 +35,7 @@
 #include <algorithm>
 
 #include <ETL/clock>
+#include <ETL/misc>
 
 #include "target_tile.h"
 
@@ -172,11 +173,11 @@ synfig::Target_Tile::call_renderer(Context &context, const etl::handle<rendering
 				#ifdef DEBUG_MEASURE
 				debug::Measure t("run renderer");
 				#endif
-				renderer->run(list);
+				renderer->run(list, get_priority(), get_cancellation(), get_rendering_frame());
 			}
 		}
 	}
-	return true;
+	return !is_cancelled();
 }
 
 bool
@@ -399,6 +400,7 @@ synfig::Target_Tile::render(ProgressCallback *cb)
 	frame_end=desc.get_frame_end();
 
 	ContextParams context_params(desc.get_render_excluded_contexts());
+	context_params.quality=get_quality();
 
 	// Calculate the number of frames
 	total_frames=frame_end-frame_start+1;
@@ -412,6 +414,7 @@ synfig::Target_Tile::render(ProgressCallback *cb)
 			{		
 				// Grab the time
 				frames=next_frame(t);
+				set_rendering_frame(round_to_int((double)t*desc.get_frame_rate()));
 
 				curr_tile_=0;
 
@@ -432,6 +435,7 @@ synfig::Target_Tile::render(ProgressCallback *cb)
 				// Why the above line was commented here and not in TargetScaline?
 					canvas->set_time(t);
 				canvas->set_outline_grow(desc.get_outline_grow());
+				canvas->set_pixel_size(desc.get_pixel_size());
 
 	#ifdef SYNFIG_OPTIMIZE_LAYER_TREE
 				Canvas::Handle op_canvas;
@@ -465,6 +469,7 @@ synfig::Target_Tile::render(ProgressCallback *cb)
 			//if(!get_avoid_time_sync() || canvas->get_time()!=t)
 				canvas->set_time(t);
 			canvas->set_outline_grow(desc.get_outline_grow());
+			canvas->set_pixel_size(desc.get_pixel_size());
 
 			//synfig::info("2time_set_to %s",t.get_string().c_str());
 
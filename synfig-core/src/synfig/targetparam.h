@@ -45,7 +45,7 @@ struct TargetParam
 	 *  its own valid default settings.
 	 */
 	TargetParam (const std::string& Video_codec = "none", int Bitrate = -1):
-		video_codec(Video_codec), bitrate(Bitrate), sequence_separator("."), offset_x(0), offset_y(0),rows(0),columns(0),append(true),dir(HR)
+		video_codec(Video_codec), bitrate(Bitrate), sequence_separator("."), offset_x(0), offset_y(0),rows(0),columns(0),append(true),dir(HR),page_rows(0)
 	{ }
 
 	std::string video_codec;
@@ -58,6 +58,8 @@ struct TargetParam
 	int columns;
 	bool append;
 	Direction dir;
+	//! Rows of frames in one page of the sheet, 0 means single sheet
+	int page_rows;
 };
 
 }; // END of namespace synfig
@@ -560,6 +560,28 @@ ValueNode::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	calc_values(x);
 }
 
+void
+ValueNode::get_constant_interval(Time t, Time &begin, Time &end) const
+{
+	begin = Time::begin();
+	end = Time::end();
+	get_constant_interval_vfunc(t, begin, end);
+	if (begin > t) begin = t;
+	if (end < t) end = t;
+}
+
+bool
+ValueNode::is_constant(Time a, Time b) const
+{
+	Time begin, end;
+	get_constant_interval(a, begin, end);
+	return begin <= b && b <= end;
+}
+
+void
+ValueNode::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ begin = end = t; }
+
 
 ValueNodeList::ValueNodeList():
 	placeholder_count_(0)
@@ -1009,6 +1031,22 @@ LinkableValueNode::set_root_canvas(etl::loose_handle<Canvas> x)
 		get_link(i)->set_root_canvas(x);
 }
 
+void
+LinkableValueNode::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+{
+	for(int i = 0; i < link_count(); ++i)
+	{
+		if (ValueNode::Handle link = get_link(i))
+		{
+			Time b, e;
+			link->get_constant_interval(t, b, e);
+			if (begin < b) begin = b;
+			if (end > e) end = e;
+			if (begin >= end) break;
+		}
+	}
+}
+
 void
 LinkableValueNode::get_values_vfunc(std::map<Time, ValueBase> &x) const
 {
@@ -271,6 +271,12 @@ public:
 	void get_values(std::map<Time, ValueBase> &x) const;
 
 	void calc_time_bounds(int &begin, int &end, Real &fps) const;
+
+	//! Returns interval [begin, end] around the time \a t where the value is the same as at \a t,
+	//! interval [t, t] means that nothing is known about constancy
+	void get_constant_interval(Time t, Time &begin, Time &end) const;
+	//! Returns \c true if the value is the same at any time between \a a and \a b
+	bool is_constant(Time a, Time b) const;
 	void calc_values(std::map<Time, ValueBase> &x) const;
 	void calc_values(std::map<Time, ValueBase> &x, int begin, int end) const;
 	void calc_values(std::map<Time, ValueBase> &x, int begin, int end, Real fps) const;
@@ -290,6 +296,7 @@ protected:
 	virtual void on_changed();
 
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 }; // END of class ValueNode
 
 
@@ -493,6 +500,10 @@ protected:
 	virtual void set_children_vocab(const Vocab& rvocab);
 
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+
+	//! Intersection of constant intervals of all links.
+	//! Value nodes which use the time in other way should override it.
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 }; // END of class LinkableValueNode
 
 /*!	\class ValueNodeList
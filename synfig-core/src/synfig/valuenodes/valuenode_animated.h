@@ -64,6 +64,7 @@ public:
 
 	virtual ValueBase operator()(Time t) const;
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 
 	virtual Interpolation get_interpolation()const
 		{ return ValueNode_AnimatedInterfaceConst::get_interpolation(); }
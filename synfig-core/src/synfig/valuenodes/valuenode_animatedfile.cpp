@@ -288,6 +288,11 @@ ValueNode_AnimatedFile::get_children_vocab_vfunc() const
 	return ret;
 }
 
+// values are loaded from file
+void
+ValueNode_AnimatedFile::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 void
 ValueNode_AnimatedFile::get_values_vfunc(std::map<Time, ValueBase> &x) const
 {
@@ -75,6 +75,7 @@ public:
 
 	virtual ValueBase operator()(Time t) const;
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 
 	String get_file_field(Time t, const String &field_name) const;
 
@@ -961,6 +961,77 @@ void
 ValueNode_AnimatedInterfaceConst::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{ interpolator_->get_values_vfunc(x); }
 
+static bool
+is_flat_interpolation(Interpolation i)
+{
+	return i == INTERPOLATION_CONSTANT
+		|| i == INTERPOLATION_LINEAR
+		|| i == INTERPOLATION_HALT
+		|| i == INTERPOLATION_CLAMPED;
+}
+
+static bool
+is_constant_waypoint(const Waypoint &w, Time t, Time &begin, Time &end)
+{
+	if (!w.get_value_node()) return false;
+	Time b, e;
+	w.get_value_node()->get_constant_interval(t, b, e);
+	if (begin < b) begin = b;
+	if (end > e) end = e;
+	return begin < end;
+}
+
+static bool
+is_flat_segment(const Waypoint &a, const Waypoint &b, Time t)
+{
+	return is_flat_interpolation(a.get_after())
+		&& is_flat_interpolation(b.get_before())
+		&& a.get_value(t) == b.get_value(t);
+}
+
+void
+ValueNode_AnimatedInterfaceConst::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+{
+	// value is constant before the first waypoint, after the last one,
+	// and between waypoints with equal values when interpolation
+	// doesn't make overshoot between them
+	const WaypointList &list = waypoint_list();
+	if (list.empty())
+		{ begin = end = t; return; }
+
+	WaypointList::const_iterator next = list.begin();
+	while(next != list.end() && next->get_time() <= t) ++next;
+
+	WaypointList::const_iterator first, last;
+	if (next == list.begin())
+		first = last = next;
+	else
+	if (next == list.end())
+		first = last = next - 1;
+	else
+	{
+		first = next - 1;
+		last = next;
+		if (!is_flat_segment(*first, *last, t))
+			{ begin = end = t; return; }
+	}
+
+	// extend interval through the neighbour segments with the same value
+	while(first != list.begin() && is_flat_segment(*(first - 1), *first, t))
+		--first;
+	while(last + 1 != list.end() && is_flat_segment(*last, *(last + 1), t))
+		++last;
+
+	if (first != list.begin() && begin < first->get_time())
+		begin = first->get_time();
+	if (last + 1 != list.end() && end > last->get_time())
+		end = last->get_time();
+
+	for(WaypointList::const_iterator i = first; i != last + 1; ++i)
+		if (!is_constant_waypoint(*i, t, begin, end))
+			{ begin = end = t; return; }
+}
+
 Waypoint
 ValueNode_AnimatedInterfaceConst::new_waypoint_at_time(const Time& time)const
 {
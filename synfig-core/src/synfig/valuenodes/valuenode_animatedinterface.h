@@ -121,6 +121,7 @@ protected:
 	ValueBase operator()(Time t) const;
 	void get_times_vfunc(Node::time_set &set) const;
 	void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 
 	void assign(const ValueNode_AnimatedInterfaceConst &animated, const synfig::GUID& deriv_guid);
 
@@ -36,6 +36,7 @@
 #include <synfig/general.h>
 #include <synfig/localization.h>
 #include <synfig/canvas.h>
+#include <glib.h>
 
 #endif
 
@@ -49,6 +50,9 @@ using namespace synfig;
 
 // #define HIDE_BONE_FIELDS
 
+//! Count of times for which the poses of each bone are cached
+#define POSE_CACHE_SIZE 16
+
 #define GET_NODE_PARENT_NODE(node,t) (*node->get_link("parent"))(t).get(ValueNode_Bone::Handle())
 #define GET_NODE_PARENT(node,t) GET_NODE_PARENT_NODE(node,t)->get_guid()
 #define GET_NODE_NAME(node,t) node->get_bone_name(t)
@@ -65,8 +69,8 @@ using namespace synfig;
 
 static ValueNode_Bone::CanvasMap canvas_map;
 static int bone_counter;
-// static map<ValueNode_Bone::Handle, Matrix> animated_matrix_map;
-static Time last_time = Time::begin();
+//! Incremented on every change of any bone to invalidate the cached poses
+static gint pose_revision_counter = 0;
 
 static ValueNode_Bone_Root::Handle rooot;
 
@@ -221,7 +225,8 @@ ValueNode_Bone::get_ordered_bones(etl::handle<const Canvas> canvas)
 
 // this should only be used when creating the root bone
 ValueNode_Bone::ValueNode_Bone():
-	LinkableValueNode(type_bone_object)
+	LinkableValueNode(type_bone_object),
+	poses_revision(-1)
 {
 	Vocab ret(get_children_vocab());
 	set_children_vocab(ret);
@@ -230,7 +235,8 @@ ValueNode_Bone::ValueNode_Bone():
 }
 
 ValueNode_Bone::ValueNode_Bone(const ValueBase &value, etl::loose_handle<Canvas> canvas):
-	LinkableValueNode(value.get_type())
+	LinkableValueNode(value.get_type()),
+	poses_revision(-1)
 {
 	if (getenv("SYNFIG_DEBUG_BONE_CONSTRUCTORS"))
 	{
@@ -287,6 +293,8 @@ void ValueNode_Bone::on_changed()
 	if (getenv("SYNFIG_DEBUG_ON_CHANGED"))
 		printf("%s:%d ValueNode_Bone::on_changed()\n", __FILE__, __LINE__);
 
+	g_atomic_int_inc(&pose_revision_counter);
+
 	LinkableValueNode::on_changed();
 }
 
@@ -364,35 +372,74 @@ Matrix
 ValueNode_Bone::get_animated_matrix(Time t, Point child_origin)const
 {
 	Real   scalelx	((*scalelx_	)(t).get(Real ()));
-	Real   scalex	((*scalex_	)(t).get(Real ()));
-	Angle  angle	((*angle_	)(t).get(Angle()));
-	Point  origin	((*origin_	)(t).get(Point()));
 
-	return (Matrix().set_translate(child_origin[0]*scalelx, child_origin[1]) *
-			Matrix().set_scale(scalex,1.0) *
-			Matrix().set_rotate(angle) *
-			get_parent(t)->get_animated_matrix(t, origin));
+	ValueNode_Bone::ConstHandle parent;
+	return Matrix().set_translate(child_origin[0]*scalelx, child_origin[1]) *
+		   get_pose(t, parent);
 }
 
 Matrix
-ValueNode_Bone::get_animated_matrix(Time t, Real scalex, Real scaley, Angle angle, Point origin, ValueNode_Bone::ConstHandle parent)const
+ValueNode_Bone::get_pose(Time t, ValueNode_Bone::ConstHandle &out_parent)const
 {
-	Matrix parent_matrix(parent->get_animated_matrix(t, origin));
-	Matrix ret(Matrix().set_scale(scalex,scaley) *
-			   Matrix().set_rotate(angle) *
-			   parent_matrix);
+	int revision = g_atomic_int_get(&pose_revision_counter);
+	{
+		Mutex::Lock lock(poses_mutex);
+		if (poses_revision != revision)
+		{
+			poses.clear();
+			poses_revision = revision;
+		}
+		PoseMap::const_iterator i = poses.find(t);
+		if (i != poses.end())
+		{
+			out_parent = i->second.parent;
+			return i->second.matrix;
+		}
+	}
+
+	// evaluate without lock, the parent evaluates (and caches) its pose first,
+	// get_parent() never returns bones from the loops, so recursion is finite
+	Real   scalex	((*scalex_	)(t).get(Real ()));
+	Angle  angle	((*angle_	)(t).get(Angle()));
+	Point  origin	((*origin_	)(t).get(Point()));
+
+	Pose pose;
+	pose.parent = get_parent(t);
+	Matrix parent_matrix(pose.parent->get_animated_matrix(t, origin));
+	pose.matrix = Matrix().set_scale(scalex,1.0) *
+				  Matrix().set_rotate(angle) *
+				  parent_matrix;
 
 	if (getenv("SYNFIG_DEBUG_ANIMATED_MATRIX_CALCULATION"))
 	{
-		printf("%s  *\n", Matrix().set_scale(scalex, scaley).get_string(18, "animated_matrix = ",
-																		strprintf("scale(%7.2f, %7.2f) (%s)", scalex, scaley,
+		printf("%s  *\n", Matrix().set_scale(scalex, 1.0).get_string(18, "animated_matrix = ",
+																		strprintf("scale(%7.2f, %7.2f) (%s)", scalex, 1.0,
 																				  get_bone_name(t).c_str())).c_str());
 		printf("%s  *\n", Matrix().set_rotate(angle).get_string(18, "", strprintf("rotate(%.2f)", Angle::deg(angle).get())).c_str());
 		printf("%s  =\n", parent_matrix.get_string(18, "", "parent").c_str());
-		printf("%s\n",	  ret.get_string(18).c_str());
+		printf("%s\n",	  pose.matrix.get_string(18).c_str());
 	}
 
-	return ret;
+	{
+		// bones may be changed while evaluating, then pose is not stored
+		Mutex::Lock lock(poses_mutex);
+		if (poses_revision == revision)
+		{
+			if (poses.size() >= (size_t)POSE_CACHE_SIZE)
+			{
+				// forget the pose farthest from the current time
+				PoseMap::iterator last = poses.end(); --last;
+				if (t - poses.begin()->first > last->first - t)
+					poses.erase(poses.begin());
+				else
+					poses.erase(last);
+			}
+			poses.insert(PoseMap::value_type(t, pose));
+		}
+	}
+
+	out_parent = pose.parent;
+	return pose.matrix;
 }
 
 ValueNode_Bone::ConstHandle
@@ -406,7 +453,6 @@ ValueNode_Bone::get_parent(Time t)const
 			synfig::error("A bone cannot be parent of itself or any of its descendants");
 		else
 			synfig::error("A loop was detected in the ancestry at bone %s", GET_NODE_DESC_CSTR(result,t));
-		printf("%s:%d root 1\n", __FILE__, __LINE__);
 		return get_root_bone();
 	}
 
@@ -428,7 +474,10 @@ ValueNode_Bone::operator()(Time t)const
 //	show_bone_map(get_root_canvas(), __FILE__, __LINE__, strprintf("in op() at %s", t.get_string().c_str()), t);
 
 	String bone_name			((*name_	)(t).get(String()));
-	ValueNode_Bone::ConstHandle   bone_parent			(get_parent(t));
+	ValueNode_Bone::ConstHandle   bone_parent;
+	if (getenv("SYNFIG_DEBUG_ANIMATED_MATRIX_CALCULATION")) printf("\n***\n*** %s:%d get_animated_matrix() for %s\n***\n\n", __FILE__, __LINE__, get_bone_name(t).c_str());
+	Matrix bone_animated_matrix	(get_pose(t, bone_parent));
+	if (getenv("SYNFIG_DEBUG_ANIMATED_MATRIX_CALCULATION")) printf("\n***\n*** %s:%d get_animated_matrix() for %s done\n***\n\n", __FILE__, __LINE__, get_bone_name(t).c_str());
 #ifndef HIDE_BONE_FIELDS
 	Point  bone_origin			((*origin_	)(t).get(Point()));
 	Angle  bone_angle			((*angle_	)(t).get(Angle()));
@@ -438,9 +487,6 @@ ValueNode_Bone::operator()(Time t)const
 	Real   bone_width			((*width_	)(t).get(Real()));
 	Real   bone_tipwidth		((*tipwidth_)(t).get(Real()));
 	Real   bone_depth			((*depth_)(t).get(Real()));
-	if (getenv("SYNFIG_DEBUG_ANIMATED_MATRIX_CALCULATION")) printf("\n***\n*** %s:%d get_animated_matrix() for %s\n***\n\n", __FILE__, __LINE__, get_bone_name(t).c_str());
-	Matrix bone_animated_matrix	(get_animated_matrix(t, bone_scalex, 1.0, bone_angle, bone_origin, bone_parent));
-	if (getenv("SYNFIG_DEBUG_ANIMATED_MATRIX_CALCULATION")) printf("\n***\n*** %s:%d get_animated_matrix() for %s done\n***\n\n", __FILE__, __LINE__, get_bone_name(t).c_str());
 #endif
 
 	Bone ret;
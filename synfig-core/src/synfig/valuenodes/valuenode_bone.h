@@ -28,6 +28,9 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <map>
+
+#include <synfig/mutex.h>
 #include <synfig/valuenode.h>
 
 /* === M A C R O S ========================================================= */
@@ -49,6 +52,20 @@ class ValueNode_Bone : public LinkableValueNode
 	ValueNode::RHandle depth_;
 	ValueNode::RHandle parent_;
 
+	//! Parent and animated matrix of the bone at some time, see get_pose()
+	struct Pose
+	{
+		etl::handle<const ValueNode_Bone> parent;
+		Matrix matrix;
+	};
+	typedef std::map<Time, Pose> PoseMap;
+
+	//! Cached poses, entries are not changed after insertion
+	mutable PoseMap poses;
+	//! Revision of bones for which the poses are cached
+	mutable int poses_revision;
+	mutable Mutex poses_mutex;
+
 protected:
 	ValueNode_Bone();
 	ValueNode_Bone(const ValueBase &value, etl::loose_handle<Canvas> canvas = 0);
@@ -127,7 +144,10 @@ public:
 
 private:
 	virtual Matrix get_animated_matrix(Time t, Point child_origin)const;
-	Matrix get_animated_matrix(Time t, Real scalex, Real scaley, Angle angle, Point origin, ValueNode_Bone::ConstHandle parent)const;
+	//! Returns the animated matrix and the parent of the bone at time \a t.
+	//! The pose is evaluated once per time (ancestors first) and shared by
+	//! all users of the bone until any bone is changed.
+	Matrix get_pose(Time t, ValueNode_Bone::ConstHandle &out_parent)const;
 	ValueNode_Bone::ConstHandle get_parent(Time t)const;
 
 }; // END of class ValueNode_Bone
@@ -184,3 +184,27 @@ void ValueNode_Const::get_values_vfunc(std::map<Time, ValueBase> &x) const
 {
 	add_value_to_map(x, 0, value);
 }
+
+void ValueNode_Const::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+{
+	// bones are evaluated by the users of value at their own time
+	Type &type = value.get_type();
+	if (type == type_bone_valuenode)
+	{
+		if (ValueNode_Bone::Handle bone = value.get(ValueNode_Bone::Handle()))
+			bone->get_constant_interval(t, begin, end);
+		return;
+	}
+	if (type == type_bone_weight_pair)
+	{
+		ValueNode::get_constant_interval_vfunc(t, begin, end);
+		return;
+	}
+	if (type == type_list)
+	{
+		const ValueBase::List &list = value.get_list();
+		for(ValueBase::List::const_iterator i = list.begin(); i != list.end(); ++i)
+			if (i->get_type() == type_bone_valuenode || i->get_type() == type_bone_weight_pair)
+				{ ValueNode::get_constant_interval_vfunc(t, begin, end); return; }
+	}
+}
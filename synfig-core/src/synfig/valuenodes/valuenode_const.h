@@ -75,6 +75,7 @@ public:
 protected:
 	virtual void get_times_vfunc(Node::time_set &set) const;
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 };
 
 }; // END of namespace synfig
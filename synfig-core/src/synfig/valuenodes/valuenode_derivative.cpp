@@ -357,6 +357,11 @@ ValueNode_Derivative::get_link_vfunc(int i)const
 	}
 }
 
+// value depends on values at other times
+void
+ValueNode_Derivative::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_Derivative::get_children_vocab_vfunc()const
 {
@@ -183,6 +183,11 @@ ValueNode_Duplicate::check_type(Type &type __attribute__ ((unused)))
 	return false;
 }
 
+// value is changed by Layer_Duplicate at the same time
+void
+ValueNode_Duplicate::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_Duplicate::get_children_vocab_vfunc()const
 {
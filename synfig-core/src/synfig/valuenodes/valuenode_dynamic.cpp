@@ -227,6 +227,11 @@ ValueNode_Dynamic::get_link_vfunc(int i)const
 	}
 }
 
+// simulation changes value on every step of time
+void
+ValueNode_Dynamic::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_Dynamic::get_children_vocab_vfunc()const
 {
@@ -964,6 +964,16 @@ ValueNode_DynamicList::insert_time(const Time& location, const Time& delta)
 	changed();
 }
 
+void
+ValueNode_DynamicList::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+{
+	// activepoints switch entries on and off by time
+	for(std::vector<ListEntry>::const_iterator i = list.begin(); i != list.end(); ++i)
+		if (!i->timing_info.empty())
+			{ ValueNode::get_constant_interval_vfunc(t, begin, end); return; }
+	LinkableValueNode::get_constant_interval_vfunc(t, begin, end);
+}
+
 LinkableValueNode::Vocab
 ValueNode_DynamicList::get_children_vocab_vfunc()const
 {
@@ -226,6 +226,7 @@ public:
 protected:
 
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x);
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 	LinkableValueNode* create_new()const;
 
 	virtual void get_times_vfunc(Node::time_set &set) const;
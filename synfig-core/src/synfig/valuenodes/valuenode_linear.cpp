@@ -190,6 +190,25 @@ ValueNode_Linear::get_link_vfunc(int i)const
 	return 0;
 }
 
+void
+ValueNode_Linear::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+{
+	// constant only while the rate is zero
+	ValueBase rate = (*m_)(t);
+	Type &type(rate.get_type());
+	bool zero = type == type_angle   ? Angle::rad(rate.get(Angle())).get() == 0.0
+	          : type == type_color   ? rate.get(Color()) == Color(0.0, 0.0, 0.0, 0.0)
+	          : type == type_integer ? rate.get(int()) == 0
+	          : type == type_real    ? rate.get(Real()) == 0.0
+	          : type == type_time    ? (double)rate.get(Time()) == 0.0
+	          : type == type_vector  ? rate.get(Vector())[0] == 0.0 && rate.get(Vector())[1] == 0.0
+	          : false;
+	if (zero)
+		LinkableValueNode::get_constant_interval_vfunc(t, begin, end);
+	else
+		ValueNode::get_constant_interval_vfunc(t, begin, end);
+}
+
 LinkableValueNode::Vocab
 ValueNode_Linear::get_children_vocab_vfunc()const
 {
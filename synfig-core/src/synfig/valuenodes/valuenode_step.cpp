@@ -181,6 +181,11 @@ ValueNode_Step::get_link_vfunc(int i)const
 	}
 }
 
+// time is quantized by steps, so value changes by itself
+void
+ValueNode_Step::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_Step::get_children_vocab_vfunc()const
 {
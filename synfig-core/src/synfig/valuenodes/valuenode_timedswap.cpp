@@ -246,6 +246,11 @@ ValueNode_TimedSwap::check_type(Type &type)
 		type==type_vector;
 }
 
+// value depends on time of swap
+void
+ValueNode_TimedSwap::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_TimedSwap::get_children_vocab_vfunc()const
 {
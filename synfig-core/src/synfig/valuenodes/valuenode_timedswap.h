@@ -67,6 +67,7 @@ public:
 //	static bool check_type(Type &type);
 
 protected:
+	virtual void get_constant_interval_vfunc(Time t, Time &begin, Time &end) const;
 
 	virtual LinkableValueNode* create_new()const;
 
@@ -163,6 +163,11 @@ ValueNode_TimeLoop::check_type(Type &type)
 }
 
 
+// links are evaluated at other times
+void
+ValueNode_TimeLoop::get_constant_interval_vfunc(Time t, Time &begin, Time &end) const
+	{ ValueNode::get_constant_interval_vfunc(t, begin, end); }
+
 LinkableValueNode::Vocab
 ValueNode_TimeLoop::get_children_vocab_vfunc()const
 {
@@ -101,3 +101,13 @@ void SynfigToolGeneralOptions::set_should_print_benchmarks(bool print_benchmarks
 {
 	_should_print_benchmarks = print_benchmarks;
 }
+
+const std::string& SynfigToolGeneralOptions::get_profile_filename() const
+{
+	return _profile_filename;
+}
+
+void SynfigToolGeneralOptions::set_profile_filename(const std::string& filename)
+{
+	_profile_filename = filename;
+}
@@ -102,6 +102,10 @@ public:
 
 	void set_should_print_benchmarks(bool print_benchmarks);
 
+	const std::string& get_profile_filename() const;
+
+	void set_profile_filename(const std::string& filename);
+
 private:
 	SynfigToolGeneralOptions(const char* argv0);
 
@@ -110,6 +114,7 @@ private:
 	size_t _threads;
 	bool _should_be_quiet,
 		 _should_print_benchmarks;
+	std::string _profile_filename;
 
 	static boost::shared_ptr<SynfigToolGeneralOptions> _instance;
 };
@@ -44,6 +44,13 @@ struct Job
 	bool list_canvases;
 	bool extract_alpha;
 
+	// render farm options, see jobsharding.h
+	int shard_index;
+	int shard_count;      //!< zero when sharding is disabled
+	bool shard_merge;     //!< merge results of all shards instead of rendering
+	int shard_workers;    //!< count of local worker processes to launch
+	std::string spool_dir;
+
 	bool
 		canvas_info,
 		canvas_info_all,
@@ -79,6 +86,10 @@ struct Job
 		sifout(false),
 		list_canvases(),
 		extract_alpha(false),
+		shard_index(),
+		shard_count(),
+		shard_merge(false),
+		shard_workers(),
 		canvas_info(),
 		canvas_info_all(),
 		canvas_info_time_start(),
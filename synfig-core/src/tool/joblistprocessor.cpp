@@ -62,6 +62,7 @@
 #include "printing_functions.h"
 #include "renderprogress.h"
 #include "joblistprocessor.h"
+#include "jobsharding.h"
 
 #endif
 
@@ -75,12 +76,15 @@ void process_job_list(std::list<Job>& job_list, const TargetParam& target_params
 
 	for(; job_list.size(); job_list.pop_front())
 	{
+		if (job_list.front().shard_count)
+			process_job_shards(job_list.front(), target_params);
+		else
 		if (setup_job(job_list.front(), target_params))
 			process_job(job_list.front());
 	}
 }
 
-bool setup_job(Job& job, const TargetParam& target_parameters)
+void setup_job_output(Job& job)
 {
 	VERBOSE_OUT(4) << _("Attempting to determine target/outfile...") << std::endl;
 
@@ -138,6 +142,11 @@ bool setup_job(Job& job, const TargetParam& target_parameters)
 
 	VERBOSE_OUT(4) << "Target name = " << job.target_name.c_str() << std::endl;
 	VERBOSE_OUT(4) << "Outfilename = " << job.outfilename.c_str() << std::endl;
+}
+
+bool setup_job(Job& job, const TargetParam& target_parameters)
+{
+	setup_job_output(job);
 
 	// Check permissions
 	if (access(bfs::canonical(bfs::path(job.outfilename).parent_path()).string().c_str(), W_OK) == -1)
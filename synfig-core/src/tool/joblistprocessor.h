@@ -33,6 +33,9 @@
 void process_job_list(std::list<Job>& job_list,
 						const synfig::TargetParam& target_parameters);
 
+/// Determine the target name and the output filename of a job
+void setup_job_output(Job& job);
+
 /// Prepare a job to be processed
 /// \return whether the preparation was OK or not
 bool setup_job(Job& job, const synfig::TargetParam& target_parameters);
@@ -0,0 +1,346 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file tool/jobsharding.cpp
+**	\brief Splitting of rendering jobs between processes
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+#include <glibmm.h>
+#include <glibmm/threads.h>
+
+#include <ETL/stringf>
+
+#include <synfig/general.h>
+#include <synfig/localization.h>
+#include <synfig/canvas.h>
+#include <synfig/target.h>
+#include <synfig/target_scanline.h>
+#include <synfig/importer.h>
+#include <synfig/surface.h>
+#include <synfig/filesystemnative.h>
+
+#include "definitions.h"
+#include "job.h"
+#include "synfigtoolexception.h"
+#include "renderprogress.h"
+#include "joblistprocessor.h"
+#include "jobsharding.h"
+
+#endif
+
+using namespace synfig;
+namespace bfs=boost::filesystem;
+
+namespace {
+
+// targets which write every frame into a separate numbered file,
+// so shards may write their frames directly into the destination
+bool is_sequence_target(const std::string &name)
+{
+	return name == "png"
+		|| name == "cairo_png"
+		|| name == "jpeg"
+		|| name == "bmp"
+		|| name == "ppm"
+		|| name == "openexr";
+}
+
+// targets which are assembled from png frames rendered by shards
+bool is_spritesheet_target(const std::string &name)
+	{ return name == "png-spritesheet"; }
+
+void get_frame_range(const RendDesc &desc, int &begin, int &end)
+{
+	begin = desc.get_frame_start();
+	end = std::max(begin, desc.get_frame_end());
+}
+
+void get_shard_range(const Job &job, int index, int &begin, int &end)
+{
+	int first, last;
+	get_frame_range(job.desc, first, last);
+	long long count = last - first + 1;
+	begin = first + (int)(count*index/job.shard_count);
+	end   = first + (int)(count*(index + 1)/job.shard_count) - 1;
+}
+
+std::string get_spool_dir(const Job &job)
+	{ return job.spool_dir.empty() ? job.outfilename + ".spool" : job.spool_dir; }
+
+std::string get_progress_filename(const Job &job, int index)
+{
+	std::string name = bfs::path(job.outfilename).filename().string()
+		             + etl::strprintf(".shard-%d-of-%d.done", index, job.shard_count);
+	return (bfs::path(get_spool_dir(job)) / name).string();
+}
+
+// same naming as image targets use for sequences
+std::string get_frame_filename(const Job &job, const TargetParam &params, int frame)
+{
+	std::string filename = job.outfilename;
+	if (is_spritesheet_target(job.target_name))
+		filename = (bfs::path(get_spool_dir(job)) / (bfs::path(job.outfilename).stem().string() + ".png")).string();
+	return etl::filename_sans_extension(filename)
+		 + params.sequence_separator
+		 + etl::strprintf("%04d", frame)
+		 + etl::filename_extension(filename);
+}
+
+std::set<int> read_progress(const std::string &filename)
+{
+	std::set<int> frames;
+	std::ifstream stream(filename.c_str());
+	std::string line;
+	while(std::getline(stream, line))
+	{
+		// last line without line break may be written partially
+		if (stream.eof()) break;
+		if (!line.empty()) frames.insert(atoi(line.c_str()));
+	}
+	return frames;
+}
+
+void render_shard(Job& job, const TargetParam& target_parameters)
+{
+	int begin, end;
+	get_shard_range(job, job.shard_index, begin, end);
+	if (end < begin)
+	{
+		VERBOSE_OUT(1) << _("No frames in this shard.") << std::endl;
+		return;
+	}
+
+	bfs::create_directories(get_spool_dir(job));
+
+	std::string progress_filename = get_progress_filename(job, job.shard_index);
+	std::set<int> done = read_progress(progress_filename);
+	std::ofstream progress(progress_filename.c_str(), std::ios::app);
+	if (!progress)
+		throw SynfigToolException(SYNFIGTOOL_INVALIDOUTPUT,
+				(boost::format(_("Unable to write progress file \"%s\".")) % progress_filename).str());
+
+	std::string frame_target = is_spritesheet_target(job.target_name) ? "png" : job.target_name;
+
+	RenderProgress p;
+	for(int frame = begin; frame <= end; ++frame)
+	{
+		std::string filename = get_frame_filename(job, target_parameters, frame);
+		if (done.count(frame) && bfs::exists(filename))
+		{
+			VERBOSE_OUT(2) << (boost::format(_("Frame %d is already rendered.")) % frame).str() << std::endl;
+			continue;
+		}
+
+		// unfinished file should never look like the rendered frame
+		std::string part_filename = etl::filename_sans_extension(filename)
+								  + ".part" + etl::filename_extension(filename);
+
+		RendDesc desc = job.desc;
+		if (desc.get_frame_rate() > 0)
+			desc.set_frame_start(frame).set_frame_end(frame);
+		job.canvas->rend_desc() = desc;
+
+		Target::Handle target = Target::create(frame_target, part_filename, target_parameters);
+		if (!target)
+			throw SynfigToolException(SYNFIGTOOL_INVALIDTARGET,
+					(boost::format(_("Unknown target \"%s\".")) % frame_target).str());
+		target->set_canvas(job.canvas);
+		target->set_quality(job.quality);
+		if (job.alpha_mode != TARGET_ALPHA_MODE_KEEP)
+			target->set_alpha_mode(job.alpha_mode);
+		if (Target_Scanline::Handle::cast_dynamic(target))
+			Target_Scanline::Handle::cast_dynamic(target)->set_threads(SynfigToolGeneralOptions::instance()->get_threads());
+
+		p.task(job.filename + " ==> " + filename);
+		if (!target->render(&p))
+			throw SynfigToolException(SYNFIGTOOL_RENDERFAILURE, _("Render Failure."));
+		target.reset(); // target closes the file
+
+		bfs::rename(part_filename, filename);
+		progress << frame << std::endl;
+	}
+
+	job.canvas->rend_desc() = job.desc;
+}
+
+void merge_shards(Job& job, const TargetParam& target_parameters)
+{
+	int begin, end;
+	get_frame_range(job.desc, begin, end);
+
+	bool complete = true;
+	for(int i = 0; i < job.shard_count; ++i)
+	{
+		int shard_begin, shard_end, missing = 0;
+		get_shard_range(job, i, shard_begin, shard_end);
+		for(int frame = shard_begin; frame <= shard_end; ++frame)
+			if (!bfs::exists(get_frame_filename(job, target_parameters, frame)))
+				++missing;
+		if (missing)
+		{
+			synfig::error("Shard %d/%d: %d of %d frames are not rendered",
+				i, job.shard_count, missing, shard_end - shard_begin + 1);
+			complete = false;
+		}
+	}
+	if (!complete)
+		throw SynfigToolException(SYNFIGTOOL_RENDERFAILURE, _("Unable to merge incomplete shards."));
+
+	if (is_spritesheet_target(job.target_name))
+	{
+		// alpha mode is already applied to the frames
+		job.alpha_mode = TARGET_ALPHA_MODE_KEEP;
+		if (!setup_job(job, target_parameters))
+			throw SynfigToolException(SYNFIGTOOL_INVALIDOUTPUT, _("Unable to create output for merged shards."));
+
+		Target_Scanline::Handle target = Target_Scanline::Handle::cast_dynamic(job.target);
+		if (!target || !target->init())
+			throw SynfigToolException(SYNFIGTOOL_INVALIDTARGET, _("Target initialization failure"));
+
+		VERBOSE_OUT(1) << _("Merging shards...") << std::endl;
+		for(int frame = begin; frame <= end; ++frame)
+		{
+			std::string filename = get_frame_filename(job, target_parameters, frame);
+			Importer::Handle importer = Importer::open(FileSystemNative::instance()->get_identifier(filename));
+			Surface surface;
+			if ( !importer
+			  || !importer->get_frame(surface, job.desc, Time(0))
+			  || surface.get_w() != job.desc.get_w()
+			  || surface.get_h() != job.desc.get_h() )
+				throw SynfigToolException(SYNFIGTOOL_RENDERFAILURE,
+						(boost::format(_("Unable to read rendered frame \"%s\".")) % filename).str());
+			target->add_frame(&surface);
+		}
+
+		// spritesheet is written when target destroyed
+		target.reset();
+		job.target.reset();
+
+		for(int frame = begin; frame <= end; ++frame)
+			bfs::remove(get_frame_filename(job, target_parameters, frame));
+	}
+
+	boost::system::error_code ec;
+	for(int i = 0; i < job.shard_count; ++i)
+		bfs::remove(get_progress_filename(job, i), ec);
+	bfs::remove(get_spool_dir(job), ec); // removed only when it's empty
+
+	VERBOSE_OUT(1) << _("Done.") << std::endl;
+}
+
+class ShardWorker
+{
+public:
+	std::vector<std::string> args;
+	int exit_status;
+	bool started;
+
+	ShardWorker(): exit_status(-1), started(false) { }
+
+	void run()
+	{
+		try
+		{
+			Glib::spawn_sync("", args, Glib::SpawnFlags(0), sigc::slot<void>(), NULL, NULL, &exit_status);
+			started = true;
+		}
+		catch(Glib::Error &e)
+		{
+			synfig::error("Unable to start worker: %s", e.what().c_str());
+		}
+	}
+};
+
+} // end of anonymous namespace
+
+void process_job_shards(Job& job, const TargetParam& target_parameters)
+{
+	setup_job_output(job);
+
+	if (!is_sequence_target(job.target_name) && !is_spritesheet_target(job.target_name))
+		throw SynfigToolException(SYNFIGTOOL_INVALIDTARGET,
+				(boost::format(_("Target \"%s\" can not be rendered in shards, use an image sequence or png-spritesheet target."))
+							   % job.target_name).str());
+	if (job.outfilename == "-")
+		throw SynfigToolException(SYNFIGTOOL_INVALIDOUTPUT, _("Shards can not be rendered to standard output."));
+
+	if (job.shard_merge)
+		merge_shards(job, target_parameters);
+	else
+		render_shard(job, target_parameters);
+}
+
+void run_shard_workers(int count, int argc, char* argv[])
+{
+	// workers get the same arguments except the coordinator option
+	std::vector<std::string> args;
+	args.push_back(SynfigToolGeneralOptions::instance()->get_binary_path().string());
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--shard-workers") { ++i; continue; }
+		if (arg.compare(0, 16, "--shard-workers=") == 0) continue;
+		args.push_back(arg);
+	}
+
+	std::vector<ShardWorker> workers(count);
+	std::vector<Glib::Threads::Thread*> threads;
+	for(int i = 0; i < count; ++i)
+	{
+		workers[i].args = args;
+		workers[i].args.push_back("--shard");
+		workers[i].args.push_back(etl::strprintf("%d/%d", i, count));
+		threads.push_back(Glib::Threads::Thread::create(
+			sigc::mem_fun(workers[i], &ShardWorker::run) ));
+	}
+
+	VERBOSE_OUT(1) << (boost::format(_("Started %d workers")) % count).str() << std::endl;
+
+	bool failed = false;
+	for(int i = 0; i < count; ++i)
+	{
+		threads[i]->join();
+		if (!workers[i].started || workers[i].exit_status != 0)
+		{
+			synfig::error("Worker of shard %d/%d failed", i, count);
+			failed = true;
+		}
+	}
+
+	if (failed)
+		throw SynfigToolException(SYNFIGTOOL_RENDERFAILURE,
+				_("Some shards are not rendered, run the same command again to resume."));
+}
@@ -0,0 +1,41 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file tool/jobsharding.h
+**	\brief Splitting of rendering jobs between processes
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+#ifndef __SYNFIG_JOBSHARDING_H
+#define __SYNFIG_JOBSHARDING_H
+
+#include <synfig/targetparam.h>
+#include "job.h"
+
+/// Render the shard of a job (job.shard_index of job.shard_count),
+/// or merge results of all shards if job.shard_merge is set.
+/// Frame range of the job is split into contiguous parts, one per shard.
+/// Every frame is rendered into a separate file and then noted in
+/// the progress file of the shard in the spool directory, so
+/// a restarted shard continues from the first unfinished frame.
+void process_job_shards(Job& job, const synfig::TargetParam& target_parameters);
+
+/// Run the same command line in the given count of child processes,
+/// each one rendering own shard, and wait for all of them
+void run_shard_workers(int count, int argc, char* argv[]);
+
+#endif // __SYNFIG_JOBSHARDING_H
@@ -58,6 +58,7 @@
 #include <synfig/string.h>
 #include <synfig/paramdesc.h>
 #include <synfig/main.h>
+#include <synfig/debug/profiler.h>
 #include <autorevision.h>
 #include "definitions.h"
 #include "progress.h"
@@ -65,6 +66,7 @@
 #include "synfigtoolexception.h"
 #include "optionsprocessor.h"
 #include "joblistprocessor.h"
+#include "jobsharding.h"
 #include "printing_functions.h"
 
 #include "named_type.h"
@@ -139,6 +141,11 @@ int main(int argc, char* argv[])
 		named_type<std::string>* layer_info_field_arg_desc = new named_type<std::string>("layer-name");
 		named_type<std::string>* video_codec_arg_desc = new named_type<std::string>("codec");
 		named_type<int>* video_bitrate_arg_desc = new named_type<int>("bitrate");
+		named_type<std::string>* shard_arg_desc = new named_type<std::string>("i/n");
+		named_type<int>* merge_shards_arg_desc = new named_type<int>("NUM");
+		named_type<int>* shard_workers_arg_desc = new named_type<int>("NUM");
+		named_type<std::string>* spool_dir_arg_desc = new named_type<std::string>("directory");
+		named_type<std::string>* profile_arg_desc = new named_type<std::string>("filename");
 
         po::options_description po_settings(_("Settings"));
         po_settings.add_options()
@@ -177,6 +184,7 @@ int main(int argc, char* argv[])
 			("append", append_filename_arg_desc, _("Append layers in <filename> to composition"))
             ("canvas-info", canvas_info_fields_arg_desc, _("Print out specified details of the root canvas"))
             ("canvases", _("Print out the list of exported canvases in the composition"))
+            ("profile", profile_arg_desc, _("Write time of rendering tasks into <filename> in Chrome trace format and print time per layer"))
             ;
 
         po::options_description po_ffmpeg(_("FFMPEG target options"));
@@ -185,6 +193,14 @@ int main(int argc, char* argv[])
             ("video-bitrate", video_bitrate_arg_desc, _("Set the bitrate for the output video"))
             ;
 
+        po::options_description po_farm(_("Render farm options"));
+        po_farm.add_options()
+			("shard", shard_arg_desc, _("Render only part i of n (0 <= i < n) of the frame range"))
+            ("merge-shards", merge_shards_arg_desc, _("Check and merge results of the given number of rendered shards"))
+            ("shard-workers", shard_workers_arg_desc, _("Split the render between the given number of local worker processes"))
+            ("spool-dir", spool_dir_arg_desc, _("Directory for progress files and intermediate frames of shards"))
+            ;
+
         po::options_description po_info(_("Synfig info options"));
         po_info.add_options()
 			("help", _("Produce this help message"))
@@ -220,7 +236,7 @@ int main(int argc, char* argv[])
         // Declare an options description instance which will include
         // all the options
         po::options_description po_all("");
-        po_all.add(po_settings).add(po_switchopts).add(po_misc).add(po_info).add(po_ffmpeg).add(po_hidden);
+        po_all.add(po_settings).add(po_switchopts).add(po_misc).add(po_info).add(po_ffmpeg).add(po_farm).add(po_hidden);
 
 #ifdef _DEBUG
 		po_all.add(po_debug);
@@ -229,7 +245,7 @@ int main(int argc, char* argv[])
         // Declare an options description instance which will be shown
         // to the user
         po::options_description po_visible("");
-        po_visible.add(po_settings).add(po_switchopts).add(po_misc).add(po_ffmpeg);
+        po_visible.add(po_settings).add(po_switchopts).add(po_misc).add(po_ffmpeg).add(po_farm);
 
 #ifdef _DEBUG
 		po_visible.add(po_debug);
@@ -274,6 +290,14 @@ int main(int argc, char* argv[])
 		job = op.extract_job();
 		job.desc = job.canvas->rend_desc() = op.extract_renddesc(job.canvas->rend_desc());
 
+		if (job.shard_workers > 0)
+		{
+			// render all shards by child processes, then merge their results here
+			run_shard_workers(job.shard_workers, argc, argv);
+			job.shard_count = job.shard_workers;
+			job.shard_merge = true;
+		}
+
 		if (job.extract_alpha) {
 			job.alpha_mode = synfig::TARGET_ALPHA_MODE_REDUCE;
 			job_list.push_front(job);
@@ -286,6 +310,17 @@ int main(int argc, char* argv[])
 
 		process_job_list(job_list, op.extract_targetparam());
 
+		std::string profile_filename = SynfigToolGeneralOptions::instance()->get_profile_filename();
+		if (!profile_filename.empty())
+		{
+			synfig::debug::Profiler::disable();
+			// every worker process writes its own profile
+			if (job.shard_count > 0 && !job.shard_merge)
+				profile_filename += etl::strprintf(".shard%d", job.shard_index);
+			synfig::debug::Profiler::write_trace(profile_filename);
+			std::cout << synfig::debug::Profiler::get_summary();
+		}
+
 		return SYNFIGTOOL_OK;
 
     }
@@ -30,6 +30,7 @@
 #endif
 
 #include <iostream>
+#include <cstdio>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 
@@ -48,6 +49,7 @@
 #include <synfig/filesystemgroup.h>
 #include <synfig/filesystemnative.h>
 #include <synfig/filecontainerzip.h>
+#include <synfig/debug/profiler.h>
 
 #include "definitions.h"
 #include "job.h"
@@ -164,6 +166,12 @@ void OptionsProcessor::process_settings_options()
 		SynfigToolGeneralOptions::instance()->set_should_print_benchmarks(true);
 	}
 
+	if (_vm.count("profile"))
+	{
+		SynfigToolGeneralOptions::instance()->set_profile_filename(_vm["profile"].as<std::string>());
+		synfig::debug::Profiler::enable(true);
+	}
+
 	if (_vm.count("quiet"))
 	{
 		SynfigToolGeneralOptions::instance()->set_should_be_quiet(true);
@@ -564,6 +572,44 @@ Job OptionsProcessor::extract_job()
 		job.extract_alpha = true;
 	}
 
+	if (_vm.count("shard"))
+	{
+		std::string shard = _vm["shard"].as<std::string>();
+		char c;
+		if (sscanf(shard.c_str(), "%d/%d%c", &job.shard_index, &job.shard_count, &c) != 2
+		 || job.shard_count <= 0 || job.shard_index < 0 || job.shard_index >= job.shard_count)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					(boost::format(_("Invalid shard \"%s\", expected i/n where 0 <= i < n.")) % shard).str());
+		VERBOSE_OUT(1) << _("Rendering shard ") << job.shard_index
+					   << "/" << job.shard_count << std::endl;
+	}
+
+	if (_vm.count("merge-shards"))
+	{
+		if (job.shard_count)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					_("Options --shard and --merge-shards can not be used together."));
+		job.shard_count = _vm["merge-shards"].as<int>();
+		if (job.shard_count <= 0)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					_("Count of shards to merge must be positive."));
+		job.shard_merge = true;
+	}
+
+	if (_vm.count("shard-workers"))
+	{
+		if (job.shard_count)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					_("Option --shard-workers can not be used with --shard or --merge-shards."));
+		job.shard_workers = _vm["shard-workers"].as<int>();
+		if (job.shard_workers <= 0)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					_("Count of shard workers must be positive."));
+	}
+
+	if (_vm.count("spool-dir"))
+		job.spool_dir = _vm["spool-dir"].as<std::string>();
+
 	if (_vm.count("quality"))
 		job.quality = _vm["quality"].as<int>();
 	else
@@ -0,0 +1,240 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file blineindex.cpp
+**	\brief BLineIndex Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <ETL/hermite>
+#include <synfig/blineindex.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+#define GRID_MIN    -3.0
+#define GRID_MAX     3.0
+#define GRID_STEP    0.1
+#define PRECISION    1e-9
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// linear search through all segments, as it was done
+// by Curve Gradient and Curve Warp before BLineIndex
+int find_closest_linear(bool fast, const vector<BLinePoint> &bline, bool loop, const Point &p, Real &t, Real &bline_dist)
+{
+	typedef etl::hermite<Vector> Curve;
+
+	int ret = -1;
+	Real dist = 100000000000.0;
+	Real best_pos = 0.0, best_bline_dist = 0.0, total_bline_dist = 0.0;
+	Curve best_curve;
+	t = 0.0;
+	bline_dist = 0.0;
+
+	int count = (int)bline.size();
+	if (!count) return ret;
+
+	for(int i = loop ? count - 1 : 0, next = loop ? 0 : 1; next < count; i = next++)
+	{
+		Curve curve(
+			bline[i].get_vertex(),
+			bline[next].get_vertex(),
+			bline[i].get_tangent2(),
+			bline[next].get_tangent1() );
+
+		if (fast)
+		{
+			for(int j = 0; j < BLineIndex::SAMPLES_COUNT; ++j)
+			{
+				Real x = BLineIndex::samples[j];
+				Real thisdist = (curve(x) - p).mag_squared();
+				if (thisdist < dist)
+					{ ret = i; dist = thisdist; best_bline_dist = total_bline_dist; best_curve = curve; best_pos = x; }
+			}
+		}
+		else
+		{
+			Real pos = curve.find_closest(fast, p);
+			Real thisdist = (curve(pos) - p).mag_squared();
+			if (thisdist < dist)
+				{ ret = i; dist = thisdist; best_bline_dist = total_bline_dist; best_curve = curve; best_pos = pos; }
+		}
+
+		total_bline_dist += curve.length();
+	}
+
+	t = best_pos;
+	bline_dist = best_bline_dist + best_curve.find_distance(0, best_pos);
+	return ret;
+}
+
+// simple deterministic generator, results must not depend on platform
+Real next_random(unsigned int &seed)
+{
+	seed = seed*1103515245u + 12345u;
+	return (Real)((seed >> 8) & 0xffff)/65535.0;
+}
+
+BLinePoint create_point(const Point &vertex, const Vector &tangent1, const Vector &tangent2)
+{
+	BLinePoint point;
+	point.set_vertex(vertex);
+	point.set_split_tangent_both(true);
+	point.set_tangent1(tangent1);
+	point.set_tangent2(tangent2);
+	return point;
+}
+
+vector<BLinePoint> create_random_bline(unsigned int seed, int count)
+{
+	vector<BLinePoint> bline;
+	for(int i = 0; i < count; ++i)
+	{
+		Point vertex(4.0*next_random(seed) - 2.0, 4.0*next_random(seed) - 2.0);
+		Vector t1(6.0*next_random(seed) - 3.0, 6.0*next_random(seed) - 3.0);
+		Vector t2(6.0*next_random(seed) - 3.0, 6.0*next_random(seed) - 3.0);
+		bline.push_back(create_point(vertex, t1, t2));
+	}
+	return bline;
+}
+
+// straight segments, repeated vertices and a symmetric shape to provoke equal distances
+vector<BLinePoint> create_degenerate_bline()
+{
+	vector<BLinePoint> bline;
+	bline.push_back(create_point(Point(-1.0, -1.0), Vector(), Vector()));
+	bline.push_back(create_point(Point( 1.0, -1.0), Vector(), Vector()));
+	bline.push_back(create_point(Point( 1.0, -1.0), Vector(), Vector()));
+	bline.push_back(create_point(Point( 1.0,  1.0), Vector(), Vector()));
+	bline.push_back(create_point(Point(-1.0,  1.0), Vector(0.0, -2.0), Vector(0.0, -2.0)));
+	bline.push_back(create_point(Point(-1.0, -1.0), Vector(), Vector()));
+	return bline;
+}
+
+int check_bline(const string &name, const vector<BLinePoint> &bline, bool loop)
+{
+	int failures = 0;
+
+	BLineIndex index;
+	index.build(bline, loop);
+
+	Real length = 0.0;
+	const vector<BLineIndex::Segment> &segments = index.get_segments();
+	for(int i = 0; i < (int)segments.size(); ++i)
+	{
+		if (fabs(segments[i].offset - length) > PRECISION)
+			{ cerr << name << ": wrong offset of segment " << i << endl; ++failures; }
+		length += segments[i].curve.length();
+	}
+	if (fabs(index.get_length() - length) > PRECISION)
+		{ cerr << name << ": length is " << index.get_length() << ", expected " << length << endl; ++failures; }
+
+	for(int f = 0; f < 2; ++f)
+	{
+		bool fast = f == 0;
+		for(Real y = GRID_MIN; y <= GRID_MAX; y += GRID_STEP)
+		for(Real x = GRID_MIN; x <= GRID_MAX; x += GRID_STEP)
+		{
+			Point p(x, y);
+			Real expected_pos, expected_dist;
+			int expected = find_closest_linear(fast, bline, loop, p, expected_pos, expected_dist);
+
+			Real pos;
+			int actual = index.find_closest(fast, p, pos);
+			int actual_index = actual < 0 ? -1 : segments[actual].index;
+			Real actual_dist = actual < 0 ? 0.0
+				: segments[actual].offset + segments[actual].curve.find_distance(0, pos);
+
+			if ( actual_index != expected
+			  || fabs(pos - expected_pos) > PRECISION
+			  || fabs(actual_dist - expected_dist) > PRECISION )
+			{
+				cerr << name << (fast ? " (fast)" : "") << ": at (" << x << ", " << y << ")"
+					 << " found segment " << actual_index << " at " << pos
+					 << ", expected segment " << expected << " at " << expected_pos << endl;
+				if (++failures > 20) return failures;
+			}
+		}
+	}
+
+	return failures;
+}
+
+int blineindex_test_empty()
+{
+	int failures = 0;
+	failures += check_bline("empty", vector<BLinePoint>(), false);
+	failures += check_bline("single point", create_random_bline(1, 1), false);
+	failures += check_bline("single point looped", create_random_bline(1, 1), true);
+	return failures;
+}
+
+int blineindex_test_random()
+{
+	int failures = 0;
+	// small blines fit into one leaf, large ones build a deep tree
+	int counts[] = { 2, 3, 5, 9, 40, 200 };
+	for(int i = 0; i < (int)(sizeof(counts)/sizeof(counts[0])); ++i)
+	{
+		vector<BLinePoint> bline = create_random_bline(100 + i, counts[i]);
+		failures += check_bline("random", bline, false);
+		failures += check_bline("random looped", bline, true);
+	}
+	return failures;
+}
+
+int blineindex_test_degenerate()
+{
+	int failures = 0;
+	vector<BLinePoint> bline = create_degenerate_bline();
+	failures += check_bline("degenerate", bline, false);
+	failures += check_bline("degenerate looped", bline, true);
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += blineindex_test_empty();
+	failures += blineindex_test_random();
+	failures += blineindex_test_degenerate();
+
+	return failures;
+}
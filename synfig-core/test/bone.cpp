@@ -29,8 +29,12 @@
 #	include <config.h>
 #endif
 
+#include <cmath>
 #include <iostream>
 #include <synfig/bone.h>
+#include <synfig/type.h>
+#include <synfig/valuenodes/valuenode_bone.h>
+#include <synfig/valuenodes/valuenode_const.h>
 
 #endif
 
@@ -46,6 +50,29 @@ using namespace synfig;
 
 /* === P R O C E D U R E S ================================================= */
 
+bool is_equal(const Matrix &a, const Matrix &b)
+{
+	const Real e = 1e-10;
+	return fabs(a.m00 - b.m00) < e && fabs(a.m01 - b.m01) < e && fabs(a.m02 - b.m02) < e
+		&& fabs(a.m10 - b.m10) < e && fabs(a.m11 - b.m11) < e && fabs(a.m12 - b.m12) < e
+		&& fabs(a.m20 - b.m20) < e && fabs(a.m21 - b.m21) < e && fabs(a.m22 - b.m22) < e;
+}
+
+Matrix get_animated_matrix(const ValueNode_Bone::Handle &bone, Time t = Time(0))
+{
+	return (*bone)(t).get(Bone()).get_animated_matrix();
+}
+
+ValueNode_Bone::Handle create_bone(const String &name, const Point &origin, Real angle)
+{
+	return ValueNode_Bone::create(ValueBase(Bone(name, origin, Angle::deg(angle), 1.0)));
+}
+
+void set_parent(const ValueNode_Bone::Handle &bone, const ValueNode_Bone::Handle &parent)
+{
+	bone->set_link("parent", ValueNode_Const::create(ValueBase(parent)));
+}
+
 int bone_test1()
 {
 	return 0;
@@ -56,14 +83,83 @@ int bone_test2()
 	return 0;
 }
 
+// cached poses must not depend on order of evaluation of bones
+int bone_test_pose_cache()
+{
+	int failures = 0;
+
+	ValueNode_Bone::Handle a = create_bone("a", Point(1.0, 0.0), 90.0);
+	ValueNode_Bone::Handle b = create_bone("b", Point(2.0, 0.0), 0.0);
+	set_parent(b, a);
+
+	Matrix matrix_a = Matrix().set_rotate(Angle::deg(90.0))
+					* Matrix().set_translate(Point(1.0, 0.0));
+	Matrix matrix_b = Matrix().set_translate(Point(2.0, 0.0))
+					* matrix_a;
+
+	// child first
+	if (!is_equal(get_animated_matrix(b), matrix_b)) { cerr << "child evaluated first" << endl; ++failures; }
+	if (!is_equal(get_animated_matrix(a), matrix_a)) { cerr << "parent evaluated after child" << endl; ++failures; }
+
+	// parent first, after change of parent
+	a->set_link("angle", ValueNode_Const::create(Angle::deg(0.0)));
+	matrix_a = Matrix().set_translate(Point(1.0, 0.0));
+	matrix_b = Matrix().set_translate(Point(2.0, 0.0)) * matrix_a;
+	if (!is_equal(get_animated_matrix(a), matrix_a)) { cerr << "changed parent evaluated first" << endl; ++failures; }
+	if (!is_equal(get_animated_matrix(b), matrix_b)) { cerr << "child of changed parent" << endl; ++failures; }
+
+	// other time
+	if (!is_equal(get_animated_matrix(b, Time(1.0)), matrix_b)) { cerr << "child at other time" << endl; ++failures; }
+
+	return failures;
+}
+
+// all bones of ancestry loop get the root bone as parent, whatever is evaluated first
+int bone_test_loop()
+{
+	int failures = 0;
+
+	for(int order = 0; order < 2; ++order)
+	{
+		ValueNode_Bone::Handle a = create_bone("a", Point(1.0, 0.0), 30.0);
+		ValueNode_Bone::Handle b = create_bone("b", Point(0.0, 2.0), 60.0);
+		set_parent(a, b);
+		set_parent(b, a);
+
+		Matrix matrix_a = order ? get_animated_matrix(a) : Matrix();
+		Matrix matrix_b = get_animated_matrix(b);
+		if (!order) matrix_a = get_animated_matrix(a);
+
+		if (!is_equal(matrix_a, Matrix().set_rotate(Angle::deg(30.0)) * Matrix().set_translate(Point(1.0, 0.0))))
+			{ cerr << "bone a of loop is not attached to root, order " << order << endl; ++failures; }
+		if (!is_equal(matrix_b, Matrix().set_rotate(Angle::deg(60.0)) * Matrix().set_translate(Point(0.0, 2.0))))
+			{ cerr << "bone b of loop is not attached to root, order " << order << endl; ++failures; }
+
+		// break the loop
+		set_parent(a, ValueNode_Bone::get_root_bone());
+		set_parent(b, ValueNode_Bone::get_root_bone());
+	}
+
+	return failures;
+}
+
 /* === E N T R Y P O I N T ================================================= */
 
 int main()
 {
+	if (!Type::subsys_init())
+	{
+		cerr << "unable to initialize types" << endl;
+		return 1;
+	}
+
 	int failures = 0;
 
 	failures += bone_test1();
 	failures += bone_test2();
+	failures += bone_test_pose_cache();
+	failures += bone_test_loop();
 
+	Type::subsys_stop();
 	return failures;
 }
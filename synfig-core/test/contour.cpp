@@ -0,0 +1,192 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file contour.cpp
+**	\brief software::Contour Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/surface.h>
+#include <synfig/rendering/primitive/contour.h>
+#include <synfig/rendering/software/function/contour.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+#define WIDTH      97
+#define HEIGHT     61
+#define PRECISION  1e-5
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// simple deterministic generator, results must not depend on platform
+ColorReal next_random(unsigned int &seed)
+{
+	seed = seed*1103515245u + 12345u;
+	return (ColorReal)((seed >> 8) & 0xffff)/65535.f;
+}
+
+// background with transparent, translucent and opaque pixels
+void fill_background(synfig::Surface &surface, unsigned int seed)
+{
+	for(int y = 0; y < surface.get_h(); ++y)
+		for(int x = 0; x < surface.get_w(); ++x)
+		{
+			ColorReal a = next_random(seed);
+			a = a < 0.2f ? 0.f : a > 0.8f ? 1.f : a;
+			surface[y][x] = Color(
+				2.f*next_random(seed) - 0.5f,
+				2.f*next_random(seed) - 0.5f,
+				2.f*next_random(seed) - 0.5f,
+				a );
+		}
+}
+
+// self-intersecting star with curved edges, so winding style matters,
+// and horizontal runs inside and outside of it are long
+Contour::ChunkList create_star()
+{
+	Contour contour;
+	const Point center(WIDTH*0.5, HEIGHT*0.5);
+	const Real rx = WIDTH*0.6, ry = HEIGHT*0.6;
+	const Real pi = 3.14159265358979323846;
+	const int count = 5;
+	for(int i = 0; i <= count; ++i)
+	{
+		Real angle = 4.0*pi*i/count;
+		Point p = center + Vector(rx*cos(angle), ry*sin(angle));
+		if (i == 0)
+			contour.move_to(p);
+		else
+		if (i % 2)
+			contour.conic_to(p, center + Vector(rx*0.3*cos(angle + 1.0), ry*0.3*sin(angle + 1.0)));
+		else
+			contour.line_to(p);
+	}
+	contour.close();
+	return contour.get_chunks();
+}
+
+// renders coverage of each pixel into alpha channel of 'out_mask',
+// STRAIGHT blending goes through Color::blend for every pixel
+// and puts exactly the amount of blending into the transparent surface
+void render_mask(
+	synfig::Surface &out_mask,
+	const Contour::ChunkList &chunks,
+	bool invert,
+	bool antialias,
+	Contour::WindingStyle winding_style )
+{
+	out_mask.set_wh(WIDTH, HEIGHT);
+	out_mask.clear();
+	software::Contour::render_contour(
+		out_mask, chunks, invert, antialias, winding_style,
+		Matrix(), Color::white(), 1.f, Color::BLEND_STRAIGHT );
+}
+
+int check(
+	const Contour::ChunkList &chunks,
+	bool invert,
+	bool antialias,
+	Contour::WindingStyle winding_style,
+	const Color &color,
+	ColorReal opacity )
+{
+	synfig::Surface mask;
+	render_mask(mask, chunks, invert, antialias, winding_style);
+
+	synfig::Surface actual(WIDTH, HEIGHT);
+	fill_background(actual, 7);
+	synfig::Surface expected(actual);
+
+	software::Contour::render_contour(
+		actual, chunks, invert, antialias, winding_style,
+		Matrix(), color, opacity, Color::BLEND_COMPOSITE );
+
+	for(int y = 0; y < HEIGHT; ++y)
+		for(int x = 0; x < WIDTH; ++x)
+			if (mask[y][x].get_a())
+				expected[y][x] = Color::blend(color, expected[y][x], opacity*mask[y][x].get_a(), Color::BLEND_COMPOSITE);
+
+	for(int y = 0; y < HEIGHT; ++y)
+		for(int x = 0; x < WIDTH; ++x)
+		{
+			const Color &a = actual[y][x];
+			const Color &e = expected[y][x];
+			if ( fabs(a.get_r() - e.get_r()) > PRECISION*(1.0 + fabs(e.get_r()))
+			  || fabs(a.get_g() - e.get_g()) > PRECISION*(1.0 + fabs(e.get_g()))
+			  || fabs(a.get_b() - e.get_b()) > PRECISION*(1.0 + fabs(e.get_b()))
+			  || fabs(a.get_a() - e.get_a()) > PRECISION )
+			{
+				cerr << "composite: invert " << invert << ", antialias " << antialias
+					 << ", winding " << winding_style << ", color alpha " << color.get_a()
+					 << ", opacity " << opacity
+					 << ", pixel (" << x << ", " << y << ") is ("
+					 << a.get_r() << ", " << a.get_g() << ", " << a.get_b() << ", " << a.get_a() << "), expected ("
+					 << e.get_r() << ", " << e.get_g() << ", " << e.get_b() << ", " << e.get_a() << ")" << endl;
+				return 1;
+			}
+		}
+	return 0;
+}
+
+// span loop of COMPOSITE blending gives the same result as Color::blend for each pixel
+int contour_test_composite()
+{
+	int failures = 0;
+	Contour::ChunkList chunks = create_star();
+	Color colors[] = { Color(0.2f, 0.7f, 1.3f, 1.f), Color(0.9f, -0.1f, 0.4f, 0.6f), Color(0.5f, 0.5f, 0.5f, 0.f) };
+	ColorReal opacities[] = { 1.f, 0.35f, 0.f };
+	for(int w = 0; w < Contour::WINDING_END; ++w)
+	for(int i = 0; i < 2; ++i)
+	for(int a = 0; a < 2; ++a)
+	for(int c = 0; c < (int)(sizeof(colors)/sizeof(colors[0])); ++c)
+	for(int o = 0; o < (int)(sizeof(opacities)/sizeof(opacities[0])); ++o)
+		failures += check(chunks, i != 0, a != 0, (Contour::WindingStyle)w, colors[c], opacities[o]);
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += contour_test_composite();
+
+	return failures;
+}
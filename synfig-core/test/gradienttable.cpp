@@ -0,0 +1,122 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file gradienttable.cpp
+**	\brief GradientTable Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/gradient.h>
+#include <synfig/rendering/software/function/gradienttable.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+#define PRECISION 1e-3
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// premultiplied colors are compared, straight color is undefined where alpha is zero
+int compare(const string &name, const Gradient &gradient)
+{
+	static const float supersamples[] = { 0.f, 0.001f, 0.05f, 0.3f, 1.5f, 3.f };
+
+	GradientTable table(gradient);
+	for(int i = 0; i < (int)(sizeof(supersamples)/sizeof(supersamples[0])); ++i)
+	{
+		for(Real x = -0.5; x <= 1.5; x += 0.0013)
+		{
+			Color expected = gradient(x, supersamples[i]).premult_alpha();
+			Color actual = table.get_premult(x, supersamples[i]);
+			if ( fabs(expected.get_r() - actual.get_r()) > PRECISION
+			  || fabs(expected.get_g() - actual.get_g()) > PRECISION
+			  || fabs(expected.get_b() - actual.get_b()) > PRECISION
+			  || fabs(expected.get_a() - actual.get_a()) > PRECISION )
+			{
+				cerr << name << ": color at " << x << " with supersample " << supersamples[i]
+					 << " is (" << actual.get_r() << ", " << actual.get_g() << ", " << actual.get_b() << ", " << actual.get_a()
+					 << "), expected (" << expected.get_r() << ", " << expected.get_g() << ", " << expected.get_b() << ", " << expected.get_a()
+					 << ")" << endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+int gradienttable_test_smooth()
+{
+	Gradient gradient;
+	gradient.push_back(GradientCPoint(0.0, Color(1.f, 0.f, 0.f, 1.f)));
+	gradient.push_back(GradientCPoint(0.3, Color(0.f, 1.f, 0.f, 0.5f)));
+	gradient.push_back(GradientCPoint(0.7, Color(0.f, 0.f, 1.f, 1.f)));
+	gradient.push_back(GradientCPoint(1.0, Color(1.f, 1.f, 1.f, 0.f)));
+	return compare("smooth", gradient);
+}
+
+int gradienttable_test_degenerate()
+{
+	int failures = 0;
+
+	Gradient gradient;
+	failures += compare("empty", gradient);
+
+	gradient.push_back(GradientCPoint(0.4, Color(1.f, 0.f, 0.f, 1.f)));
+	failures += compare("single point", gradient);
+
+	// two points at the same position
+	gradient.push_back(GradientCPoint(0.4, Color(0.f, 0.f, 1.f, 0.5f)));
+	failures += compare("step", gradient);
+
+	gradient.push_back(GradientCPoint(0.9, Color(0.f, 1.f, 0.f, 1.f)));
+	failures += compare("step and ramp", gradient);
+
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += gradienttable_test_smooth();
+	failures += gradienttable_test_degenerate();
+
+	return failures;
+}
@@ -0,0 +1,363 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file importercache.cpp
+**	\brief ImporterCache Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <utime.h>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <synfig/filesystemnative.h>
+#include <synfig/importer.h>
+#include <synfig/importercache.h>
+#include <synfig/surface.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+#define WIDTH      32
+#define HEIGHT     16
+#define EXTENSION  "testimg"
+//! base modification time of test files
+#define MTIME      1000000000
+
+/* === G L O B A L S ======================================================= */
+
+//! count of images decoded by TestImporter
+int decodes = 0;
+
+/* === P R O C E D U R E S ================================================= */
+
+// simple deterministic generator, results must not depend on platform
+unsigned int next_random(unsigned int &seed)
+{
+	seed = seed*1103515245u + 12345u;
+	return (seed >> 8) & 0xffff;
+}
+
+//! Image is generated from the content of file, the first byte selects the kind of pixels:
+//! 'u' - 8-bit values decoded with gamma like in real importers,
+//! 'h' - values which are exactly representable by half-floats,
+//! 'f' - arbitrary floats, which cannot be stored without loss
+class TestImporter: public Importer
+{
+public:
+	explicit TestImporter(const FileSystem::Identifier &identifier): Importer(identifier) { }
+
+	static Importer* create(const FileSystem::Identifier &identifier)
+		{ return new TestImporter(identifier); }
+
+	static void generate(synfig::Surface &surface, const Gamma &gamma, const vector<char> &content)
+	{
+		unsigned int seed = (unsigned int)content.size();
+		for(int i = 0; i < (int)content.size(); ++i)
+			seed = seed*31u + (unsigned char)content[i];
+		char mode = content.empty() ? 'f' : content[0];
+
+		surface.set_wh(WIDTH, HEIGHT);
+		for(int y = 0; y < HEIGHT; ++y)
+			for(int x = 0; x < WIDTH; ++x)
+			{
+				Color &c = surface[y][x];
+				if (mode == 'u')
+					c = Color(
+						gamma.r_U8_to_F32(next_random(seed) & 0xff),
+						gamma.g_U8_to_F32(next_random(seed) & 0xff),
+						gamma.b_U8_to_F32(next_random(seed) & 0xff),
+						(float)((float)(next_random(seed) & 0xff)*(1.0/255.0)) );
+				else
+				if (mode == 'h')
+					c = Color(
+						(float)((int)(next_random(seed) & 0x3ff) - 512)/256.f,
+						(float)((int)(next_random(seed) & 0x3ff) - 512)/256.f,
+						(float)((int)(next_random(seed) & 0x3ff) - 512)/256.f,
+						(float)(next_random(seed) & 0xff)/256.f );
+				else
+					c = Color(
+						(float)next_random(seed)/65535.f*1.7f + 1e-4f,
+						(float)next_random(seed)/65535.f*1.7f + 1e-4f,
+						(float)next_random(seed)/65535.f*1.7f + 1e-4f,
+						(float)next_random(seed)/65535.f*0.9f + 1e-4f );
+			}
+	}
+
+	static bool read(const FileSystem::Identifier &identifier, vector<char> &out_content)
+	{
+		out_content.clear();
+		FileSystem::ReadStreamHandle stream = identifier.get_read_stream();
+		if (!stream) return false;
+		char buffer[256];
+		while(size_t size = stream->read_block(buffer, sizeof(buffer)))
+			out_content.insert(out_content.end(), buffer, buffer + size);
+		return true;
+	}
+
+	virtual bool get_frame(synfig::Surface &surface, const RendDesc & /* renddesc */, Time /* time */, ProgressCallback * /* callback */)
+	{
+		vector<char> content;
+		if (!read(identifier, content)) return false;
+		generate(surface, gamma(), content);
+		++decodes;
+		return true;
+	}
+};
+
+string get_path(const string &name)
+	{ return string(g_get_tmp_dir()) + G_DIR_SEPARATOR_S + "synfig-importercache-test-" + name + "." EXTENSION; }
+
+FileSystem::Identifier get_identifier(const string &name)
+	{ return FileSystemNative::instance()->get_identifier(get_path(name)); }
+
+//! Writes 'size' bytes of file, and sets the modification time
+void write_file(const string &name, char mode, unsigned int seed, int size, long mtime)
+{
+	string path = get_path(name);
+	{
+		ofstream file(path.c_str(), ios::binary | ios::trunc);
+		file.put(mode);
+		for(int i = 1; i < size; ++i)
+			file.put((char)next_random(seed));
+	}
+	struct utimbuf times;
+	times.actime = (time_t)mtime;
+	times.modtime = (time_t)mtime;
+	g_utime(path.c_str(), &times);
+}
+
+void remove_file(const string &name)
+	{ FileSystemNative::instance()->file_remove(get_path(name)); }
+
+//! Expected pixels, as TestImporter decodes them from the current content of file
+void get_expected(const string &name, synfig::Surface &out_surface)
+{
+	vector<char> content;
+	TestImporter::read(get_identifier(name), content);
+	TestImporter::generate(out_surface, Gamma(2.2), content);
+}
+
+ImporterCache::Frame get_frame(const string &name)
+{
+	ImporterCache::Frame frame;
+	Importer::Handle importer;
+	ImporterCache::get_frame(get_identifier(name), RendDesc(), frame, importer);
+	return frame;
+}
+
+int compare(const string &test, const string &name, const ImporterCache::Frame &frame)
+{
+	if (!frame.surface || !frame.surface->get_surface().is_valid())
+		{ cerr << test << ": " << name << ": no surface" << endl; return 1; }
+
+	synfig::Surface expected;
+	get_expected(name, expected);
+	const synfig::Surface &actual = frame.surface->get_surface();
+	if (actual.get_w() != expected.get_w() || actual.get_h() != expected.get_h())
+		{ cerr << test << ": " << name << ": wrong size of surface" << endl; return 1; }
+
+	for(int y = 0; y < expected.get_h(); ++y)
+		for(int x = 0; x < expected.get_w(); ++x)
+			if (actual[y][x] != expected[y][x])
+			{
+				const Color &a = actual[y][x], &e = expected[y][x];
+				cerr << test << ": " << name << ": pixel (" << x << ", " << y << ") is ("
+					 << a.get_r() << ", " << a.get_g() << ", " << a.get_b() << ", " << a.get_a() << "), expected ("
+					 << e.get_r() << ", " << e.get_g() << ", " << e.get_b() << ", " << e.get_a() << ")" << endl;
+				return 1;
+			}
+	return 0;
+}
+
+int check_decodes(const string &test, const string &step, int expected)
+{
+	if (decodes == expected) return 0;
+	cerr << test << ": " << step << ": image decoded " << decodes << " times, expected " << expected << endl;
+	return 1;
+}
+
+// surface released by cache is restored from the compact copy without any change,
+// image which cannot be stored without loss is decoded again
+int check_round_trip(char mode, size_t packed_size)
+{
+	const string test = string("round trip ") + mode;
+	const string name = string("roundtrip-") + mode;
+	const size_t surface_size = WIDTH*HEIGHT*sizeof(Color);
+	int failures = 0;
+
+	ImporterCache::clear();
+	ImporterCache::set_memory_limit(100*surface_size);
+	write_file(name, mode, 1, 100, MTIME);
+	decodes = 0;
+
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "first request", 1);
+
+	// frame is not used anymore, so only compact copy fits
+	ImporterCache::set_memory_limit(packed_size ? packed_size : 1);
+	if (ImporterCache::get_memory_used() != packed_size)
+	{
+		cerr << test << ": " << ImporterCache::get_memory_used() << " bytes are used after release, expected "
+			 << packed_size << endl;
+		++failures;
+	}
+
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "request after release", packed_size ? 1 : 2);
+
+	remove_file(name);
+	return failures;
+}
+
+int importercache_test_round_trip()
+{
+	int failures = 0;
+	failures += check_round_trip('u', WIDTH*HEIGHT*4);
+	failures += check_round_trip('h', WIDTH*HEIGHT*4*sizeof(unsigned short));
+	failures += check_round_trip('f', 0);
+	return failures;
+}
+
+// least recently used image is released when limit is reached,
+// and images used by layers are never released
+int importercache_test_lru()
+{
+	const string test = "lru";
+	const size_t surface_size = WIDTH*HEIGHT*sizeof(Color);
+	int failures = 0;
+
+	ImporterCache::clear();
+	ImporterCache::set_memory_limit(surface_size*5/2);
+	write_file("lru-a", 'f', 1, 100, MTIME);
+	write_file("lru-b", 'f', 2, 100, MTIME);
+	write_file("lru-c", 'f', 3, 100, MTIME);
+	decodes = 0;
+
+	get_frame("lru-a");
+	get_frame("lru-b");
+	failures += check_decodes(test, "a and b", 2);
+
+	// a is used more recently than b
+	failures += compare(test, "lru-a", get_frame("lru-a"));
+	failures += check_decodes(test, "a again", 2);
+
+	// only two surfaces fit, so b is released
+	get_frame("lru-c");
+	failures += check_decodes(test, "c", 3);
+	failures += compare(test, "lru-a", get_frame("lru-a"));
+	failures += check_decodes(test, "a after c", 3);
+	failures += compare(test, "lru-b", get_frame("lru-b"));
+	failures += check_decodes(test, "b after c", 4);
+
+	// a is held, so c and b are released instead of it
+	ImporterCache::Frame held = get_frame("lru-a");
+	ImporterCache::set_memory_limit(1);
+	if (ImporterCache::get_memory_used() != surface_size)
+	{
+		cerr << test << ": " << ImporterCache::get_memory_used() << " bytes are used with held image, expected "
+			 << surface_size << endl;
+		++failures;
+	}
+	ImporterCache::Frame frame = get_frame("lru-a");
+	failures += check_decodes(test, "held a", 4);
+	if (frame.surface != held.surface)
+		{ cerr << test << ": held surface is not shared" << endl; ++failures; }
+
+	remove_file("lru-a");
+	remove_file("lru-b");
+	remove_file("lru-c");
+	return failures;
+}
+
+// changed file is decoded again, changes are detected by modification time and size
+int importercache_test_invalidation()
+{
+	const string test = "invalidation";
+	const string name = "invalidation";
+	int failures = 0;
+
+	ImporterCache::clear();
+	ImporterCache::set_memory_limit(1024*1024);
+	write_file(name, 'u', 1, 100, MTIME);
+	decodes = 0;
+
+	failures += compare(test, name, get_frame(name));
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "not changed", 1);
+
+	// the same size, other time
+	write_file(name, 'u', 2, 100, MTIME + 10);
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "time changed", 2);
+
+	// the same time, other size
+	write_file(name, 'u', 3, 101, MTIME + 10);
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "size changed", 3);
+
+	// file is overwritten within the same second by the file of the same size,
+	// it is the case for ImporterCache::forget()
+	write_file(name, 'u', 4, 101, MTIME + 10);
+	ImporterCache::forget(get_identifier(name));
+	failures += compare(test, name, get_frame(name));
+	failures += check_decodes(test, "forgotten", 4);
+
+	remove_file(name);
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	if (!Importer::subsys_init())
+	{
+		cerr << "unable to initialize importers" << endl;
+		return 1;
+	}
+	Importer::book()[EXTENSION] = Importer::BookEntry(&TestImporter::create, true);
+
+	int failures = 0;
+
+	failures += importercache_test_round_trip();
+	failures += importercache_test_lru();
+	failures += importercache_test_invalidation();
+
+	Importer::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,131 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file packedpixels.cpp
+**	\brief PackedPixels Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <iostream>
+#include <vector>
+#include <synfig/rendering/software/function/packedpixels.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+bool round_trip(PackedPixels::Format desired, PackedPixels::Format expected, const vector<Color> &src)
+{
+	Color mask_color;
+	PackedPixels::Format format = PackedPixels::choose_format(desired, &src.front(), (int)src.size(), mask_color);
+	if (format != expected)
+	{
+		cerr << "format " << format << " chosen, expected " << expected << endl;
+		return false;
+	}
+
+	vector<unsigned char> packed(src.size()*PackedPixels::get_pixel_size(format));
+	vector<Color> dst(src.size());
+	PackedPixels::pack(format, mask_color, &packed.front(), &src.front(), (int)src.size());
+	PackedPixels::unpack(format, mask_color, &dst.front(), &packed.front(), (int)src.size());
+
+	for(int i = 0; i < (int)src.size(); ++i)
+		if ( dst[i].get_r() != src[i].get_r()
+		  || dst[i].get_g() != src[i].get_g()
+		  || dst[i].get_b() != src[i].get_b()
+		  || dst[i].get_a() != src[i].get_a() )
+		{
+			cerr << "pixel " << i << " of format " << format << " changed by round trip" << endl;
+			return false;
+		}
+	return true;
+}
+
+int packedpixels_test_mask()
+{
+	int failures = 0;
+	Color color(0.25f, 0.5f, 0.75f, 1.f);
+
+	// alpha is multiple of 1/255
+	vector<Color> src;
+	for(int i = 0; i < 256; ++i)
+		src.push_back(i ? Color(color.get_r(), color.get_g(), color.get_b(), i/255.f) : Color::alpha());
+	if (!round_trip(PackedPixels::FORMAT_ALPHA8, PackedPixels::FORMAT_ALPHA8, src)) ++failures;
+
+	// antialiased alpha
+	src[1].set_a(0.3f/255.f);
+	if (!round_trip(PackedPixels::FORMAT_ALPHA8, PackedPixels::FORMAT_ALPHA32F, src)) ++failures;
+
+	// different color
+	src[2].set_r(0.3f);
+	if (!round_trip(PackedPixels::FORMAT_ALPHA8, PackedPixels::FORMAT_RGBA32F, src)) ++failures;
+
+	// dirty transparent pixel
+	src[2] = color;
+	src[0] = Color(1.f, 0.f, 0.f, 0.f);
+	if (!round_trip(PackedPixels::FORMAT_ALPHA8, PackedPixels::FORMAT_RGBA32F, src)) ++failures;
+
+	return failures;
+}
+
+int packedpixels_test_half_conversion()
+{
+	int failures = 0;
+	for(int i = 0; i < 0x10000; ++i)
+	{
+		unsigned short h = (unsigned short)i;
+		if ((h & 0x7c00) == 0x7c00 && (h & 0x3ff)) continue; // NaN
+		if (PackedPixels::float_to_half(PackedPixels::half_to_float(h)) != h)
+		{
+			cerr << "half-float " << i << " changed by round trip" << endl;
+			++failures;
+		}
+	}
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += packedpixels_test_mask();
+	failures += packedpixels_test_half_conversion();
+
+	return failures;
+}
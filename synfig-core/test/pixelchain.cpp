@@ -0,0 +1,278 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file pixelchain.cpp
+**	\brief TaskPixelChainSW Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <iostream>
+#include <synfig/rendering/common/task/tasksurface.h>
+#include <synfig/rendering/software/renderersw.h>
+#include <synfig/rendering/software/surfacesw.h>
+#include <synfig/rendering/software/optimizer/optimizerpixelchainsw.h>
+#include <synfig/rendering/software/task/taskpixelchainsw.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+// rows are longer than TaskPixelChainSW::BLOCK_SIZE
+#define WIDTH  600
+#define HEIGHT 20
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// processor which runs separately in the same way as Clamp and Color Correct
+class TaskTestPixelSW: public TaskPixelProcessor, public TaskSW, public TaskPixelFunctionSW
+{
+public:
+	virtual bool run(RunParams & /* params */) const
+	{
+		const synfig::Surface &a =
+			SurfaceSW::Handle::cast_dynamic( sub_task()->target_surface )->get_surface();
+		synfig::Surface &c =
+			SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+
+		RectInt r = get_target_rect();
+		if (r.valid())
+		{
+			VectorInt offset = get_offset();
+			RectInt ra = sub_task()->get_target_rect() + r.get_min() + offset;
+			if (ra.valid())
+			{
+				etl::set_intersect(ra, ra, r);
+				if (ra.valid())
+				{
+					for(int y = ra.miny; y < ra.maxy; ++y)
+						process_pixels(
+							&c[y][ra.minx],
+							&a[y - r.miny - offset[1]][ra.minx - r.minx - offset[0]],
+							ra.maxx - ra.minx );
+				}
+			}
+		}
+		return true;
+	}
+};
+
+class TaskTestGainSW: public TaskTestPixelSW
+{
+public:
+	ColorReal gain;
+	ColorReal shift;
+	TaskTestGainSW(): gain(), shift() { }
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	virtual void process_pixels(Color *dst, const Color *src, int count) const
+	{
+		for(Color *end = dst + count; dst < end; ++dst, ++src)
+			*dst = Color(
+				src->get_r()*gain + shift,
+				src->get_g()*gain + shift,
+				src->get_b()*gain + shift,
+				src->get_a() );
+	}
+};
+
+class TaskTestSwapSW: public TaskTestPixelSW
+{
+public:
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	virtual void process_pixels(Color *dst, const Color *src, int count) const
+	{
+		for(Color *end = dst + count; dst < end; ++dst, ++src)
+			*dst = Color(
+				src->get_b(),
+				src->get_g()*src->get_g(),
+				src->get_r() > 0.5 ? src->get_r() : -src->get_r(),
+				src->get_a() );
+	}
+};
+
+// simple deterministic generator, results must not depend on platform
+ColorReal next_random(unsigned int &seed)
+{
+	seed = seed*1103515245u + 12345u;
+	return (ColorReal)((seed >> 8) & 0xffff)/65535.f;
+}
+
+SurfaceSW::Handle create_surface(int width, int height)
+{
+	SurfaceSW::Handle surface(new SurfaceSW());
+	surface->set_size(width, height);
+	surface->create();
+	return surface;
+}
+
+Task::Handle create_source()
+{
+	Task::Handle task(new TaskSurface());
+	SurfaceSW::Handle surface = create_surface(WIDTH, HEIGHT);
+	unsigned int seed = 1;
+	for(int y = 0; y < HEIGHT; ++y)
+		for(int x = 0; x < WIDTH; ++x)
+			surface->get_surface()[y][x] = Color(
+				3.f*next_random(seed) - 1.f,
+				3.f*next_random(seed) - 1.f,
+				3.f*next_random(seed) - 1.f,
+				next_random(seed) );
+	task->target_surface = surface;
+	task->init_target_rect(RectInt(0, 0, WIDTH, HEIGHT), Point(-3.0, 2.0), Point(3.0, -2.0));
+	return task;
+}
+
+void init_processor(
+	const TaskPixelProcessor::Handle &task,
+	const Task::Handle &sub_task,
+	int surface_width, int surface_height,
+	const RectInt &target_rect, const Point &lt, const Point &rb )
+{
+	task->sub_task() = sub_task;
+	task->target_surface = create_surface(surface_width, surface_height);
+	task->init_target_rect(target_rect, lt, rb);
+}
+
+TaskPixelProcessor::Handle create_gain(ColorReal gain, ColorReal shift)
+{
+	etl::handle<TaskTestGainSW> task(new TaskTestGainSW());
+	task->gain = gain;
+	task->shift = shift;
+	return task;
+}
+
+TaskPixelChainSW::Handle optimize(const Task::Handle &task)
+{
+	static RendererSW renderer;
+	Task::List list;
+	Optimizer::RunParams params(renderer, list, Optimizer::CATEGORY_ALL, task);
+	task->update_bounds_recursive();
+	OptimizerPixelChainSW().run(params);
+	return TaskPixelChainSW::Handle::cast_dynamic(params.ref_task);
+}
+
+int compare(const string &name, const rendering::Surface::Handle &expected, const rendering::Surface::Handle &actual)
+{
+	const synfig::Surface &e = SurfaceSW::Handle::cast_dynamic(expected)->get_surface();
+	const synfig::Surface &a = SurfaceSW::Handle::cast_dynamic(actual)->get_surface();
+	for(int y = 0; y < e.get_h(); ++y)
+		for(int x = 0; x < e.get_w(); ++x)
+			if (e[y][x] != a[y][x])
+			{
+				cerr << name << ": pixel (" << x << ", " << y << ") is ("
+					 << a[y][x].get_r() << ", " << a[y][x].get_g() << ", "
+					 << a[y][x].get_b() << ", " << a[y][x].get_a() << "), expected ("
+					 << e[y][x].get_r() << ", " << e[y][x].get_g() << ", "
+					 << e[y][x].get_b() << ", " << e[y][x].get_a() << ")" << endl;
+				return 1;
+			}
+	return 0;
+}
+
+// inner processor has own surface with margins,
+// outer processor covers a part of it, so offsets are not zero
+int pixelchain_test_pair()
+{
+	Task::Handle source = create_source();
+
+	TaskPixelProcessor::Handle inner = create_gain(1.5f, -0.25f);
+	init_processor(inner, source, WIDTH + 10, HEIGHT + 10,
+		RectInt(5, 5, WIDTH + 5, HEIGHT + 5), Point(-3.0, 2.0), Point(3.0, -2.0));
+
+	TaskPixelProcessor::Handle outer(new TaskTestSwapSW());
+	init_processor(outer, inner, WIDTH, HEIGHT,
+		RectInt(3, 1, WIDTH - 37, HEIGHT - 3), Point(-2.8, 1.6), Point(2.8, -1.6));
+
+	TaskPixelChainSW::Handle chain = optimize(outer);
+	if (!chain || chain->processors.size() != 2)
+		{ cerr << "pair: processors are not fused" << endl; return 1; }
+	chain->target_surface = create_surface(WIDTH, HEIGHT);
+
+	Task::RunParams params;
+	inner->run(params);
+	outer->run(params);
+	chain->run(params);
+
+	return compare("pair", outer->target_surface, chain->target_surface);
+}
+
+// chain grows when next processor is fused
+int pixelchain_test_triple()
+{
+	Task::Handle source = create_source();
+
+	TaskPixelProcessor::Handle inner = create_gain(1.5f, -0.25f);
+	init_processor(inner, source, WIDTH + 10, HEIGHT + 10,
+		RectInt(5, 5, WIDTH + 5, HEIGHT + 5), Point(-3.0, 2.0), Point(3.0, -2.0));
+
+	TaskPixelProcessor::Handle middle(new TaskTestSwapSW());
+	init_processor(middle, inner, WIDTH, HEIGHT,
+		RectInt(3, 1, WIDTH - 37, HEIGHT - 3), Point(-2.8, 1.6), Point(2.8, -1.6));
+
+	TaskPixelProcessor::Handle outer = create_gain(0.5f, 0.125f);
+	init_processor(outer, middle, WIDTH, HEIGHT,
+		RectInt(10, 2, WIDTH - 30, HEIGHT - 2), Point(-2.8, 1.6), Point(2.8, -1.6));
+
+	TaskPixelChainSW::Handle sub_chain = optimize(middle);
+	if (!sub_chain)
+		{ cerr << "triple: inner processors are not fused" << endl; return 1; }
+
+	TaskPixelProcessor::Handle outer_copy = TaskPixelProcessor::Handle::cast_dynamic(outer->clone());
+	outer_copy->sub_task() = sub_chain;
+	TaskPixelChainSW::Handle chain = optimize(outer_copy);
+	if (!chain || chain->processors.size() != 3)
+		{ cerr << "triple: processors are not fused" << endl; return 1; }
+	chain->target_surface = create_surface(WIDTH, HEIGHT);
+
+	Task::RunParams params;
+	inner->run(params);
+	middle->run(params);
+	outer->run(params);
+	chain->run(params);
+
+	return compare("triple", outer->target_surface, chain->target_surface);
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += pixelchain_test_pair();
+	failures += pixelchain_test_triple();
+
+	return failures;
+}
@@ -0,0 +1,284 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file transformation.cpp
+**	\brief TaskTransformationSW Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/rendering/renderer.h>
+#include <synfig/rendering/primitive/transformation.h>
+#include <synfig/rendering/common/task/tasktransformation.h>
+#include <synfig/rendering/software/surfacesw.h>
+#include <synfig/rendering/software/task/tasksw.h>
+#include <synfig/rendering/software/task/tasktransformationsw.h>
+#include <synfig/rendering/software/optimizer/optimizertransformationsw.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+#define SIZE       64
+#define PRECISION  0.05
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// smooth image, so results of different resolutions of sub-task are comparable
+Color pattern(const Point &p)
+{
+	return Color(
+		(ColorReal)(0.5 + 0.5*sin(1.3*p[0])),
+		(ColorReal)(0.5 + 0.5*cos(1.1*p[1])),
+		(ColorReal)(0.5 + 0.25*sin(p[0] + p[1])),
+		1.f );
+}
+
+// renders pattern into any target rect
+class TaskTestPatternSW: public Task, public TaskSW
+{
+public:
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	virtual bool run(RunParams & /* params */) const
+	{
+		synfig::Surface &c = SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+		const RectInt r = get_target_rect();
+		const Vector upp = get_units_per_pixel();
+		const Point lt = get_source_rect_lt();
+		for(int y = r.miny; y < r.maxy; ++y)
+			for(int x = r.minx; x < r.maxx; ++x)
+				c[y][x] = pattern(Point(
+					lt[0] + (x - r.minx + 0.5)*upp[0],
+					lt[1] + (y - r.miny + 0.5)*upp[1] ));
+		return true;
+	}
+};
+
+// perspective like in Warp, depth grows along y axis
+class TestPerspective: public Transformation
+{
+public:
+	typedef etl::handle<TestPerspective> Handle;
+
+	Real k;
+	explicit TestPerspective(Real k): k(k) { }
+
+protected:
+	virtual TransformedPoint transform_vfunc(const Point &x) const
+	{
+		Real y = x[1]/(1.0 - k*x[1]);
+		return TransformedPoint(Point(x[0]*(1.0 + k*y), y));
+	}
+
+	virtual TransformedPoint back_transform_vfunc(const Point &x) const
+	{
+		Real w = 1.0 + k*x[1];
+		return w > 0.01 ? TransformedPoint(Point(x[0]/w, x[1]/w), w, true)
+		     : TransformedPoint(Point(), w, false);
+	}
+};
+
+// rendering of Warp and Spherize by legacy accelerated_render():
+// sub-context is rendered once with the size of target multiplied by zoom_factor,
+// then each pixel is back-transformed and sampled according to quality,
+// pixels are aligned by centers here, like in TaskTransformationSW
+void render_legacy(synfig::Surface &surface, const Transformation &transformation, const Point &tl, const Point &br, int quality)
+{
+	const int w = surface.get_w(), h = surface.get_h();
+	surface.clear();
+
+	// bounds and zoom_factor by corners of target
+	Point corners[] = { tl, Point(br[0], tl[1]), Point(tl[0], br[1]), br };
+	Rect bounds;
+	Real minz = 0.0, maxz = 0.0;
+	bool init_point_set = false;
+	for(int i = 0; i < 4; ++i)
+	{
+		Transformation::TransformedPoint tp = transformation.back_transform(corners[i]);
+		if (!tp.visible) continue;
+		if (init_point_set)
+		{
+			bounds.expand(tp.p);
+			minz = min(minz, tp.depth);
+			maxz = max(maxz, tp.depth);
+		}
+		else
+		{
+			bounds = Rect(tp.p);
+			minz = maxz = tp.depth;
+		}
+		init_point_set = true;
+	}
+	if (!init_point_set) return;
+	Real zoom_factor = 1.0 + (maxz - minz);
+
+	const int tmp_d = max(w, h);
+	const int src_w = (int)ceil(tmp_d*zoom_factor);
+	const int src_h = (int)ceil(tmp_d*zoom_factor);
+	const Real src_pw = src_w/(bounds.maxx - bounds.minx);
+	const Real src_ph = src_h/(bounds.maxy - bounds.miny);
+
+	synfig::Surface source(src_w, src_h);
+	for(int y = 0; y < src_h; ++y)
+		for(int x = 0; x < src_w; ++x)
+			source[y][x] = pattern(Point(bounds.minx + (x + 0.5)/src_pw, bounds.miny + (y + 0.5)/src_ph));
+
+	const Real pw = w/(br[0] - tl[0]);
+	const Real ph = h/(br[1] - tl[1]);
+	for(int y = 0; y < h; ++y)
+	{
+		for(int x = 0; x < w; ++x)
+		{
+			Transformation::TransformedPoint tp = transformation.back_transform(
+				Point(tl[0] + (x + 0.5)/pw, tl[1] + (y + 0.5)/ph) );
+			if (!tp.visible)
+				{ surface[y][x] = Color::alpha(); continue; }
+
+			float u = (float)((tp.p[0] - bounds.minx)*src_pw - 0.5);
+			float v = (float)((tp.p[1] - bounds.miny)*src_ph - 0.5);
+			if (u < 0 || v < 0 || u >= src_w - 1 || v >= src_h - 1)
+				surface[y][x] = pattern(tp.p);
+			else
+			if (quality <= 4)
+				surface[y][x] = source.cubic_sample(u, v);
+			else
+			if (quality <= 5)
+				surface[y][x] = source.cosine_sample(u, v);
+			else
+			if (quality <= 6)
+				surface[y][x] = source.linear_sample(u, v);
+			else
+				surface[y][x] = source[(int)floor(v + 0.5)][(int)floor(u + 0.5)];
+		}
+	}
+}
+
+TaskTransformation::Handle create_task(Real k, int quality)
+{
+	TaskTransformation::Handle task(new TaskTransformation());
+	task->transformation = new TestPerspective(k);
+	task->interpolation = TaskTransformation::get_interpolation_by_quality(quality);
+	task->sub_task() = new TaskTestPatternSW();
+	task->target_surface = new SurfaceSW();
+	task->target_surface->set_size(SIZE, SIZE);
+	task->target_surface->create();
+	task->init_target_rect(RectInt(0, 0, SIZE, SIZE), Point(-1.0, -1.0), Point(1.0, 1.0));
+	return task;
+}
+
+int transformation_test_legacy(Real k, int quality)
+{
+	TaskTransformation::Handle task = create_task(k, quality);
+	Task::List list;
+	list.push_back(task);
+	if (!Renderer::get_renderer("software")->run(list))
+		{ cerr << "legacy: rendering failed" << endl; return 1; }
+
+	synfig::Surface expected(SIZE, SIZE);
+	render_legacy(expected, *task->transformation, task->get_source_rect_lt(), task->get_source_rect_rb(), quality);
+
+	const synfig::Surface &actual = SurfaceSW::Handle::cast_dynamic(task->target_surface)->get_surface();
+	for(int y = 0; y < SIZE; ++y)
+		for(int x = 0; x < SIZE; ++x)
+		{
+			const Color &a = actual[y][x];
+			const Color &e = expected[y][x];
+			if ( fabs(a.get_r() - e.get_r()) > PRECISION
+			  || fabs(a.get_g() - e.get_g()) > PRECISION
+			  || fabs(a.get_b() - e.get_b()) > PRECISION
+			  || fabs(a.get_a() - e.get_a()) > PRECISION )
+			{
+				cerr << "legacy: k " << k << ", quality " << quality
+					 << ", pixel (" << x << ", " << y << ") is ("
+					 << a.get_r() << ", " << a.get_g() << ", " << a.get_b() << ", " << a.get_a() << "), expected ("
+					 << e.get_r() << ", " << e.get_g() << ", " << e.get_b() << ", " << e.get_a() << ")" << endl;
+				return 1;
+			}
+		}
+	return 0;
+}
+
+// near the horizon the most detailed cell is much smaller than others,
+// but sub-task should not be much larger than target
+int transformation_test_size()
+{
+	const Real k = 0.95;
+	TaskTransformation::Handle task = create_task(k, 4);
+	task->update_bounds_recursive();
+
+	Task::List list;
+	Optimizer::RunParams params(*Renderer::get_renderer("software"), list, Optimizer::CATEGORY_ALL, task);
+	OptimizerTransformationSW().run(params);
+
+	TaskTransformationSW::Handle task_sw = TaskTransformationSW::Handle::cast_dynamic(params.ref_task);
+	if (!task_sw || !task_sw->sub_task() || !task_sw->sub_task()->target_surface)
+		{ cerr << "size: task is not specialized" << endl; return 1; }
+
+	// depth is in range [1 - k, 1 + k], plus border of 4 pixels from each side
+	const int max_size = (int)ceil(SIZE*(1.0 + 2.0*k)) + 8;
+	VectorInt size = task_sw->sub_task()->target_surface->get_size();
+	if (size[0] > max_size || size[1] > max_size)
+	{
+		cerr << "size: sub-task is " << size[0] << "x" << size[1]
+			 << ", expected not more than " << max_size << "x" << max_size << endl;
+		return 1;
+	}
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	if (!Renderer::subsys_init())
+	{
+		cerr << "unable to initialize renderer" << endl;
+		return 1;
+	}
+
+	int failures = 0;
+
+	int qualities[] = { 4, 5, 6, 8 };
+	for(int i = 0; i < (int)(sizeof(qualities)/sizeof(qualities[0])); ++i)
+	{
+		failures += transformation_test_legacy(0.0, qualities[i]);
+		failures += transformation_test_legacy(0.6, qualities[i]);
+	}
+	failures += transformation_test_size();
+
+	Renderer::subsys_stop();
+	return failures;
+}
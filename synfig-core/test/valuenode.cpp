@@ -0,0 +1,193 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file valuenode.cpp
+**	\brief ValueNode Constant Interval Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/canvas.h>
+#include <synfig/type.h>
+#include <synfig/layers/layer_solidcolor.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+#include <synfig/valuenodes/valuenode_const.h>
+#include <synfig/valuenodes/valuenode_linear.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+#define TIME_BEGIN  -1.0
+#define TIME_END     4.0
+#define TIME_STEP    0.01
+#define PRECISION    1e-8
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+ValueNode::Handle create_animated()
+{
+	ValueNode_Animated::Handle node = ValueNode_Animated::create(type_real);
+	node->new_waypoint(Time(0.0), ValueBase(Real(1.0)));
+	node->new_waypoint(Time(1.0), ValueBase(Real(1.0)));
+	node->new_waypoint(Time(2.0), ValueBase(Real(3.0)));
+	node->new_waypoint(Time(3.0), ValueBase(Real(3.0)));
+	return node;
+}
+
+ValueNode::Handle create_linear(Real slope)
+{
+	ValueNode_Linear::Handle node = ValueNode_Linear::create(ValueBase(Real(2.0)));
+	node->set_link("slope", ValueNode_Const::create(ValueBase(slope)));
+	return node;
+}
+
+// value must be the same at any time of the reported constant interval
+int check_constant_intervals(const string &name, const ValueNode::Handle &node)
+{
+	int failures = 0;
+	for(Real t = TIME_BEGIN; t <= TIME_END; t += 10*TIME_STEP)
+	{
+		Time begin, end;
+		node->get_constant_interval(Time(t), begin, end);
+		if (begin > Time(t) || end < Time(t))
+		{
+			cerr << name << ": interval [" << (Real)begin << ", " << (Real)end << "] doesn't contain " << t << endl;
+			++failures;
+			continue;
+		}
+
+		Real value = (*node)(Time(t)).get(Real());
+		Real b = max((Real)begin, TIME_BEGIN), e = min((Real)end, TIME_END);
+		for(Real s = b; s <= e; s += TIME_STEP)
+		{
+			if (fabs((*node)(Time(s)).get(Real()) - value) > PRECISION)
+			{
+				cerr << name << ": value at " << s << " differs from value at " << t
+					 << " but interval [" << (Real)begin << ", " << (Real)end << "] was reported" << endl;
+				++failures;
+				break;
+			}
+		}
+	}
+	return failures;
+}
+
+int valuenode_test_animated()
+{
+	int failures = 0;
+	ValueNode::Handle node = create_animated();
+	failures += check_constant_intervals("animated", node);
+
+	if (!node->is_constant(Time(TIME_BEGIN), Time(0.0)))
+		{ cerr << "animated: must be constant before first waypoint" << endl; ++failures; }
+	if (!node->is_constant(Time(3.0), Time(TIME_END)))
+		{ cerr << "animated: must be constant after last waypoint" << endl; ++failures; }
+	if (node->is_constant(Time(1.0), Time(2.0)))
+		{ cerr << "animated: must not be constant between different waypoints" << endl; ++failures; }
+
+	return failures;
+}
+
+int valuenode_test_linear()
+{
+	int failures = 0;
+	ValueNode::Handle still = create_linear(0.0);
+	ValueNode::Handle moving = create_linear(0.5);
+	failures += check_constant_intervals("linear still", still);
+	failures += check_constant_intervals("linear moving", moving);
+
+	if (!still->is_constant(Time(TIME_BEGIN), Time(TIME_END)))
+		{ cerr << "linear: must be constant with zero rate" << endl; ++failures; }
+	if (moving->is_constant(Time(0.0), Time(TIME_STEP)))
+		{ cerr << "linear: must not be constant with nonzero rate" << endl; ++failures; }
+
+	return failures;
+}
+
+// parameters of layer after set_time() must be the same
+// as with evaluation of all parameters at each time
+int valuenode_test_layer()
+{
+	int failures = 0;
+
+	ValueNode::Handle node = create_animated();
+	Layer::Handle layer = new Layer_SolidColor();
+	layer->connect_dynamic_param("amount", node);
+
+	Canvas::Handle canvas = Canvas::create();
+	canvas->push_back(layer);
+
+	// forward, backward and jumps over the whole range
+	vector<Real> times;
+	for(Real t = TIME_BEGIN; t <= TIME_END; t += TIME_STEP) times.push_back(t);
+	for(Real t = TIME_END; t >= TIME_BEGIN; t -= TIME_STEP) times.push_back(t);
+	for(Real t = TIME_BEGIN; t <= TIME_END; t += 0.37) { times.push_back(t); times.push_back(TIME_END - t); }
+
+	for(vector<Real>::const_iterator i = times.begin(); i != times.end(); ++i)
+	{
+		canvas->set_time(Time(*i));
+		Real expected = (*node)(Time(*i)).get(Real());
+		Real actual = layer->get_param("amount").get(Real());
+		if (fabs(actual - expected) > PRECISION)
+		{
+			cerr << "layer: amount at " << *i << " is " << actual << ", expected " << expected << endl;
+			++failures;
+		}
+	}
+
+	canvas->clear();
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	if (!Type::subsys_init())
+	{
+		cerr << "unable to initialize types" << endl;
+		return 1;
+	}
+
+	int failures = 0;
+
+	failures += valuenode_test_animated();
+	failures += valuenode_test_linear();
+	failures += valuenode_test_layer();
+
+	Type::subsys_stop();
+	return failures;
+}
@@ -313,6 +313,8 @@ std::set< String > studio::App::brushes_path;
 String studio::App::sequence_separator(".");
 String studio::App::navigator_renderer;
 String studio::App::workarea_renderer;
+int studio::App::preview_memory_limit=1024;
+int studio::App::frame_cache_memory_limit=256;
 
 bool studio::App::enable_mainwin_menubar = true;
 String studio::App::ui_language ("os_LANG");
@@ -626,6 +628,16 @@ public:
 				value=App::workarea_renderer;
 				return true;
 			}
+			if(key=="preview_memory_limit")
+			{
+				value=strprintf("%i",App::preview_memory_limit);
+				return true;
+			}
+			if(key=="frame_cache_memory_limit")
+			{
+				value=strprintf("%i",App::frame_cache_memory_limit);
+				return true;
+			}
 			if(key=="enable_mainwin_menubar")
 			{
 				value=strprintf("%i", (int)App::enable_mainwin_menubar);
@@ -791,6 +803,18 @@ public:
 				App::workarea_renderer=value;
 				return true;
 			}
+			if(key=="preview_memory_limit")
+			{
+				int i(atoi(value.c_str()));
+				App::preview_memory_limit=i;
+				return true;
+			}
+			if(key=="frame_cache_memory_limit")
+			{
+				int i(atoi(value.c_str()));
+				App::frame_cache_memory_limit=i;
+				return true;
+			}
 			if(key=="enable_mainwin_menubar")
 			{
 				int i(atoi(value.c_str()));
@@ -840,6 +864,8 @@ public:
 		ret.push_back("sequence_separator");
 		ret.push_back("navigator_renderer");
 		ret.push_back("workarea_renderer");
+		ret.push_back("preview_memory_limit");
+		ret.push_back("frame_cache_memory_limit");
 		ret.push_back("enable_mainwin_menubar");
 		ret.push_back("ui_handle_tooltip_flag");
 
@@ -2151,6 +2177,8 @@ App::restore_default_settings()
 	synfigapp::Main::settings().set_value("sequence_separator", ".");
 	synfigapp::Main::settings().set_value("navigator_renderer", "");
 	synfigapp::Main::settings().set_value("workarea_renderer", "");
+	synfigapp::Main::settings().set_value("pref.preview_memory_limit", "1024");
+	synfigapp::Main::settings().set_value("pref.frame_cache_memory_limit", "256");
 	synfigapp::Main::settings().set_value("pref.enable_mainwin_menubar", "1");
 	ostringstream temp;
 	temp << Duck::STRUCT_DEFAULT;
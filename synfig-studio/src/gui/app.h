@@ -232,6 +232,8 @@ public:
 	static synfig::String sequence_separator;
 	static synfig::String navigator_renderer;
 	static synfig::String workarea_renderer;
+	static int preview_memory_limit; //!< in megabytes
+	static int frame_cache_memory_limit; //!< in megabytes
 	static bool enable_mainwin_menubar;
 	static synfig::String ui_language;
 	static long ui_handle_tooltip_flag;
@@ -113,6 +113,7 @@ public:
 		set_tile_h(warm_target->get_tile_h());
 		set_canvas(warm_target->get_canvas());
 		set_quality(warm_target->get_quality());
+		set_priority(warm_target->get_priority());
 		set_alpha_mode(warm_target->get_alpha_mode());
 		set_threads(warm_target->get_threads());
 		set_clipping(warm_target->get_clipping());
@@ -133,6 +134,10 @@ public:
 	{
 		Glib::Mutex::Lock lock(mutex);
 		alive_flag=false;
+		// stop rendering tasks which are already queued,
+		// tiles are rendered by the warm target with its own cancellation
+		cancel();
+		warm_target->cancel();
 	}
 
 	virtual bool async_render_tile(synfig::RectInt rect, synfig::Context context, synfig::RendDesc tile_desc, synfig::ProgressCallback *cb=NULL)
@@ -357,6 +362,7 @@ public:
 		set_tile_h(warm_target->get_tile_h());
 		set_canvas(warm_target->get_canvas());
 		set_quality(warm_target->get_quality());
+		set_priority(warm_target->get_priority());
 		set_alpha_mode(warm_target->get_alpha_mode());
 		set_threads(warm_target->get_threads());
 		set_clipping(warm_target->get_clipping());
@@ -375,6 +381,8 @@ public:
 	{
 		Glib::Mutex::Lock lock(mutex);
 		alive_flag=false;
+		// stop rendering tasks which are already queued
+		cancel();
 	}
 	
 	virtual int next_tile(int& x, int& y)
@@ -515,6 +523,7 @@ public:
 		set_avoid_time_sync(warm_target->get_avoid_time_sync());
 		set_canvas(warm_target->get_canvas());
 		set_quality(warm_target->get_quality());
+		set_priority(warm_target->get_priority());
 		set_alpha_mode(warm_target->get_alpha_mode());
 		set_threads(warm_target->get_threads());
 		set_rend_desc(&warm_target->rend_desc());
@@ -542,6 +551,8 @@ public:
 	{
 		Glib::Mutex::Lock lock(mutex);
 		alive_flag=false;
+		// stop rendering tasks which are already queued
+		cancel();
 	}
 
 	virtual bool start_frame(synfig::ProgressCallback */*cb*/=0)
@@ -648,6 +659,7 @@ public:
 		set_avoid_time_sync(warm_target->get_avoid_time_sync());
 		set_canvas(warm_target->get_canvas());
 		set_quality(warm_target->get_quality());
+		set_priority(warm_target->get_priority());
 		set_alpha_mode(warm_target->get_alpha_mode());
 		set_rend_desc(&warm_target->rend_desc());
 		alive_flag=true;
@@ -674,6 +686,8 @@ public:
 	{
 		Glib::Mutex::Lock lock(mutex);
 		alive_flag=false;
+		// stop rendering tasks which are already queued
+		cancel();
 	}
 		
 	virtual bool put_surface(cairo_surface_t* s, ProgressCallback *cb)
@@ -59,6 +59,18 @@ namespace studio {
 
 class AsyncRenderer : public etl::shared_object, public sigc::trackable
 {
+public:
+	//! Priorities of rendering requests, rendering tasks of requests
+	//! with greater priority are taken from the render queue first
+	//! \sa synfig::Target::set_priority()
+	enum Priority
+	{
+		PRIORITY_PREFETCH = -1, //!< frames which may be shown soon
+		PRIORITY_DEFAULT  = 0,
+		PRIORITY_VISIBLE  = 1   //!< frame which is shown now
+	};
+
+private:
 	//! Signal emmited when target has been stopped or has finished
 	sigc::signal<void> signal_finished_;
 	//! Signal emmited when target has succedded
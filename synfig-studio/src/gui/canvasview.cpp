@@ -2690,6 +2690,9 @@ CanvasView::refresh_time_window()
 void
 CanvasView::on_time_changed()
 {
+	// frames following the previous time are not needed anymore
+	work_area->stop_prefetch();
+
 	Time time(get_time());
 
 	if (!is_time_equal_to_current_frame(soundProcessor.get_position(), 0.5))
@@ -3215,7 +3218,7 @@ CanvasView::on_dirty_preview()
 	{
 		IsWorking is_working(*this);
 
-		work_area->queue_render_preview();
+		work_area->queue_render_preview_changes();
 	}
 }
 
@@ -79,6 +79,8 @@ Dialog_Setup::Dialog_Setup(Gtk::Window& parent):
 	adj_gamma_b(Gtk::Adjustment::create(2.2,0.1,3.0,0.025,0.025,0.025)),
 	adj_recent_files(Gtk::Adjustment::create(15,1,50,1,1,0)),
 	adj_undo_depth(Gtk::Adjustment::create(100,10,5000,1,1,1)),
+	adj_preview_memory_limit(Gtk::Adjustment::create(1024,16,65536,16,256,0)),
+	adj_frame_cache_memory_limit(Gtk::Adjustment::create(256,16,65536,16,256,0)),
 	toggle_use_colorspace_gamma(),
 #ifdef SINGLE_THREADED
 	toggle_single_threaded(),
@@ -460,6 +462,7 @@ Dialog_Setup::create_render_page(PageInfo pi)
 	 *  sequence separator _________
 	 *   navigator [ Legacy ]
 	 *   workarea  [ Legacy ]
+	 *   preview memory limit, MB [1024]
 	 *
 	 *
 	 */
@@ -475,6 +478,14 @@ Dialog_Setup::create_render_page(PageInfo pi)
 	// Render - WorkArea
 	attach_label(pi.grid, _("WorkArea renderer"), ++row);
 	pi.grid->attach(workarea_renderer_combo, 1, row, 1, 1);
+	// Render - Preview memory limit
+	attach_label(pi.grid, _("Preview memory limit, MB"), ++row);
+	Gtk::SpinButton* preview_memory_limit_spinbutton(manage(new Gtk::SpinButton(adj_preview_memory_limit,16,0)));
+	pi.grid->attach(*preview_memory_limit_spinbutton, 1, row, 1, 1);
+	// Render - Playback cache memory limit
+	attach_label(pi.grid, _("Playback cache memory limit, MB"), ++row);
+	Gtk::SpinButton* frame_cache_memory_limit_spinbutton(manage(new Gtk::SpinButton(adj_frame_cache_memory_limit,16,0)));
+	pi.grid->attach(*frame_cache_memory_limit_spinbutton, 1, row, 1, 1);
 
 	navigator_renderer_combo.append("", _("Legacy"));
 	workarea_renderer_combo.append("", _("Legacy"));
@@ -755,6 +766,12 @@ Dialog_Setup::on_apply_pressed()
 	// Set the workarea render flag
 	App::workarea_renderer=workarea_renderer_combo.get_active_id();
 
+	// Set the memory limit of preview frames
+	App::preview_memory_limit=(int)adj_preview_memory_limit->get_value();
+
+	// Set the memory limit of playback and scrubbing frames
+	App::frame_cache_memory_limit=(int)adj_frame_cache_memory_limit->get_value();
+
 	// Set ui language
 	if (pref_modification_flag&CHANGE_UI_LANGUAGE)
 		App::ui_language = (_lang_codes[ui_language_combo.get_active_row_number()]).c_str();
@@ -1016,6 +1033,12 @@ Dialog_Setup::refresh()
 	// Refresh the status of the workarea_renderer
 	workarea_renderer_combo.set_active_id(App::workarea_renderer);
 
+	// Refresh the memory limit of preview frames
+	adj_preview_memory_limit->set_value(App::preview_memory_limit);
+
+	// Refresh the memory limit of playback and scrubbing frames
+	adj_frame_cache_memory_limit->set_value(App::frame_cache_memory_limit);
+
 	// Refresh the ui language
 
 	// refresh ui tooltip handle info
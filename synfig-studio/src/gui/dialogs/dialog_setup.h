@@ -217,6 +217,8 @@ class Dialog_Setup : public Dialog_Template
 
 	Glib::RefPtr<Gtk::Adjustment> adj_recent_files;
 	Glib::RefPtr<Gtk::Adjustment> adj_undo_depth;
+	Glib::RefPtr<Gtk::Adjustment> adj_preview_memory_limit;
+	Glib::RefPtr<Gtk::Adjustment> adj_frame_cache_memory_limit;
 
 	Gtk::CheckButton toggle_use_colorspace_gamma;
 #ifdef SINGLE_THREADED
@@ -70,6 +70,12 @@ Dialog_SpriteSheetParam::Dialog_SpriteSheetParam(Gtk::Window &parent):
 	columns_box = Gtk::manage(new Gtk::SpinButton(Gtk::Adjustment::create(0.0, 1.0,1000.0)));
 	columns_box->signal_value_changed().connect(sigc::mem_fun(*this, &Dialog_SpriteSheetParam::on_cols_change));
 
+	//Rows per page
+	Gtk::Label* page_rows_label(manage(new Gtk::Label(_("Rows per page:"))));
+	page_rows_label->set_alignment(Gtk::ALIGN_START, Gtk::ALIGN_CENTER);
+	page_rows_box = Gtk::manage(new Gtk::SpinButton(Gtk::Adjustment::create(0.0, 0.0,1000.0)));
+	page_rows_box->set_tooltip_text(_("Split the sheet into several files, 0 means single file"));
+
 	//Grid
 	Gtk::Grid* grid = Gtk::manage(new Gtk::Grid());
 	grid->attach(*check_button,0,0,2,1);
@@ -83,6 +89,8 @@ Dialog_SpriteSheetParam::Dialog_SpriteSheetParam(Gtk::Window &parent):
 	grid->attach(*rows_box,1,3,1,1);
 	grid->attach(*columns_label,2,3,1,1);
 	grid->attach(*columns_box,3,3,1,1);
+	grid->attach(*page_rows_label,0,4,1,1);
+	grid->attach(*page_rows_box,1,4,1,1);
 	grid->set_row_spacing (4);
 	grid->set_column_spacing (2);
 	grid->set_border_width(8);
@@ -107,6 +115,7 @@ Dialog_SpriteSheetParam::init()
 	columns_box->set_value(get_tparam().columns);
 	direction_box->set_active(get_tparam().dir);
 	check_button->set_active(get_tparam().append);
+	page_rows_box->set_value(get_tparam().page_rows);
 	on_dir_change(); //Update boxes
 }
 
@@ -148,6 +157,7 @@ Dialog_SpriteSheetParam::write_tparam(synfig::TargetParam & tparam_)
 	tparam_.columns = columns_box->get_value();
 	tparam_.dir = (synfig::TargetParam::Direction)direction_box->get_active_row_number ();
 	tparam_.append = check_button->get_active();
+	tparam_.page_rows = page_rows_box->get_value();
 }
 
 }
@@ -56,6 +56,7 @@ private:
 	Gtk::SpinButton * offset_y_box;
 	Gtk::SpinButton * rows_box;
 	Gtk::SpinButton * columns_box;
+	Gtk::SpinButton * page_rows_box;
 	Gtk::CheckButton * check_button;
 	Gtk::ComboBoxText * direction_box;
 
@@ -37,6 +37,8 @@
 #include "duck.h"
 #include <ETL/misc>
 
+#include <synfig/rect.h>
+
 #include <synfig/valuenodes/valuenode_bline.h>
 #include <synfig/valuenodes/valuenode_wplist.h>
 #include <synfig/valuenodes/valuenode_blinecalctangent.h>
@@ -45,6 +47,9 @@
 #include <synfig/valuenodes/valuenode_composite.h>
 
 #include <gui/localization.h>
+
+#include <cmath>
+#include <algorithm>
 #endif
 
 /* === U S I N G =========================================================== */
@@ -97,7 +102,9 @@ Duck::Duck():
 	axis_y_angle_(Angle::deg(90)),
 	axis_y_mag_(1),
 	rotations_(synfig::Angle::deg(0)),
-	aspect_point_(1,1)
+	aspect_point_(1,1),
+	index_(NULL),
+	index_slot_(-1)
 { duck_count++; _DuckCounter::counter++; }
 
 Duck::Duck(const synfig::Point &point):
@@ -121,7 +128,9 @@ Duck::Duck(const synfig::Point &point):
 	axis_y_mag_(1),
 	point_(point),
 	rotations_(synfig::Angle::deg(0)),
-	aspect_point_(1,1)
+	aspect_point_(1,1),
+	index_(NULL),
+	index_slot_(-1)
 { duck_count++; _DuckCounter::counter++;}
 
 Duck::Duck(const synfig::Point &point,const synfig::Point &origin):
@@ -145,7 +154,9 @@ Duck::Duck(const synfig::Point &point,const synfig::Point &origin):
 	axis_y_mag_(1),
 	point_(point),
 	rotations_(synfig::Angle::deg(0)),
-	aspect_point_(1,1)
+	aspect_point_(1,1),
+	index_(NULL),
+	index_slot_(-1)
 { duck_count++; _DuckCounter::counter++;}
 
 Duck::~Duck() { duck_count--; _DuckCounter::counter--;}
@@ -196,8 +207,17 @@ Duck::set_point(const synfig::Point &x)
 	if (shared_point_) *shared_point_ = point_;
 	if (shared_angle_) *shared_angle_ = point_.angle();
 	if (shared_mag_)   *shared_mag_ = point_.mag();
+	notify_moved();
 }
 
+void
+Duck::notify_moved()
+	{ if (index_) index_->mark_moved(*this); }
+
+void
+Duck::notify_relinked()
+	{ if (index_) index_->invalidate(); }
+
 //! Returns the location of the duck
 synfig::Point
 Duck::get_point()const
@@ -353,6 +373,211 @@ Duck::get_sub_trans_origin()const
 	return get_sub_trans_point(origin_duck_,origin_);
 }
 
+DuckIndex::DuckIndex(const DuckMap &duck_map):
+	duck_map(duck_map),
+	valid(false),
+	cell_size(1.0)
+{ }
+
+DuckIndex::~DuckIndex()
+	{ detach(); }
+
+DuckIndex::Cell
+DuckIndex::get_cell(const synfig::Point &x)const
+{
+	const Real limit = 1e9;
+	Real i = floor((x[0] - origin[0])/cell_size);
+	Real j = floor((x[1] - origin[1])/cell_size);
+	if (std::isnan(i)) i = limit;
+	if (std::isnan(j)) j = limit;
+	return Cell( (int)std::max(-limit, std::min(limit, i)),
+				 (int)std::max(-limit, std::min(limit, j)) );
+}
+
+int
+DuckIndex::get_slot(const Duck *duck)const
+{
+	return duck
+		&& duck->index_ == this
+		&& duck->index_slot_ >= 0
+		&& duck->index_slot_ < (int)entries.size()
+		&& entries[duck->index_slot_].duck.get() == duck
+		 ? duck->index_slot_ : -1;
+}
+
+void
+DuckIndex::detach()
+{
+	for(std::vector<Entry>::iterator i = entries.begin(); i != entries.end(); ++i)
+		if (i->duck->index_ == this)
+			{ i->duck->index_ = NULL; i->duck->index_slot_ = -1; }
+	entries.clear();
+	moved.clear();
+	cells.clear();
+}
+
+void
+DuckIndex::rebuild()
+{
+	detach();
+
+	entries.resize(duck_map.size());
+	Rect bounds;
+	bool bounds_set = false;
+	int slot = 0;
+	for(DuckMap::const_iterator i = duck_map.begin(); i != duck_map.end(); ++i, ++slot)
+	{
+		Entry &entry = entries[slot];
+		entry.duck = i->second;
+		entry.point = entry.duck->get_trans_point();
+		entry.duck->index_ = this;
+		entry.duck->index_slot_ = slot;
+		if (!entry.point.is_nan_or_inf())
+		{
+			if (bounds_set)
+				bounds.expand(entry.point);
+			else
+				{ bounds = Rect(entry.point); bounds_set = true; }
+		}
+	}
+
+	// about four ducks per cell when ducks are distributed uniformly
+	Real size = bounds_set ? std::max(bounds.maxx - bounds.minx, bounds.maxy - bounds.miny) : 0.0;
+	Real count = 0.5*sqrt((Real)entries.size());
+	origin = bounds_set ? bounds.get_min() : Point();
+	cell_size = count > 1.0 ? size/count : size;
+	if (!(cell_size > 1e-8)) cell_size = 1.0;
+
+	// place ducks and collect dependencies
+	std::map<const void*, std::vector<int> > shared;
+	for(int i = 0; i < (int)entries.size(); ++i)
+	{
+		Entry &entry = entries[i];
+		entry.cell = get_cell(entry.point);
+		cells[entry.cell].push_back(i);
+
+		const Duck &duck = *entry.duck;
+		const Duck::Handle* sources[] = {
+			&duck.get_origin_duck(),
+			&duck.get_axis_x_angle_duck(),
+			&duck.get_axis_x_mag_duck(),
+			&duck.get_axis_y_angle_duck(),
+			&duck.get_axis_y_mag_duck() };
+		for(int j = 0; j < (int)(sizeof(sources)/sizeof(sources[0])); ++j)
+		{
+			int source = get_slot(sources[j]->get());
+			if (source >= 0 && source != i)
+				entries[source].dependents.push_back(i);
+		}
+		int origin_slot = get_slot(duck.get_origin_duck().get());
+		if (origin_slot >= 0)
+			entries[origin_slot].children.push_back(i);
+
+		if (duck.get_shared_point()) shared[duck.get_shared_point().get()].push_back(i);
+		if (duck.get_shared_angle()) shared[duck.get_shared_angle().get()].push_back(i);
+		if (duck.get_shared_mag())   shared[duck.get_shared_mag().get()].push_back(i);
+	}
+
+	// ducks with the same shared value moves together
+	for(std::map<const void*, std::vector<int> >::const_iterator i = shared.begin(); i != shared.end(); ++i)
+		for(std::vector<int>::const_iterator j = i->second.begin(); j != i->second.end(); ++j)
+			for(std::vector<int>::const_iterator k = i->second.begin(); k != i->second.end(); ++k)
+				if (*j != *k)
+					entries[*j].dependents.push_back(*k);
+
+	valid = true;
+}
+
+void
+DuckIndex::refresh()
+{
+	if (!valid) { rebuild(); return; }
+
+	// reposition moved ducks and all ducks which depends on them
+	for(int i = 0; i < (int)moved.size(); ++i)
+	{
+		Entry &entry = entries[moved[i]];
+		entry.point = entry.duck->get_trans_point();
+		Cell cell = get_cell(entry.point);
+		if (cell != entry.cell)
+		{
+			std::vector<int> &old_cell = cells[entry.cell];
+			std::vector<int>::iterator j = std::find(old_cell.begin(), old_cell.end(), moved[i]);
+			if (j != old_cell.end()) { *j = old_cell.back(); old_cell.pop_back(); }
+			if (old_cell.empty()) cells.erase(entry.cell);
+			cells[cell].push_back(moved[i]);
+			entry.cell = cell;
+		}
+
+		for(std::vector<int>::const_iterator j = entry.dependents.begin(); j != entry.dependents.end(); ++j)
+			if (!entries[*j].moved)
+				{ entries[*j].moved = true; moved.push_back(*j); }
+	}
+
+	for(std::vector<int>::const_iterator i = moved.begin(); i != moved.end(); ++i)
+		entries[*i].moved = false;
+	moved.clear();
+}
+
+void
+DuckIndex::mark_moved(const Duck &duck)
+{
+	if (!valid) return;
+	int slot = get_slot(&duck);
+	if (slot >= 0 && !entries[slot].moved)
+		{ entries[slot].moved = true; moved.push_back(slot); }
+}
+
+DuckList
+DuckIndex::get_ducks_in_box(const synfig::Point &min, const synfig::Point &max)
+{
+	refresh();
+
+	DuckList ret;
+	Cell c0 = get_cell(min);
+	Cell c1 = get_cell(max);
+	Real count = ((Real)c1.first - (Real)c0.first + 1.0)*((Real)c1.second - (Real)c0.second + 1.0);
+	if (count > (Real)cells.size())
+	{
+		// box is too large, cells lookup will be slower than scan
+		for(std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+			if ( i->point[0] >= min[0] && i->point[0] <= max[0]
+			  && i->point[1] >= min[1] && i->point[1] <= max[1] )
+				ret.push_back(i->duck);
+		return ret;
+	}
+
+	for(int j = c0.second; j <= c1.second; ++j)
+	{
+		for(int i = c0.first; i <= c1.first; ++i)
+		{
+			std::map<Cell, std::vector<int> >::const_iterator cell = cells.find(Cell(i, j));
+			if (cell == cells.end()) continue;
+			for(std::vector<int>::const_iterator k = cell->second.begin(); k != cell->second.end(); ++k)
+			{
+				const Entry &entry = entries[*k];
+				if ( entry.point[0] >= min[0] && entry.point[0] <= max[0]
+				  && entry.point[1] >= min[1] && entry.point[1] <= max[1] )
+					ret.push_back(entry.duck);
+			}
+		}
+	}
+	return ret;
+}
+
+DuckList
+DuckIndex::get_origin_children(const Duck::Handle &duck)
+{
+	refresh();
+
+	DuckList ret;
+	int slot = get_slot(duck.get());
+	if (slot >= 0)
+		for(std::vector<int>::const_iterator i = entries[slot].children.begin(); i != entries[slot].children.end(); ++i)
+			ret.push_back(entries[*i].duck);
+	return ret;
+}
+
 #ifdef _DEBUG
 synfig::String
 Duck::type_name(Type id)
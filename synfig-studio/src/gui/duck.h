@@ -30,6 +30,8 @@
 /* === H E A D E R S ======================================================= */
 
 #include <list>
+#include <map>
+#include <vector>
 
 #include <ETL/smart_ptr>
 #include <ETL/handle>
@@ -81,12 +83,14 @@ public:
 
 namespace studio {
 class Duckmatic;
+class DuckIndex;
 
 /*! \class Duck
 **	\writeme */
 class Duck : public etl::shared_object
 {
 	friend class Duckmatic;
+	friend class DuckIndex;
 
 public:
 	enum Type
@@ -190,6 +194,16 @@ private:
 	synfig::Angle rotations_;
 	synfig::Point aspect_point_;
 
+	// spatial index which should be notified when duck moves
+
+	DuckIndex *index_;
+	int index_slot_;
+
+	//! Notifies index that transformed position of duck is changed
+	void notify_moved();
+	//! Notifies index that duck is linked to other ducks by another way
+	void notify_relinked();
+
 	static int duck_count;
 public:
 
@@ -264,7 +278,7 @@ public:
 	bool is_radius()const
 		{ return radius_; }
 	void set_radius(bool r)
-		{ radius_=r; }
+		{ radius_=r; notify_moved(); }
 
 	//! If set, the duck will send signal_edited while moving.
 	//! If not set, the duck will send signal_edited when button released.
@@ -314,23 +328,23 @@ public:
 	// positioning
 
 	void set_transform_stack(const synfig::TransformStack& x)
-		{ transform_stack_=x; }
+		{ transform_stack_=x; notify_moved(); }
 	const synfig::TransformStack& get_transform_stack()const
 		{ return transform_stack_; }
 
 	//! Sets the scalar multiplier for the duck with respect to the origin
 	void set_scalar(synfig::Vector::value_type n)
-		{ scalar_=n; }
+		{ scalar_=n; notify_moved(); }
 	//! Retrieves the scalar value
 	synfig::Vector::value_type get_scalar()const
 		{ return scalar_; }
 
 	//! Sets the origin point.
 	void set_origin(const synfig::Point &x)
-		{ origin_=x; origin_duck_=NULL; }
+		{ origin_=x; if (origin_duck_) { origin_duck_=NULL; notify_relinked(); } else notify_moved(); }
 	//! Sets the origin point as another duck
 	void set_origin(const Handle &x)
-		{ origin_duck_=x; }
+		{ origin_duck_=x; notify_relinked(); }
 	//! Retrieves the origin location
 	synfig::Point get_origin()const
 		{ return origin_duck_?origin_duck_->get_point():origin_; }
@@ -339,18 +353,18 @@ public:
 		{ return origin_duck_; }
 
 	void set_axis_x_angle(const synfig::Angle &a)
-		{ axis_x_angle_=a; axis_x_angle_duck_=NULL; }
+		{ axis_x_angle_=a; axis_x_angle_duck_=NULL; notify_relinked(); }
 	void set_axis_x_angle(const Handle &duck, const synfig::Angle angle = synfig::Angle::zero())
-		{ axis_x_angle_duck_=duck; axis_x_angle_=angle; }
+		{ axis_x_angle_duck_=duck; axis_x_angle_=angle; notify_relinked(); }
 	synfig::Angle get_axis_x_angle()const
 		{ return axis_x_angle_duck_?get_sub_trans_point(axis_x_angle_duck_,false).angle()+axis_x_angle_:axis_x_angle_; }
 	const Handle& get_axis_x_angle_duck()const
 		{ return axis_x_angle_duck_; }
 
 	void set_axis_x_mag(const synfig::Real &m)
-		{ axis_x_mag_=m; axis_x_mag_duck_=NULL; }
+		{ axis_x_mag_=m; axis_x_mag_duck_=NULL; notify_relinked(); }
 	void set_axis_x_mag(const Handle &duck)
-		{ axis_x_mag_duck_=duck; }
+		{ axis_x_mag_duck_=duck; notify_relinked(); }
 	synfig::Real get_axis_x_mag()const
 		{ return axis_x_mag_duck_?get_sub_trans_point(axis_x_mag_duck_,false).mag():axis_x_mag_; }
 	const Handle& get_axis_x_mag_duck()const
@@ -360,18 +374,18 @@ public:
 		{ return synfig::Point(get_axis_x_mag(), get_axis_x_angle()); }
 
 	void set_axis_y_angle(const synfig::Angle &a)
-		{ axis_y_angle_=a; axis_y_angle_duck_=NULL; }
+		{ axis_y_angle_=a; axis_y_angle_duck_=NULL; notify_relinked(); }
 	void set_axis_y_angle(const Handle &duck, const synfig::Angle angle = synfig::Angle::zero())
-		{ axis_y_angle_duck_=duck; axis_y_angle_=angle; }
+		{ axis_y_angle_duck_=duck; axis_y_angle_=angle; notify_relinked(); }
 	synfig::Angle get_axis_y_angle()const
 		{ return axis_y_angle_duck_?get_sub_trans_point(axis_y_angle_duck_,false).angle()+axis_y_angle_:axis_y_angle_; }
 	const Handle& get_axis_y_angle_duck()const
 		{ return axis_y_angle_duck_; }
 
 	void set_axis_y_mag(const synfig::Real &m)
-		{ axis_y_mag_=m; axis_y_mag_duck_=NULL; }
+		{ axis_y_mag_=m; axis_y_mag_duck_=NULL; notify_relinked(); }
 	void set_axis_y_mag(const Handle &duck)
-		{ axis_y_mag_duck_=duck; }
+		{ axis_y_mag_duck_=duck; notify_relinked(); }
 	synfig::Real get_axis_y_mag()const
 		{ return axis_y_mag_duck_?get_sub_trans_point(axis_y_mag_duck_,false).mag():axis_y_mag_; }
 	const Handle& get_axis_y_mag_duck()const
@@ -503,6 +517,64 @@ public:
 
 typedef std::list<Duck::Handle> DuckList;
 
+/*! \class DuckIndex
+**	\brief Uniform grid over the transformed positions of ducks from DuckMap.
+**
+**	Index is rebuilt lazily after invalidate(). Ducks notify the index when
+**	they are moved, so only moved ducks and ducks which depends on them
+**	(by origin, axes or shared value) are repositioned before the next query.
+*/
+class DuckIndex
+{
+public:
+	typedef std::pair<int, int> Cell;
+
+private:
+	struct Entry
+	{
+		Duck::Handle duck;
+		synfig::Point point;
+		Cell cell;
+		bool moved;
+		//! ducks which positions depends on this duck
+		std::vector<int> dependents;
+		//! ducks which uses this duck as origin
+		std::vector<int> children;
+
+		Entry(): moved(false) { }
+	};
+
+	const DuckMap &duck_map;
+
+	bool valid;
+	synfig::Point origin;
+	synfig::Real cell_size;
+
+	std::vector<Entry> entries;
+	std::vector<int> moved;
+	std::map<Cell, std::vector<int> > cells;
+
+	Cell get_cell(const synfig::Point &x)const;
+	int get_slot(const Duck *duck)const;
+	void detach();
+	void rebuild();
+	void refresh();
+
+public:
+	explicit DuckIndex(const DuckMap &duck_map);
+	~DuckIndex();
+
+	//! Index will be rebuilt before the next query
+	void invalidate() { valid = false; }
+	//! Called by Duck when its point changed
+	void mark_moved(const Duck &duck);
+
+	//! Returns ducks with transformed position inside of box (borders included)
+	DuckList get_ducks_in_box(const synfig::Point &min, const synfig::Point &max);
+	//! Returns ducks which uses the given duck as origin
+	DuckList get_origin_children(const Duck::Handle &duck);
+}; // END of class DuckIndex
+
 }; // END of namespace studio
 
 /* === E N D =============================================================== */
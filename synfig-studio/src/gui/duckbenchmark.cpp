@@ -0,0 +1,195 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file duckbenchmark.cpp
+**	\brief Benchmark of lookup of ducks by position
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+**
+** === N O T E S ===========================================================
+**
+**	Compares lookup of the closest duck under cursor (like in
+**	Duckmatic::find_duck) by scan of all ducks and by DuckIndex, for
+**	vertices with tangents attached by origin. Between hovers one vertex
+**	is dragged, so index repositions it and its tangents. Prints time per
+**	hover, and returns 1 if results differ or index is not faster than scan.
+**
+**	Usage: synfigstudio-duck-benchmark [ducks] [hovers]
+**	  ducks    count of ducks (default 50000)
+**	  hovers   count of lookups (default 1000)
+**
+** ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <ETL/clock>
+
+#include "duck.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+using namespace studio;
+
+/* === M A C R O S ========================================================= */
+
+//! size of canvas, ducks are placed inside of box (-SIZE, -SIZE) - (SIZE, SIZE)
+#define SIZE    10.0
+//! hover radius, as workarea passes it for the default zoom
+#define RADIUS  0.05
+
+/* === P R O C E D U R E S ================================================= */
+
+// simple deterministic generator, results must not depend on platform
+Real next_random(unsigned int &seed)
+{
+	seed = seed*1103515245u + 12345u;
+	return (Real)((seed >> 8) & 0xffff)/65535.0;
+}
+
+Point random_point(unsigned int &seed)
+{
+	Real x = (2.0*next_random(seed) - 1.0)*SIZE;
+	Real y = (2.0*next_random(seed) - 1.0)*SIZE;
+	return Point(x, y);
+}
+
+//! Closest duck inside of radius from the given list
+Duck::Handle find_closest(const DuckList &ducks, const Point &point)
+{
+	Real closest = RADIUS*RADIUS;
+	Duck::Handle ret;
+	for(DuckList::const_iterator i = ducks.begin(); i != ducks.end(); ++i)
+	{
+		Real dist = ((*i)->get_trans_point() - point).mag_squared();
+		if (dist <= closest)
+			{ closest = dist; ret = *i; }
+	}
+	return ret;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main(int argc, char **argv)
+{
+	int count = argc > 1 ? atoi(argv[1]) : 50000;
+	int hovers = argc > 2 ? atoi(argv[2]) : 1000;
+	if (count < 3 || hovers < 1)
+	{
+		fprintf(stderr, "usage: %s [ducks] [hovers]\n", argv[0]);
+		return 1;
+	}
+
+	// vertex with two tangents, like for each point of spline
+	unsigned int seed = 1;
+	DuckMap duck_map;
+	DuckList all_ducks;
+	std::vector<Duck::Handle> vertices;
+	for(int i = 0; i + 3 <= count; i += 3)
+	{
+		Duck::Handle vertex = new Duck(random_point(seed));
+		vertex->set_guid(GUID());
+		vertex->set_type(Duck::TYPE_VERTEX);
+		duck_map.insert(vertex);
+		all_ducks.push_back(vertex);
+		vertices.push_back(vertex);
+		for(int j = 0; j < 2; ++j)
+		{
+			Duck::Handle tangent = new Duck(random_point(seed)*0.02);
+			tangent->set_guid(GUID());
+			tangent->set_type(Duck::TYPE_TANGENT);
+			tangent->set_origin(vertex);
+			duck_map.insert(tangent);
+			all_ducks.push_back(tangent);
+		}
+	}
+
+	std::vector<Point> origins;
+	for(std::vector<Duck::Handle>::const_iterator i = vertices.begin(); i != vertices.end(); ++i)
+		origins.push_back((*i)->get_point());
+
+	std::vector<Point> points;
+	std::vector<Point> moves;
+	for(int i = 0; i < hovers; ++i)
+	{
+		points.push_back(random_point(seed));
+		moves.push_back(random_point(seed));
+	}
+
+	// all ducks are checked for each hover
+	etl::clock timer;
+	std::vector<Duck::Handle> expected;
+	timer.reset();
+	for(int i = 0; i < hovers; ++i)
+	{
+		vertices[i % vertices.size()]->set_point(moves[i]);
+		expected.push_back(find_closest(all_ducks, points[i]));
+	}
+	Real scan_time = timer();
+
+	// the same drags from the same positions
+	for(int i = 0; i < (int)vertices.size(); ++i)
+		vertices[i]->set_point(origins[i]);
+
+	// index returns only ducks near the cursor
+	DuckIndex index(duck_map);
+	timer.reset();
+	index.get_ducks_in_box(Point(), Point());
+	Real build_time = timer();
+
+	int mismatches = 0;
+	timer.reset();
+	for(int i = 0; i < hovers; ++i)
+	{
+		vertices[i % vertices.size()]->set_point(moves[i]);
+		const Point &p = points[i];
+		Duck::Handle duck = find_closest(
+			index.get_ducks_in_box(p - Vector(RADIUS, RADIUS), p + Vector(RADIUS, RADIUS)), p );
+		if (duck != expected[i])
+			++mismatches;
+	}
+	Real index_time = timer();
+
+	printf("ducks: %d, hovers: %d\n", (int)duck_map.size(), hovers);
+	printf("scan:  %f msec per hover\n", scan_time*1000.0/hovers);
+	printf("index: %f msec per hover, %f msec to build\n", index_time*1000.0/hovers, build_time*1000.0);
+	printf("speedup: %.1fx\n", index_time > 0.0 ? scan_time/index_time : 0.0);
+
+	if (mismatches)
+	{
+		fprintf(stderr, "index returned other duck than scan for %d hovers\n", mismatches);
+		return 1;
+	}
+	if (index_time >= scan_time)
+	{
+		fprintf(stderr, "index is not faster than scan\n");
+		return 1;
+	}
+	return 0;
+}
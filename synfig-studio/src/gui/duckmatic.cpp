@@ -112,6 +112,8 @@ Duckmatic::Duckmatic(etl::loose_handle<synfigapp::CanvasInterface> canvas_interf
 	canvas_interface(canvas_interface),
 	type_mask(Duck::TYPE_ALL-Duck::TYPE_WIDTH-Duck::TYPE_BONE_RECURSIVE-Duck::TYPE_WIDTHPOINT_POSITION),
 	type_mask_state(Duck::TYPE_NONE),
+	duck_index(duck_map),
+	duck_list_cache_valid_(false),
 	alternative_mode_(false),
 	lock_animation_mode_(false),
 	grid_snap(false),
@@ -147,6 +149,7 @@ Duckmatic::clear_ducks()
 
 	duck_data_share_map.clear();
 	duck_map.clear();
+	on_duck_map_changed();
 
 	//duck_list_.clear();
 	bezier_list_.clear();
@@ -310,13 +313,12 @@ Duckmatic::toggle_select_ducks_in_box(const synfig::Vector& tl,const synfig::Vec
 	vmax[1]=std::max(tl[1],br[1]);
 
 	{
-	    DuckMap::const_iterator iter;
-        for(iter=duck_map.begin();iter!=duck_map.end();++iter)
+	    const DuckList ducks(duck_index.get_ducks_in_box(vmin, vmax));
+	    DuckList::const_iterator iter;
+        for(iter=ducks.begin();iter!=ducks.end();++iter)
         {
-            Point p(iter->second->get_trans_point());
-            if(p[0]<=vmax[0] && p[0]>=vmin[0] && p[1]<=vmax[1] && p[1]>=vmin[1] &&
-               is_duck_group_selectable(iter->second))
-                toggle_select_duck(iter->second);
+            if(is_duck_group_selectable(*iter))
+                toggle_select_duck(*iter);
         }
 	}
 }
@@ -332,15 +334,12 @@ Duckmatic::select_ducks_in_box(const synfig::Vector& tl,const synfig::Vector& br
 
 //	Type type(get_type_mask());
 
-	DuckMap::const_iterator iter;
-	for(iter=duck_map.begin();iter!=duck_map.end();++iter)
+	const DuckList ducks(duck_index.get_ducks_in_box(vmin, vmax));
+	DuckList::const_iterator iter;
+	for(iter=ducks.begin();iter!=ducks.end();++iter)
 	{
-		Point p(iter->second->get_trans_point());
-		if(p[0]<=vmax[0] && p[0]>=vmin[0] && p[1]<=vmax[1] && p[1]>=vmin[1])
-		{
-			if(is_duck_group_selectable(iter->second))
-				select_duck(iter->second);
-		}
+		if(is_duck_group_selectable(*iter))
+			select_duck(*iter);
 	}
 }
 
@@ -397,27 +396,19 @@ Duckmatic::get_ducks_in_box(const synfig::Vector& tl,const synfig::Vector& br)co
     vmax[0]=std::max(tl[0],br[0]);
     vmax[1]=std::max(tl[1],br[1]);
 
-    DuckList ret;
-
 //  Type type(get_type_mask());
 
-    DuckMap::const_iterator iter;
-    for(iter=duck_map.begin();iter!=duck_map.end();++iter)
-    {
-        Point p(iter->second->get_trans_point());
-        if(p[0]<=vmax[0] && p[0]>=vmin[0] && p[1]<=vmax[1] && p[1]>=vmin[1])
-        {
-          //  if(is_duck_group_selectable(iter->second))
-            ret.push_back(iter->second);
-        }
-    }
-    return ret;
+    return duck_index.get_ducks_in_box(vmin, vmax);
 }
 
-DuckList
+const DuckList&
 Duckmatic::get_duck_list()const
 {
-	DuckList ret;
+	if (duck_list_cache_valid_)
+		return duck_list_cache_;
+
+	DuckList &ret = duck_list_cache_;
+	ret.clear();
 	DuckMap::const_iterator iter;
 	for(iter=duck_map.begin();iter!=duck_map.end();++iter) if (iter->second->get_type()&Duck::TYPE_POSITION) ret.push_back(iter->second);
 	for(iter=duck_map.begin();iter!=duck_map.end();++iter) if (iter->second->get_type()&Duck::TYPE_VERTEX  ) ret.push_back(iter->second);
@@ -427,9 +418,32 @@ Duckmatic::get_duck_list()const
 			!(iter->second->get_type()&Duck::TYPE_VERTEX) &&
 			!(iter->second->get_type()&Duck::TYPE_TANGENT))
 			ret.push_back(iter->second);
+	duck_list_cache_valid_ = true;
+	return ret;
+}
+
+DuckList
+Duckmatic::get_ducks_with_origin(const etl::handle<Duck>& origin)const
+{
+	if (origin)
+		return duck_index.get_origin_children(origin);
+
+	// ducks without origin are not tracked by index
+	DuckList ret;
+	const DuckList &ducks(get_duck_list());
+	for(DuckList::const_iterator iter=ducks.begin(); iter!=ducks.end(); ++iter)
+		if (!(*iter)->get_origin_duck())
+			ret.push_back(*iter);
 	return ret;
 }
 
+void
+Duckmatic::on_duck_map_changed()
+{
+	duck_index.invalidate();
+	duck_list_cache_valid_ = false;
+}
+
 void
 Duckmatic::unselect_duck(const etl::handle<Duck> &duck)
 {
@@ -478,9 +492,11 @@ void
 Duckmatic::update_ducks()
 {
 	Time time(get_time());
-	DuckList duck_list(get_duck_list());
 	const DuckList selected_ducks(get_selected_ducks());
+	std::set<const Duck*> selected_set;
 	DuckList::const_iterator selected_iter;
+	for (selected_iter=selected_ducks.begin(); selected_iter!=selected_ducks.end(); ++selected_iter)
+		selected_set.insert(selected_iter->get());
 	if(get_selected_bezier())
 	{
 		etl::handle<Duck> c1(get_selected_bezier()->c1);
@@ -495,6 +511,7 @@ Duckmatic::update_ducks()
 				int index(c1->get_value_desc().get_index());
 				etl::handle<Duck> origin_duck=c1->get_origin_duck();
 				// Search all the rest of ducks
+				DuckList duck_list(get_ducks_with_origin(origin_duck));
 				DuckList::iterator iter;
 				for (iter=duck_list.begin(); iter!=duck_list.end(); iter++)
 					// if the other duck has the same origin and it is tangent type
@@ -544,6 +561,7 @@ Duckmatic::update_ducks()
 				int index(c2->get_value_desc().get_index());
 				etl::handle<Duck> origin_duck=c2->get_origin_duck();
 				// Search all the rest of ducks
+				DuckList duck_list(get_ducks_with_origin(origin_duck));
 				DuckList::iterator iter;
 				for (iter=duck_list.begin(); iter!=duck_list.end(); iter++)
 					// if the other duck has the same origin and it is tangent type
@@ -615,6 +633,7 @@ Duckmatic::update_ducks()
 				ValueNode::Handle vertex_amount_value_node(bline_vertex->get_link("amount"));
 				duck->set_point(point);
 
+				DuckList duck_list(get_ducks_with_origin(duck));
 				DuckList::iterator iter;
 				for (iter=duck_list.begin(); iter!=duck_list.end(); iter++)
 				{
@@ -679,6 +698,7 @@ Duckmatic::update_ducks()
 						int index(duck->get_value_desc().get_index());
 						etl::handle<Duck> origin_duck=duck->get_origin_duck();
 						// Search all the rest of ducks
+						DuckList duck_list(get_ducks_with_origin(origin_duck));
 						DuckList::iterator iter;
 						for (iter=duck_list.begin(); iter!=duck_list.end(); iter++)
 						{
@@ -692,12 +712,7 @@ Duckmatic::update_ducks()
 								{
 									// Check if the other tangent is also selected, in that case
 									// it is going to be moved itself so don't update it.
-									bool selected=false;
-									DuckList::const_iterator iter2;
-									for(iter2=selected_ducks.begin(); iter2!=selected_ducks.end(); ++iter2)
-										if(*iter == *iter2)
-											selected=true;
-									if(!selected)
+									if(!selected_set.count(iter->get()))
 									{
 										BLinePoint bp=(*composite)(time).get(BLinePoint());
 										int t1_index=composite->get_link_index_from_name("t1");
@@ -914,6 +929,9 @@ Duckmatic::signal_user_click_selected_ducks(int button)
 void
 Duckmatic::signal_edited_duck(const etl::handle<Duck> &duck, bool moving)
 {
+    // edited values may move ducks of other layers
+    duck_index.invalidate();
+
     if (moving && !duck->get_edit_immediatelly()) return;
 
     if (duck->get_type() == Duck::TYPE_ANGLE)
@@ -1168,6 +1186,7 @@ Duckmatic::add_duck(const etl::handle<Duck> &duck)
         }
 
         duck_map.insert(duck);
+        on_duck_map_changed();
     }
 
     last_duck_guid=duck->get_guid();
@@ -1230,6 +1249,7 @@ void
 Duckmatic::erase_duck(const etl::handle<Duck> &duck)
 {
     duck_map.erase(duck->get_guid());
+    on_duck_map_changed();
 }
 
 etl::handle<Duckmatic::Duck>
@@ -1309,11 +1329,13 @@ Duckmatic::find_duck(synfig::Point point, synfig::Real radius, Duck::Type type)
     etl::handle<Duck> ret;
     std::vector< etl::handle<Duck> > ret_vector;
 
-    DuckMap::const_iterator iter;
+    // only ducks inside of radius may be returned
+    const DuckList ducks(duck_index.get_ducks_in_box(point - Vector(radius, radius), point + Vector(radius, radius)));
+    DuckList::const_iterator iter;
 
-    for(iter=duck_map.begin();iter!=duck_map.end();++iter)
+    for(iter=ducks.begin();iter!=ducks.end();++iter)
     {
-        const Duck::Handle& duck(iter->second);
+        const Duck::Handle& duck(*iter);
 
         if(duck->get_ignore() ||
            (duck->get_type() && !(type & duck->get_type())))
@@ -3273,6 +3295,7 @@ void
 Duckmatic::Push::restore()
 {
 	duckmatic_->duck_map=duck_map;
+	duckmatic_->on_duck_map_changed();
 	duckmatic_->bezier_list_=bezier_list_;
 	duckmatic_->duck_data_share_map=duck_data_share_map;
 	duckmatic_->stroke_list_=stroke_list_;
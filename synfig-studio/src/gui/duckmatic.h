@@ -193,6 +193,13 @@ private:
 
 	DuckMap duck_map;
 
+	//! Spatial index over duck_map for fast lookup of ducks by position
+	mutable DuckIndex duck_index;
+
+	//! Ordered list of ducks returned by get_duck_list()
+	mutable DuckList duck_list_cache_;
+	mutable bool duck_list_cache_valid_;
+
 	DuckDataMap duck_data_share_map;
 
 	std::list<etl::handle<Stroke> > stroke_list_;
@@ -233,6 +240,9 @@ private:
 	bool alternative_mode_;
 	bool lock_animation_mode_;
 
+	//! Should be called when set of ducks in duck_map is changed
+	void on_duck_map_changed();
+
 	/*
  -- ** -- P R O T E C T E D   D A T A -----------------------------------------
 	*/
@@ -344,12 +354,16 @@ public:
 	bool get_axis_lock()const { return axis_lock; }
 	void set_axis_lock(bool x) { axis_lock=x; }
 
-	void set_time(synfig::Time x) { cur_time=x; }
+	void set_time(synfig::Time x) { cur_time=x; duck_index.invalidate(); }
 
 	bool is_duck_group_selectable(const etl::handle<Duck>& x)const;
 
 	//const DuckMap& duck_map()const { return duck_map; }
-	DuckList get_duck_list()const;
+	//! Returns ordered list of ducks, it's valid until ducks are added or removed
+	const DuckList& get_duck_list()const;
+
+	//! Returns ducks which uses the given duck as origin
+	DuckList get_ducks_with_origin(const etl::handle<Duck>& origin)const;
 
 	const std::list<etl::handle<Bezier> >& bezier_list()const { return bezier_list_; }
 
@@ -0,0 +1,227 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file packedimage.cpp
+**	\brief Compressed images of rendered frames
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include <zlib.h>
+
+#include "packedimage.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace studio;
+
+/* === M A C R O S ========================================================= */
+
+#define PACKED_IMAGE_COMPRESSION_LEVEL Z_BEST_SPEED
+
+/* === M E T H O D S ======================================================= */
+
+void
+PackedImage::clear()
+{
+	width = height = pixel_size = 0;
+	std::vector<unsigned char>().swap(data);
+}
+
+void
+PackedImage::swap(PackedImage &other)
+{
+	std::swap(width, other.width);
+	std::swap(height, other.height);
+	std::swap(pixel_size, other.pixel_size);
+	data.swap(other.data);
+}
+
+void
+PackedImage::pack(const unsigned char *pixels, int width, int height, int pixel_size, int rowstride)
+{
+	clear();
+	if (!pixels || width <= 0 || height <= 0 || pixel_size <= 0)
+		return;
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	if (deflateInit(&stream, PACKED_IMAGE_COMPRESSION_LEVEL) != Z_OK)
+		return;
+
+	int row_size = width*pixel_size;
+	std::vector<unsigned char> row(row_size);
+	std::vector<unsigned char> out(row_size*height/4 + 64);
+	stream.next_out = &out.front();
+	stream.avail_out = (uInt)out.size();
+
+	int status = Z_OK;
+	for(int y = 0; y < height && status == Z_OK; ++y)
+	{
+		const unsigned char *p = pixels + y*rowstride;
+		memcpy(&row.front(), p, pixel_size);
+		for(int i = pixel_size; i < row_size; ++i)
+			row[i] = (unsigned char)(p[i] - p[i - pixel_size]);
+
+		stream.next_in = &row.front();
+		stream.avail_in = (uInt)row_size;
+		int flush = y + 1 < height ? Z_NO_FLUSH : Z_FINISH;
+		do
+		{
+			if (!stream.avail_out)
+			{
+				size_t used = out.size();
+				out.resize(used*2);
+				stream.next_out = &out[used];
+				stream.avail_out = (uInt)(out.size() - used);
+			}
+			status = deflate(&stream, flush);
+		} while(status == Z_OK && (stream.avail_in || flush == Z_FINISH));
+	}
+
+	size_t size = stream.total_out;
+	deflateEnd(&stream);
+	if (status != Z_STREAM_END)
+		return;
+
+	this->width = width;
+	this->height = height;
+	this->pixel_size = pixel_size;
+	std::vector<unsigned char>(out.begin(), out.begin() + size).swap(data); // shrink to fit
+}
+
+bool
+PackedImage::unpack(unsigned char *pixels, int rowstride) const
+{
+	if (empty() || data.empty())
+		return false;
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	stream.next_in = (Bytef*)&data.front();
+	stream.avail_in = (uInt)data.size();
+	if (inflateInit(&stream) != Z_OK)
+		return false;
+
+	int row_size = width*pixel_size;
+	int status = Z_OK;
+	for(int y = 0; y < height && status == Z_OK; ++y)
+	{
+		unsigned char *p = pixels + y*rowstride;
+		stream.next_out = p;
+		stream.avail_out = (uInt)row_size;
+		status = inflate(&stream, Z_NO_FLUSH);
+		if (stream.avail_out || (status == Z_STREAM_END && y + 1 < height))
+			status = Z_DATA_ERROR;
+		if (status != Z_OK && status != Z_STREAM_END)
+			break;
+		for(int i = pixel_size; i < row_size; ++i)
+			p[i] = (unsigned char)(p[i] + p[i - pixel_size]);
+	}
+
+	// end of stream may be not reached yet when output is exactly full,
+	// and there should be no extra data
+	if (status == Z_OK)
+	{
+		unsigned char extra;
+		stream.next_out = &extra;
+		stream.avail_out = 1;
+		status = inflate(&stream, Z_FINISH);
+		if (!stream.avail_out)
+			status = Z_DATA_ERROR;
+	}
+
+	inflateEnd(&stream);
+	return status == Z_STREAM_END && !stream.avail_in;
+}
+
+bool
+PackedImage::pack(const Glib::RefPtr<Gdk::Pixbuf> &pixbuf)
+{
+	clear();
+	if ( !pixbuf
+	  || pixbuf->get_colorspace() != Gdk::COLORSPACE_RGB
+	  || pixbuf->get_bits_per_sample() != 8
+	  || pixbuf->get_n_channels() != (pixbuf->get_has_alpha() ? 4 : 3) )
+		return false;
+	pack( pixbuf->get_pixels(),
+		  pixbuf->get_width(),
+		  pixbuf->get_height(),
+		  pixbuf->get_n_channels(),
+		  pixbuf->get_rowstride() );
+	return true;
+}
+
+bool
+PackedImage::pack(cairo_surface_t *surface)
+{
+	clear();
+	if ( !surface
+	  || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE
+	  || ( cairo_image_surface_get_format(surface) != CAIRO_FORMAT_ARGB32
+	    && cairo_image_surface_get_format(surface) != CAIRO_FORMAT_RGB24 ) )
+		return false;
+	cairo_surface_flush(surface);
+	pack( cairo_image_surface_get_data(surface),
+		  cairo_image_surface_get_width(surface),
+		  cairo_image_surface_get_height(surface),
+		  4,
+		  cairo_image_surface_get_stride(surface) );
+	return true;
+}
+
+Glib::RefPtr<Gdk::Pixbuf>
+PackedImage::unpack_pixbuf() const
+{
+	if (empty() || (pixel_size != 3 && pixel_size != 4))
+		return Glib::RefPtr<Gdk::Pixbuf>();
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf = Gdk::Pixbuf::create(
+		Gdk::COLORSPACE_RGB, pixel_size == 4, 8, width, height );
+	if (!pixbuf || !unpack(pixbuf->get_pixels(), pixbuf->get_rowstride()))
+		return Glib::RefPtr<Gdk::Pixbuf>();
+	return pixbuf;
+}
+
+cairo_surface_t*
+PackedImage::unpack_surface() const
+{
+	if (empty() || pixel_size != 4)
+		return NULL;
+	cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+	if (cairo_surface_status(surface))
+		{ cairo_surface_destroy(surface); return NULL; }
+	cairo_surface_flush(surface);
+	if (!unpack(cairo_image_surface_get_data(surface), cairo_image_surface_get_stride(surface)))
+		{ cairo_surface_destroy(surface); return NULL; }
+	cairo_surface_mark_dirty(surface);
+	return surface;
+}
+
+/* === E N T R Y P O I N T ================================================= */
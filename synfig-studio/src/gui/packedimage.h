@@ -0,0 +1,88 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file packedimage.h
+**	\brief Compressed images of rendered frames
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_STUDIO_PACKEDIMAGE_H
+#define __SYNFIG_STUDIO_PACKEDIMAGE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <cstddef>
+#include <vector>
+
+#include <cairo.h>
+#include <gdkmm/pixbuf.h>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace studio {
+
+//! Losslessly compressed image, keeps many rendered frames in memory
+//! (see Preview and WorkAreaFrameCache). Each byte of row is replaced by
+//! difference with the same channel of the previous pixel (like PNG 'Sub' filter),
+//! so gradients become runs, and result is compressed by zlib at the fastest level.
+class PackedImage
+{
+private:
+	int width;
+	int height;
+	int pixel_size;
+	std::vector<unsigned char> data;
+
+public:
+	PackedImage(): width(), height(), pixel_size() { }
+
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+	int get_pixel_size() const { return pixel_size; }
+	bool empty() const { return width <= 0 || height <= 0; }
+	//! Returns count of bytes of compressed data
+	size_t get_size() const { return data.capacity(); }
+
+	void clear();
+	void swap(PackedImage &other);
+
+	void pack(const unsigned char *pixels, int width, int height, int pixel_size, int rowstride);
+	//! Returns false if data is corrupted
+	bool unpack(unsigned char *pixels, int rowstride) const;
+
+	//! Packs 8-bit RGB or RGBA pixbuf, returns false for other formats
+	bool pack(const Glib::RefPtr<Gdk::Pixbuf> &pixbuf);
+	//! Packs ARGB32 or RGB24 image surface, returns false for other surfaces
+	bool pack(cairo_surface_t *surface);
+
+	//! Returns new pixbuf, or empty pointer if nothing was packed
+	Glib::RefPtr<Gdk::Pixbuf> unpack_pixbuf() const;
+	//! Returns new ARGB32 surface, or NULL if nothing was packed
+	cairo_surface_t* unpack_surface() const;
+};
+
+}; // END of namespace studio
+
+/* === E N D =============================================================== */
+
+#endif
@@ -71,10 +71,17 @@ using namespace studio;
 
 /* === M A C R O S ========================================================= */
 
+#define PREVIEW_MAX_PACK_THREADS 4
+
 /* === G L O B A L S ======================================================= */
 
 /* === P R O C E D U R E S ================================================= */
 
+static void free_guint8(const guint8 *mem)
+{
+	free((void*)mem);
+}
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -110,15 +117,17 @@ public:
 			return false;
 		}
 		FlipbookElem	fe;
-		Preview pr = *prev;
 		float time = get_canvas()->get_time();
 		fe.t = time;
-		fe.surface=cairo_surface_reference(surf);
-		prev->push_back(fe);
+		//frame will be compressed in background to keep long previews in memory
+		fe.frame = new Frame(time, surf);
+		bool added = prev->add_frame(fe.frame);
+		if (added)
+			prev->push_back(fe);
 		prev->signal_changed()();
 		
 		cairo_surface_destroy(surf);
-		return true;
+		return added;
 	}
 };
 
@@ -199,6 +208,110 @@ public:
 	}
 };
 
+studio::Preview::Frame::Frame(float t, const Glib::RefPtr<Gdk::Pixbuf> &buf):
+	t(t),
+	buf(buf),
+	surface(NULL)
+{ }
+
+studio::Preview::Frame::Frame(float t, cairo_surface_t *surface):
+	t(t),
+	surface(cairo_surface_reference(surface))
+{ }
+
+studio::Preview::Frame::~Frame()
+{
+	if (surface)
+		cairo_surface_destroy(surface);
+}
+
+size_t
+studio::Preview::Frame::get_unpacked_size() const
+{
+	// call with locked mutex
+	if (buf)
+		return (size_t)buf->get_rowstride()*buf->get_height();
+	if (surface)
+		return (size_t)cairo_image_surface_get_stride(surface)*cairo_image_surface_get_height(surface);
+	return 0;
+}
+
+Glib::RefPtr<Gdk::Pixbuf>
+studio::Preview::Frame::get_pixbuf() const
+{
+	Glib::Mutex::Lock lock(mutex);
+	if (buf || surface || packed.empty() || packed.get_pixel_size() != 3)
+		return buf;
+
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf = packed.unpack_pixbuf();
+	if (!pixbuf)
+		synfig::error("Preview: corrupted frame data");
+	return pixbuf;
+}
+
+cairo_surface_t*
+studio::Preview::Frame::get_surface() const
+{
+	Glib::Mutex::Lock lock(mutex);
+	if (surface)
+		return cairo_surface_reference(surface);
+	if (buf || packed.empty() || packed.get_pixel_size() != 4)
+		return NULL;
+
+	cairo_surface_t *unpacked = packed.unpack_surface();
+	if (!unpacked)
+		synfig::error("Preview: corrupted frame data");
+	return unpacked;
+}
+
+size_t
+studio::Preview::Frame::pack()
+{
+	Glib::RefPtr<Gdk::Pixbuf> src_buf;
+	cairo_surface_t *src_surface = NULL;
+	size_t size;
+	{
+		Glib::Mutex::Lock lock(mutex);
+		src_buf = buf;
+		src_surface = surface ? cairo_surface_reference(surface) : NULL;
+		size = get_unpacked_size();
+	}
+
+	// image is not modified anymore, so it can be read without lock
+	PackedImage image;
+	bool success = src_buf ? image.pack(src_buf) : src_surface ? image.pack(src_surface) : false;
+
+	Glib::Mutex::Lock lock(mutex);
+	if (src_surface)
+		cairo_surface_destroy(src_surface);
+	if (!success || buf != src_buf || surface != src_surface || image.get_size() >= size)
+		return 0; // released while packing or not compressible
+	packed.swap(image);
+	buf.clear();
+	if (surface)
+		cairo_surface_destroy(surface);
+	surface = NULL;
+	return size - packed.get_size();
+}
+
+void
+studio::Preview::Frame::release()
+{
+	Glib::Mutex::Lock lock(mutex);
+	buf.clear();
+	if (surface)
+		cairo_surface_destroy(surface);
+	surface = NULL;
+	packed.clear();
+}
+
+size_t
+studio::Preview::Frame::get_memory_size() const
+{
+	Glib::Mutex::Lock lock(mutex);
+	return buf || surface ? get_unpacked_size() : packed.get_size();
+}
+
 studio::Preview::Preview(const studio::CanvasView::LooseHandle &h, float zoom, float f):
 	canvasview(h),
 	zoom(zoom),
@@ -209,7 +322,11 @@ studio::Preview::Preview(const studio::CanvasView::LooseHandle &h, float zoom, f
 	overend(false),
 	use_cairo(),
 	quality(),
-	global_fps()
+	global_fps(),
+	memory_used(),
+	packing(),
+	memory_full(false),
+	pack_stop(false)
 { }
 
 void studio::Preview::set_canvasview(const studio::CanvasView::LooseHandle &h)
@@ -231,9 +348,103 @@ void studio::Preview::set_canvasview(const studio::CanvasView::LooseHandle &h)
 
 studio::Preview::~Preview()
 {
+	stop_pack_threads();
 	signal_destroyed_(this); //tell anything that attached to us, we're dying
 }
 
+void studio::Preview::stop_pack_threads()
+{
+	{
+		Glib::Mutex::Lock lock(pack_mutex);
+		pack_stop = true;
+		pack_queue.clear();
+		pack_cond.broadcast();
+		pack_done_cond.broadcast();
+	}
+	while(!pack_threads.empty())
+	{
+		pack_threads.front()->join();
+		pack_threads.pop_front();
+	}
+	pack_stop = false;
+}
+
+void studio::Preview::pack_thread()
+{
+	Glib::Mutex::Lock lock(pack_mutex);
+	while(true)
+	{
+		while(!pack_stop && pack_queue.empty())
+			pack_cond.wait(pack_mutex);
+		if (pack_stop)
+			break;
+
+		etl::handle<Frame> frame = pack_queue.front();
+		pack_queue.pop_front();
+		++packing;
+
+		lock.release();
+		size_t freed = frame->pack();
+		lock.acquire();
+
+		// frames may be cleared while packing
+		--packing;
+		memory_used = freed < memory_used ? memory_used - freed : 0;
+		pack_done_cond.broadcast();
+	}
+}
+
+bool studio::Preview::add_frame(const etl::handle<Frame> &frame)
+{
+	Glib::Mutex::Lock lock(pack_mutex);
+	if (memory_full)
+		return false;
+
+	if (pack_threads.empty())
+	{
+		int count = std::max(1, std::min(PREVIEW_MAX_PACK_THREADS, (int)g_get_num_processors() - 1));
+		for(int i = 0; i < count; ++i)
+			pack_threads.push_back(
+				Glib::Thread::create(sigc::mem_fun(*this, &Preview::pack_thread), true) );
+	}
+
+	// size of compressed frames is known only after packing,
+	// so wait for packing before deciding that memory is over
+	size_t limit = (size_t)std::max(1, App::preview_memory_limit)*1024*1024;
+	size_t size = frame->get_memory_size();
+	while(!pack_stop && memory_used + size > limit && (packing || !pack_queue.empty()))
+		pack_done_cond.wait(pack_mutex);
+
+	// frames are never dropped from the middle of preview,
+	// instead rendering stops at the last frame which fits
+	if (memory_used >= limit && !stored_frames.empty())
+	{
+		memory_full = true;
+		synfig::warning("Preview: memory limit of %d MB is reached, rendering stopped", App::preview_memory_limit);
+		Glib::signal_timeout().connect(sigc::mem_fun(*this, &Preview::stop_rendering), 0);
+		return false;
+	}
+
+	memory_used += size;
+	stored_frames.push_back(frame);
+	pack_queue.push_back(frame);
+	pack_cond.signal();
+	return true;
+}
+
+bool studio::Preview::stop_rendering()
+{
+	if (renderer)
+		renderer->stop();
+	return false;
+}
+
+bool studio::Preview::is_memory_full() const
+{
+	Glib::Mutex::Lock lock(pack_mutex);
+	return memory_full;
+}
+
 void studio::Preview::render()
 {
 	if(canvasview)
@@ -297,7 +508,7 @@ void studio::Preview::render()
 		target->set_rend_desc(&desc);
 
 		//... first we must clear our current selves of space
-		frames.resize(0);
+		clear();
 
 		//now tell it to go... with inherited prog. reporting...
 		if(renderer) renderer->stop();
@@ -309,14 +520,17 @@ void studio::Preview::render()
 void studio::Preview::clear()
 {
 	frames.clear();
-}
 
-
-static void free_guint8(const guint8 *mem)
-{
-	free((void*)mem);
+	Glib::Mutex::Lock lock(pack_mutex);
+	pack_queue.clear();
+	for(std::deque<etl::handle<Frame> >::iterator i = stored_frames.begin(); i != stored_frames.end(); ++i)
+		(*i)->release();
+	stored_frames.clear();
+	memory_used = 0;
+	memory_full = false;
 }
 
+
 void studio::Preview::frame_finish(const Preview_Target *targ)
 {
 	//copy image with time to next frame (can just push back)
@@ -345,7 +559,7 @@ void studio::Preview::frame_finish(const Preview_Target *targ)
 	fe.t = time;
 	//uses and manages the memory for the buffer...
 	//synfig::warning("Create a pixmap...");
-	fe.buf =
+	Glib::RefPtr<Gdk::Pixbuf> buf =
 	Gdk::Pixbuf::create_from_data(
 		buffer,	// pointer to the data
 		Gdk::COLORSPACE_RGB, // the colorspace
@@ -357,9 +571,13 @@ void studio::Preview::frame_finish(const Preview_Target *targ)
 		sigc::ptr_fun(free_guint8)
 	);
 
+	//frame will be compressed in background to keep long previews in memory
+	fe.frame = new Frame(time, buf);
+
 	//add the flipbook element to the list (assume time is correct)
 	//synfig::info("Prev: Adding %f s to the list", time);
-	frames.push_back(fe);
+	if (add_frame(fe.frame))
+		frames.push_back(fe);
 
 	signal_changed()();
 }
@@ -691,16 +909,24 @@ void studio::Widget_Preview::update()
 				synfig::error("i == end....");
 				//assert(0);
 				currentbuf.clear();
+				currentframe.reset();
+				if(current_surface)
+					cairo_surface_destroy(current_surface);
 				current_surface=NULL;
 				currentindex = 0;
 				timedisp = -1;
 			}else
 			{
-				currentbuf = i->buf;
+				//decompress only when frame is changed
+				if (!i->frame || i->frame != currentframe || (!currentbuf && !current_surface))
+				{
+					currentbuf = i->get_pixbuf();
+					if(current_surface)
+						cairo_surface_destroy(current_surface);
+					current_surface = i->get_surface();
+				}
+				currentframe = i->frame;
 				currentindex = i-beg;
-				if(current_surface)
-					cairo_surface_destroy(current_surface);
-				current_surface= cairo_surface_reference(i->surface);
 				if(timedisp != i->t)
 				{
 					timedisp = i->t;
@@ -1014,9 +1240,12 @@ void studio::Widget_Preview::set_preview(etl::handle<Preview>	prev)
 
 void studio::Widget_Preview::whenupdated()
 {
-	l_lasttime.set_text((Time((double)(--preview->end())->t)
-							.round(preview->get_global_fps())
-							.get_string(preview->get_global_fps(),App::get_time_format())));
+	String lasttime = Time((double)(--preview->end())->t)
+					  .round(preview->get_global_fps())
+					  .get_string(preview->get_global_fps(),App::get_time_format());
+	if (preview->is_memory_full())
+		lasttime += String(" ") + _("(preview memory limit is reached)");
+	l_lasttime.set_text(lasttime);
 	update();
 }
 
@@ -1174,6 +1403,7 @@ void studio::Widget_Preview::eraseall()
 	stoprender();
 
 	currentbuf.clear();
+	currentframe.reset();
 	if(current_surface)
 		cairo_surface_destroy(current_surface);
 	current_surface=NULL;
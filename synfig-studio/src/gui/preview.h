@@ -49,9 +49,14 @@
 
 #include "widgets/widget_sound.h"
 #include "dials/jackdial.h"
+#include "packedimage.h"
 
+#include <deque>
+#include <list>
 #include <vector>
 
+#include <glibmm/thread.h>
+
 #ifdef WITH_JACK
 #include <jack/jack.h>
 #include <jack/transport.h>
@@ -71,17 +76,58 @@ class AsyncRenderer;
 class Preview : public sigc::trackable, public etl::shared_object
 {
 public:
+	//! Rendered frame, it is compressed by worker threads to save memory
+	//! and decompressed on playback
+	class Frame : public etl::shared_object
+	{
+	private:
+		mutable Glib::Mutex mutex;
+		float t;
+		Glib::RefPtr<Gdk::Pixbuf> buf;
+		cairo_surface_t *surface;
+		PackedImage packed;
+
+		size_t get_unpacked_size() const;
+
+	public:
+		Frame(float t, const Glib::RefPtr<Gdk::Pixbuf> &buf);
+		Frame(float t, cairo_surface_t *surface);
+		~Frame();
+
+		float get_time() const { return t; }
+
+		//! Returns the frame image, or empty pointer if frame was released
+		//! or it was rendered by cairo
+		Glib::RefPtr<Gdk::Pixbuf> get_pixbuf() const;
+		//! Returns new reference to the frame surface, or NULL if frame was released
+		//! or it was not rendered by cairo
+		cairo_surface_t* get_surface() const;
+
+		//! Compresses pixels of frame and releases the uncompressed image,
+		//! returns count of released bytes
+		size_t pack();
+		//! Releases pixels of frame
+		void release();
+
+		size_t get_memory_size() const;
+	};
+
 	class FlipbookElem
 	{
 	public:
 		float t;
 		Glib::RefPtr<Gdk::Pixbuf> buf; //at whatever resolution they are rendered at (resized at run time)
+		etl::handle<Frame> frame; //used instead of buf and surface when frame is stored compressed
 		cairo_surface_t* surface;
 		FlipbookElem(): t(), surface(NULL) { }
 		//Copy constructor
-		FlipbookElem(const FlipbookElem& other): t(other.t) ,buf(other.buf), surface(cairo_surface_reference(other.surface))
+		FlipbookElem(const FlipbookElem& other): t(other.t) ,buf(other.buf), frame(other.frame), surface(cairo_surface_reference(other.surface))
 		{
 		}
+
+		Glib::RefPtr<Gdk::Pixbuf> get_pixbuf() const { return frame ? frame->get_pixbuf() : buf; }
+		//! Returns new reference to surface, or NULL
+		cairo_surface_t* get_surface() const { return frame ? frame->get_surface() : cairo_surface_reference(surface); }
 		~FlipbookElem()
 		{
 			if(surface)
@@ -110,6 +156,24 @@ private:
 
 	float	global_fps;
 
+	//frames compression
+	mutable Glib::Mutex pack_mutex;
+	Glib::Cond pack_cond;
+	Glib::Cond pack_done_cond;
+	std::list<Glib::Thread*> pack_threads;
+	std::deque<etl::handle<Frame> > pack_queue;
+	std::deque<etl::handle<Frame> > stored_frames;
+	size_t	memory_used;
+	int		packing; //count of frames which are being packed now
+	bool	memory_full;
+	bool	pack_stop;
+
+	void pack_thread();
+	void stop_pack_threads();
+	//! Returns false and drops the frame when preview memory limit is reached
+	bool add_frame(const etl::handle<Frame> &frame);
+	bool stop_rendering();
+
 	//expose the frame information etc.
 	class Preview_Target;
 	class Preview_Target_Cairo;
@@ -190,6 +254,9 @@ public:
 	
 	unsigned int				numframes() const  {return frames.size();}
 
+	//! Returns true when rendering was stopped because of preview memory limit
+	bool is_memory_full() const;
+
 	void render();
 
 	sigc::signal0<void>	&signal_changed() { return sig_changed; }
@@ -204,6 +271,7 @@ class Widget_Preview : public Gtk::Table
 	Gtk::ScrolledWindow	preview_window;
 	//Glib::RefPtr<Gdk::GC>		gc_area;
 	Glib::RefPtr<Gdk::Pixbuf>	currentbuf;
+	etl::handle<Preview::Frame>	currentframe;
 	cairo_surface_t* 	current_surface;
 	int					currentindex;
 	//double			timeupdate;
@@ -385,7 +385,7 @@ StateWidth_Context::AdjustWidth(handle<Duckmatic::Bezier> c, float t, Real mult,
 	handle<Duck>	w1,w2;
 	//find w1,w2
 	{
-		const DuckList dl = get_work_area()->get_duck_list();
+		const DuckList &dl = get_work_area()->get_duck_list();
 		DuckList::const_iterator i = dl.begin();
 		for(;i != dl.end(); ++i)
 		{
@@ -452,7 +452,7 @@ StateWidth_Context::AdjustWidth(handle<Duckmatic::Bezier> c, float t, Real mult,
 		// the position is based on the index and the bezier size
 		p1_pos = Real(p1_i)*bezier_size;
 		// find all the widthpoints
-		const DuckList dl = get_work_area()->get_duck_list();
+		const DuckList &dl = get_work_area()->get_duck_list();
 		DuckList::const_iterator i = dl.begin();
 		for(;i != dl.end(); ++i)
 		{
@@ -41,10 +41,13 @@
 #include <gtkmm/scrollbar.h>
 #include <gtkmm/window.h>
 
+#include <algorithm>
 #include <cmath>
 #include <ETL/misc>
 
 #include <synfig/debug/debugsurface.h>
+#include <synfig/loadcanvas.h>
+#include <synfig/savecanvas.h>
 #include <synfig/target_scanline.h>
 #include <synfig/target_tile.h>
 #include <synfig/target_cairo.h>
@@ -58,6 +61,8 @@
 #include "widgets/widget_color.h"
 #include <synfig/distance.h>
 #include <synfig/context.h>
+#include <synfig/layers/layer_composite.h>
+#include <synfig/layers/layer_pastecanvas.h>
 
 #include "workarearenderer/workarearenderer.h"
 #include "workarearenderer/renderer_background.h"
@@ -91,9 +96,223 @@ using namespace studio;
 #define stratoi(X) (atoi((X).c_str()))
 #endif
 
+//! progressive preview is skipped if the full quality rendering is faster than this (in seconds)
+#define PREVIEW_MIN_RENDER_TIME 0.1
+//! quality of the progressive preview, blur and motion blur are simplified
+#define PREVIEW_QUALITY 10
+//! count of frames following the current one, which are rendered into cache while work area is idle
+#define FRAME_CACHE_PREFETCH_FRAMES 24
+
 
 /* === G L O B A L S ======================================================= */
 
+/* === P R O C E D U R E S ================================================= */
+
+static void
+free_pixbuf_buffer(const guint8 *x)
+	{ free(const_cast<guint8*>(x)); }
+
+//! Converts rendered surface to pixbuf, pixels of surface are scaled up by 'pixel_size'
+static Glib::RefPtr<Gdk::Pixbuf>
+surface_to_pixbuf(const synfig::Surface &surface, int pixel_size)
+{
+	PixelFormat pf(PF_RGB|PF_A);
+
+	const int total_bytes(surface.get_w()*surface.get_h()*synfig::channels(pf));
+
+	unsigned char *buffer((unsigned char*)malloc(total_bytes));
+
+	if(!surface || !buffer)
+		return Glib::RefPtr<Gdk::Pixbuf>();
+	{
+		unsigned char *dest(buffer);
+		const Color *src(surface[0]);
+		int w(surface.get_w());
+		int x(w*surface.get_h());
+		for(int i=0;i<x;i++)
+			dest=Color2PixelFormat(
+								   (*(src++)).clamped(),
+								   pf,
+								   dest,
+								   App::gamma
+								   );
+	}
+
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+
+	pixbuf=Gdk::Pixbuf::create_from_data(
+		buffer,	// pointer to the data
+		Gdk::COLORSPACE_RGB, // the colorspace
+		((pf&PF_A)==PF_A), // has alpha?
+		8, // bits per sample
+		surface.get_w(),	// width
+		surface.get_h(),	// height
+		surface.get_w()*synfig::channels(pf), // stride (pitch)
+		sigc::ptr_fun(&free_pixbuf_buffer)
+	);
+
+	if(pixel_size > 1)
+	{
+		// We need to scale up
+		pixbuf=pixbuf->scale_simple(
+			surface.get_w()*pixel_size,
+			surface.get_h()*pixel_size,
+			Gdk::INTERP_NEAREST
+		);
+	}
+
+	return pixbuf;
+}
+
+//! Memory for the compressed frames of playback and scrubbing (in bytes), see App::frame_cache_memory_limit
+static size_t
+get_frame_cache_memory_limit()
+	{ return (size_t)std::max(1, App::frame_cache_memory_limit)*1024*1024; }
+
+//! Independent copy of canvas, which may be moved in time by the rendering thread
+//! while the original one is edited and rendered by the work area.
+//! Canvas is saved and loaded back, so exported values and canvases are copied too.
+//! Canvases of other files are shared with their own documents, so copy is not made for them
+static Canvas::Handle
+snapshot_canvas(const Canvas::Handle &source)
+{
+	if (!source->is_root())
+		return Canvas::Handle();
+
+	String errors, warnings;
+	Canvas::Handle canvas = string_to_canvas(
+		canvas_to_string(source),
+		source->get_identifier(),
+		source->get_file_name(),
+		errors,
+		warnings );
+	if (!canvas)
+	{
+		synfig::warning("WorkArea: Unable to copy canvas for prefetch: %s", errors.c_str());
+		return Canvas::Handle();
+	}
+	if (canvas->has_external_canvases())
+		return Canvas::Handle();
+	return canvas;
+}
+
+//! Puts parts of 'rect' which are outside of 'hole' into 'out_rects'
+static void
+subtract_rect(std::vector<RectInt> &out_rects, const RectInt &rect, const RectInt &hole)
+{
+	out_rects.clear();
+	RectInt r = rect;
+	etl::set_intersect(r, r, hole);
+	if (!r.valid())
+		{ out_rects.push_back(rect); return; }
+
+	if (r.minx != rect.minx)
+		out_rects.push_back(RectInt(rect.minx, rect.miny, r.minx, rect.maxy));
+	if (r.maxx != rect.maxx)
+		out_rects.push_back(RectInt(r.maxx, rect.miny, rect.maxx, rect.maxy));
+	if (r.miny != rect.miny)
+		out_rects.push_back(RectInt(r.minx, rect.miny, r.maxx, r.miny));
+	if (r.maxy != rect.maxy)
+		out_rects.push_back(RectInt(r.minx, r.maxy, r.maxx, rect.maxy));
+}
+
+//! Returns true if layer changes only the pixels inside its bounds
+//! and doesn't move pixels of its context
+static bool
+is_layer_local(const Layer &layer)
+{
+	return dynamic_cast<const Layer_NoDeform*>(&layer) != NULL
+		&& !layer.reads_context();
+}
+
+//! Returns area of canvas which depends on the layer, 'context' should point to the layer
+static Rect
+get_layer_dirty_bounds(const Context &context)
+{
+	const Layer &layer = **context;
+	const Layer_Composite *composite = dynamic_cast<const Layer_Composite*>(&layer);
+	if ( composite
+	  && is_layer_local(layer)
+	  && !Color::is_straight(composite->get_blend_method()) )
+		return layer.get_bounding_rect();
+	return layer.get_full_bounding_rect(context.get_next());
+}
+
+//! Returns area of canvas which depends on the layer in coordinates of the root canvas
+static Rect
+get_layer_dirty_bounds(const Context &context, const Transformation &transformation)
+{
+	Rect bounds = get_layer_dirty_bounds(context);
+	return transformation.is_identity() ? bounds : transformation.transform_bounds(bounds);
+}
+
+//! Returns group layer if changes inside of its canvas can be localized
+static const Layer_PasteCanvas*
+get_inline_group(const Layer &layer)
+{
+	const Layer_PasteCanvas *group = dynamic_cast<const Layer_PasteCanvas*>(&layer);
+	return group
+		&& is_layer_local(layer)
+		&& group->get_sub_canvas()
+		&& group->get_sub_canvas()->is_inline()
+		 ? group : NULL;
+}
+
+//! Fills layers of group in order of rendering
+static void
+get_group_context(const Layer_PasteCanvas &group, CanvasBase &out_queue, Context &out_context)
+{
+	ContextParams params(true);
+	group.apply_z_range_to_params(params);
+	group.get_sub_canvas()->get_context_sorted(params, out_queue, out_context);
+}
+
+static std::vector<GUID>
+get_layer_guids(const Context &context)
+{
+	std::vector<GUID> guids;
+	for(Context c = context; !c->empty(); ++c)
+		guids.push_back((*c)->get_guid());
+	return guids;
+}
+
+//! Rounds 'x' down to the multiple of 'step'
+static int
+align_down(int x, int step)
+	{ return x >= 0 ? x/step*step : -((step - 1 - x)/step*step); }
+
+//! Rounds 'x' up to the multiple of 'step'
+static int
+align_up(int x, int step)
+	{ return -align_down(-x, step); }
+
+//! Joins 'b' into 'a' if they are adjacent parts of the same rendered pixbuf
+static bool
+merge_tiles(WorkAreaTile &a, const WorkAreaTile &b)
+{
+	if ( !a.source
+	  || a.source != b.source
+	  || a.refresh_id != b.refresh_id
+	  || a.rect.minx - a.source_offset[0] != b.rect.minx - b.source_offset[0]
+	  || a.rect.miny - a.source_offset[1] != b.rect.miny - b.source_offset[1] )
+		return false;
+
+	bool columns = a.rect.minx == b.rect.minx && a.rect.maxx == b.rect.maxx
+	            && (a.rect.maxy == b.rect.miny || a.rect.miny == b.rect.maxy);
+	bool rows    = a.rect.miny == b.rect.miny && a.rect.maxy == b.rect.maxy
+	            && (a.rect.maxx == b.rect.minx || a.rect.minx == b.rect.maxx);
+	if (!columns && !rows)
+		return false;
+
+	RectInt rect(
+		std::min(a.rect.minx, b.rect.minx),
+		std::min(a.rect.miny, b.rect.miny),
+		std::max(a.rect.maxx, b.rect.maxx),
+		std::max(a.rect.maxy, b.rect.maxy) );
+	a = WorkAreaTile(a.refresh_id, a, rect);
+	return true;
+}
+
 /* === C L A S S E S ======================================================= */
 
 class studio::WorkAreaTarget : public synfig::Target_Tile
@@ -101,18 +320,29 @@ class studio::WorkAreaTarget : public synfig::Target_Tile
 public:
 	WorkArea *workarea;
 	bool low_res;
+	//! coarse preview, its tiles are replaced by the full quality tiles of the same refresh
+	bool preview;
+	//! size of rendered pixel in pixels of frame
+	int pixel_size;
 	int w,h;
 	int real_tile_w,real_tile_h;
 	int max_tile_w,max_tile_h;
 	bool force_fullframe;
 
 	int refresh_id;
+	//! dirty rects of frame covered by the preview
+	std::vector<RectInt> preview_rects;
 
 	bool onionskin;
-	bool onion_first_tile;
-	int onion_layers;
-
-	std::list<synfig::Time> onion_skin_queue;
+	//! times of onion skin frames, the first one is the current time
+	std::vector<synfig::Time> onion_times;
+	//! index of the next onion skin frame to render
+	int onion_frame;
+	//! time of onion skin frame which is rendering now
+	synfig::Time onion_time;
+	//! rects of tile book which should be composed from onion skin frames
+	std::vector<RectInt> onion_rects;
+	WorkAreaOnionSkinCache::State onion_state;
 
 	std::vector<RectInt> tiles_queue;
 
@@ -126,7 +356,7 @@ public:
 
 		if(!onionskin)
 			return;
-		onion_skin_queue.push_back(time);
+		onion_times.push_back(time);
 
 		try
 		{
@@ -134,7 +364,7 @@ public:
 		for(int i=0; i<onions[0]; i++)
 			{
 				Time keytime=get_canvas()->keyframe_list().find_prev(thistime)->get_time();
-				onion_skin_queue.push_back(keytime);
+				onion_times.push_back(keytime);
 				thistime=keytime;
 			}
 		}
@@ -147,22 +377,80 @@ public:
 		for(int i=0; i<onions[1]; i++)
 			{
 				Time keytime=get_canvas()->keyframe_list().find_next(thistime)->get_time();
-				onion_skin_queue.push_back(keytime);
+				onion_times.push_back(keytime);
 				thistime=keytime;
 			}
 		}
 		catch(...)
 		{  }
 
-		onion_layers=onion_skin_queue.size();
+		onion_state.revision = workarea->canvas_revision;
+		onion_state.frame = Rect(desc.get_tl(), desc.get_br());
+		onion_state.size = VectorInt(desc.get_w(), desc.get_h());
+		onion_state.quality = get_quality();
+		onion_state.low_res = low_res;
+		workarea->onion_skin_cache.set_state(onion_state);
+	}
 
-		onion_first_tile=false;
+	//! Returns rects of onion skin frame which are not cached yet
+	void get_onion_dirty_rects(std::vector<RectInt> &out_rects, const Time &time)
+	{
+		out_rects.clear();
+		for(std::vector<RectInt>::const_iterator i = onion_rects.begin(); i != onion_rects.end(); ++i)
+			if (!workarea->onion_skin_cache.get(time, *i))
+				out_rects.push_back(*i);
+	}
+
+	//! Blends cached onion skin frames and puts the result into tile book,
+	//! called from the rendering thread, so GUI thread is not blocked
+	void compose_onion_skin()
+	{
+		for(std::vector<RectInt>::const_iterator i = onion_rects.begin(); i != onion_rects.end(); ++i)
+		{
+			Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+			int count = 0;
+			for(std::vector<Time>::const_iterator j = onion_times.begin(); j != onion_times.end(); ++j)
+			{
+				Glib::RefPtr<Gdk::Pixbuf> frame = workarea->onion_skin_cache.get(*j, *i);
+				if (!frame)
+					continue;
+				if (!pixbuf)
+				{
+					pixbuf = frame->copy();
+				}
+				else
+				{
+					frame->composite(
+						pixbuf, // Dest
+						0,//int dest_x
+						0,//int dest_y
+						frame->get_width(), // dest width
+						frame->get_height(), // dest_height,
+						0, // double offset_x
+						0, // double offset_y
+						1, // double scale_x
+						1, // double scale_y
+						Gdk::INTERP_NEAREST, // interp
+						255/(count+1) //int overall_alpha
+					);
+				}
+				++count;
+			}
+			if (pixbuf)
+				workarea->get_tile_book().add(refresh_id, i->minx, i->miny, pixbuf);
+		}
+		workarea->onion_skin_cache.retain(onion_times);
+		workarea->queue_draw();
 	}
 public:
 
-	WorkAreaTarget(WorkArea *workarea, int w, int h, int max_tile_w, int max_tile_h, bool force_fullframe):
+	WorkAreaTarget(WorkArea *workarea, int w, int h, int max_tile_w, int max_tile_h, bool force_fullframe, bool preview = false):
 		workarea(workarea),
 		low_res(workarea->get_low_resolution_flag()),
+		preview(preview),
+		pixel_size( preview ? workarea->get_preview_pixel_size()
+		          : low_res ? workarea->get_low_res_pixel_size()
+		          : 1 ),
 		w(w),
 		h(h),
 		real_tile_w(workarea->get_tile_w()),
@@ -172,25 +460,15 @@ public:
 		max_tile_h(max_tile_h),
 		refresh_id(workarea->get_refreshes()),
 		onionskin(false),
-		onion_first_tile(),
-		onion_layers(0)
+		onion_frame(0)
 	{
 		//set_remove_alpha();
 		//set_avoid_time_sync();
 		set_clipping(true);
-		if(low_res)
-		{
-			int div = workarea->get_low_res_pixel_size();
-			set_tile_w(workarea->tile_w/div);
-			set_tile_h(workarea->tile_h/div);
-		}
-		else
-		{
-			set_tile_w(workarea->tile_w);
-			set_tile_h(workarea->tile_h);
-		}
+		set_tile_w(workarea->tile_w/pixel_size);
+		set_tile_h(workarea->tile_h/pixel_size);
 		set_canvas(workarea->get_canvas());
-		set_quality(workarea->get_quality());
+		set_quality(preview ? std::max(workarea->get_quality(), PREVIEW_QUALITY) : workarea->get_quality());
 	}
 
 	~WorkAreaTarget()
@@ -202,10 +480,22 @@ public:
 	{
 		assert(workarea);
 		newdesc->set_flags(RendDesc::PX_ASPECT|RendDesc::IM_SPAN);
-		if(low_res) {
-			int div = workarea->get_low_res_pixel_size();
-			newdesc->set_wh(w/div,h/div);
+		if(preview) {
+			// pixels of preview are aligned to the pixels of frame,
+			// so the frame is extended to the whole number of preview pixels
+			int pw = (w - 1)/pixel_size + 1;
+			int ph = (h - 1)/pixel_size + 1;
+			Point tl = newdesc->get_tl();
+			Vector size = newdesc->get_br() - tl;
+			newdesc->set_flags(0);
+			newdesc->set_wh(pw, ph);
+			newdesc->set_br(tl + Vector(
+				size[0]*Real(pw*pixel_size)/Real(w),
+				size[1]*Real(ph*pixel_size)/Real(h) ));
 		}
+		else
+		if(low_res)
+			newdesc->set_wh(w/pixel_size,h/pixel_size);
 		else
 			newdesc->set_wh(w, h);
 
@@ -223,6 +513,29 @@ public:
 	{
 		synfig::Mutex::Lock lock(mutex);
 
+		if(onionskin)
+			return next_onion_frame(time);
+
+		if (preview)
+		{
+			// preview covers the parts of frame which are not rendered yet
+			workarea->get_tile_book().get_dirty_rects(
+				preview_rects,
+				refresh_id,
+				workarea->get_window_rect(),
+				VectorInt(max_tile_w*pixel_size, max_tile_h*pixel_size) );
+
+			tiles_queue.clear();
+			for(std::vector<RectInt>::const_iterator i = preview_rects.begin(); i != preview_rects.end(); ++i)
+				tiles_queue.push_back(RectInt(
+					i->minx/pixel_size,
+					i->miny/pixel_size,
+					(i->maxx - 1)/pixel_size + 1,
+					(i->maxy - 1)/pixel_size + 1 ));
+
+			return synfig::Target_Tile::next_frame(time);
+		}
+
 		RectInt window_rect = workarea->get_window_rect(get_tile_w(), get_tile_h());
 
 		if (force_fullframe)
@@ -234,25 +547,67 @@ public:
 		{
 			workarea->get_tile_book().get_dirty_rects(
 				tiles_queue,
-				refresh_id - onion_skin_queue.size(),
+				refresh_id,
 				window_rect,
 				VectorInt(max_tile_w, max_tile_h) );
 		}
 
-		if(!onionskin)
-			return synfig::Target_Tile::next_frame(time);
-
-		onion_first_tile=(onion_layers==(signed)onion_skin_queue.size());
+		return synfig::Target_Tile::next_frame(time);
+	}
 
-		if(!onion_skin_queue.empty())
+	int next_onion_frame(Time& time)
+	{
+		if (onion_frame == 0)
 		{
-			time=onion_skin_queue.front();
-			onion_skin_queue.pop_front();
+			RectInt window_rect = workarea->get_window_rect(get_tile_w(), get_tile_h());
+
+			onion_rects.clear();
+			if (force_fullframe)
+				onion_rects.push_back(window_rect);
+			else
+				workarea->get_tile_book().get_dirty_rects(
+					onion_rects,
+					refresh_id,
+					window_rect,
+					VectorInt(max_tile_w, max_tile_h) );
+
+			// clip rects in the same way as Target_Tile does,
+			// to use them as keys of cache
+			RectInt bounds(0, 0, desc.get_w(), desc.get_h());
+			for(std::vector<RectInt>::iterator i = onion_rects.begin(); i != onion_rects.end();)
+			{
+				etl::set_intersect(*i, *i, bounds);
+				if (i->valid()) ++i; else i = onion_rects.erase(i);
+			}
 		}
 		else
+		if (onion_frame > (int)onion_times.size())
+		{
+			tiles_queue.clear();
 			return 0;
+		}
 
-		return onion_skin_queue.size()+1;
+		// skip frames which are already cached
+		while(onion_frame < (int)onion_times.size())
+		{
+			get_onion_dirty_rects(tiles_queue, onion_times[onion_frame]);
+			if (!tiles_queue.empty())
+				break;
+			++onion_frame;
+		}
+
+		if (onion_frame >= (int)onion_times.size())
+		{
+			// all frames are ready, render nothing and return canvas to the current time
+			tiles_queue.clear();
+			onion_frame = (int)onion_times.size() + 1;
+			time = onion_time = onion_times.front();
+			compose_onion_skin();
+			return 0;
+		}
+
+		time = onion_time = onion_times[onion_frame++];
+		return (int)onion_times.size() - onion_frame + 1;
 	}
 
 	virtual int next_tile(RectInt &rect)
@@ -261,6 +616,10 @@ public:
 		if (tiles_queue.empty())
 			return 0;
 
+		// canvas was changed, so rest of tiles are useless
+		if (refresh_id != workarea->get_refreshes())
+			{ tiles_queue.clear(); return 0; }
+
 		rect = tiles_queue.back();
 		tiles_queue.pop_back();
 		return (int)tiles_queue.size() + 1;
@@ -271,85 +630,54 @@ public:
 		return true;
 	}
 
-	static void free_buff(const guint8 *x) { free(const_cast<guint8*>(x)); }
-
 	virtual bool add_tile(const synfig::Surface &surface, int x, int y)
 	{
 		synfig::Mutex::Lock lock(mutex);
 		assert(surface);
 
-		PixelFormat pf(PF_RGB|PF_A);
-
-		const int total_bytes(surface.get_w()*surface.get_h()*synfig::channels(pf));
-
-		unsigned char *buffer((unsigned char*)malloc(total_bytes));
-
-		if(!surface || !buffer)
+		Glib::RefPtr<Gdk::Pixbuf> pixbuf = surface_to_pixbuf(surface, pixel_size);
+		if(!pixbuf)
 			return false;
-		{
-			unsigned char *dest(buffer);
-			const Color *src(surface[0]);
-			int w(surface.get_w());
-			int x(w*surface.get_h());
-			for(int i=0;i<x;i++)
-				dest=Color2PixelFormat(
-									   (*(src++)).clamped(),
-									   pf,
-									   dest,
-									   App::gamma
-									   );
-		}
-
-		Glib::RefPtr<Gdk::Pixbuf> pixbuf;
 
-		pixbuf=Gdk::Pixbuf::create_from_data(
-			buffer,	// pointer to the data
-			Gdk::COLORSPACE_RGB, // the colorspace
-			((pf&PF_A)==PF_A), // has alpha?
-			8, // bits per sample
-			surface.get_w(),	// width
-			surface.get_h(),	// height
-			surface.get_w()*synfig::channels(pf), // stride (pitch)
-			sigc::ptr_fun(&WorkAreaTarget::free_buff)
-		);
-
-		if(low_res)
+		if(onionskin)
 		{
-			// We need to scale up
-			int div = workarea->get_low_res_pixel_size();
-			pixbuf=pixbuf->scale_simple(
-				surface.get_w()*div,
-				surface.get_h()*div,
-				Gdk::INTERP_NEAREST
-			);
+			// frames of onion skin are blended when all of them are ready
+			RectInt rect(x, y, x + surface.get_w(), y + surface.get_h());
+			workarea->onion_skin_cache.add(onion_state, onion_time, rect, pixbuf);
+			return true;
 		}
 
-		RectInt rect(x, y, x + pixbuf->get_width(), y + pixbuf->get_height());
-		WorkAreaTile *tile = workarea->get_tile_book().find_tile(refresh_id - onion_skin_queue.size() - 1, rect);
-
-		if(!onionskin || onion_first_tile || !tile || !tile->pixbuf)
+		if(preview)
 		{
-			workarea->get_tile_book().add(refresh_id - onion_skin_queue.size(), x, y, pixbuf);
-		}
-		else
-		{
-			pixbuf->composite(
-				tile->pixbuf, // Dest
-				0,//int dest_x
-				0,//int dest_y
-				pixbuf->get_width(), // dest width
-				pixbuf->get_height(), // dest_height,
-				0, // double offset_x
-				0, // double offset_y
-				1, // double scale_x
-				1, // double scale_y
-				Gdk::INTERP_NEAREST, // interp
-				255/(onion_layers-onion_skin_queue.size()+1) //int overall_alpha
-			);
-			tile->refresh_id = refresh_id - onion_skin_queue.size();
-			workarea->get_tile_book().sort();
+			// put only the parts inside dirty rects, to keep the tiles
+			// which are already rendered at full quality
+			RectInt rect(
+				x*pixel_size,
+				y*pixel_size,
+				x*pixel_size + pixbuf->get_width(),
+				y*pixel_size + pixbuf->get_height() );
+			for(std::vector<RectInt>::const_iterator i = preview_rects.begin(); i != preview_rects.end(); ++i)
+			{
+				RectInt part = *i;
+				etl::set_intersect(part, part, rect);
+				if (part.valid())
+					workarea->get_tile_book().add(
+						refresh_id - 1,
+						part.minx,
+						part.miny,
+						Gdk::Pixbuf::create_subpixbuf(
+							pixbuf,
+							part.minx - rect.minx,
+							part.miny - rect.miny,
+							part.maxx - part.minx,
+							part.maxy - part.miny ));
+			}
+			workarea->queue_draw();
+			return true;
 		}
 
+		workarea->get_tile_book().add(refresh_id, x, y, pixbuf);
+
 		//if(index%2)
 			workarea->queue_draw();
 		return true;
@@ -362,6 +690,97 @@ public:
 };
 
 
+//! Renders the frames following the current one into the frame cache,
+//! visible part of each frame is rendered as one tile.
+//! Frames are rendered from the copy of canvas made by get_prefetch_canvas(),
+//! so the edited canvas is never touched by the rendering thread
+class studio::WorkAreaPrefetchTarget : public synfig::Target_Tile
+{
+public:
+	WorkArea *workarea;
+	WorkAreaFrameCache::State state;
+	RectInt rect;
+
+	//! times of frames to render
+	std::vector<synfig::Time> times;
+	//! index of the next frame to render
+	int frame;
+	//! time of frame which is rendering now
+	synfig::Time frame_time;
+	bool tile_taken;
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
+
+	WorkAreaPrefetchTarget(
+		WorkArea *workarea,
+		const WorkAreaFrameCache::State &state,
+		const RectInt &rect,
+		const std::vector<synfig::Time> &times,
+		const Canvas::Handle &canvas
+	):
+		workarea(workarea),
+		state(state),
+		rect(rect),
+		times(times),
+		frame(0),
+		tile_taken(false)
+	{
+		set_clipping(true);
+		set_canvas(canvas);
+		set_quality(workarea->get_quality());
+		set_priority(AsyncRenderer::PRIORITY_PREFETCH);
+	}
+
+	virtual bool set_rend_desc(synfig::RendDesc *newdesc)
+	{
+		newdesc->set_flags(RendDesc::PX_ASPECT|RendDesc::IM_SPAN);
+		newdesc->set_wh(state.size[0], state.size[1]);
+		desc = *newdesc;
+		return true;
+	}
+
+	virtual int next_frame(Time& time)
+	{
+		// skip frames which was cached by the work area in the meantime
+		while(frame + 1 < (int)times.size() && workarea->frame_cache.has(state, times[frame], rect))
+			++frame;
+
+		tile_taken = false;
+		time = frame_time = times[std::min(frame++, (int)times.size() - 1)];
+		return std::max(0, (int)times.size() - frame);
+	}
+
+	virtual int next_tile(RectInt& out_rect)
+	{
+		// the last frame may be cached by the work area in the meantime
+		if (tile_taken || workarea->frame_cache.has(state, frame_time, rect))
+			return 0;
+		tile_taken = true;
+		out_rect = rect;
+		return 1;
+	}
+
+	virtual bool start_frame(synfig::ProgressCallback */*cb*/)
+	{
+		pixbuf.reset();
+		return true;
+	}
+
+	virtual bool add_tile(const synfig::Surface &surface, int /*x*/, int /*y*/)
+	{
+		pixbuf = surface_to_pixbuf(surface, 1);
+		return (bool)pixbuf;
+	}
+
+	virtual void end_frame()
+	{
+		// frame is dropped by the cache if canvas was changed while it was rendering
+		if (pixbuf)
+			workarea->frame_cache.add(state, frame_time, rect, pixbuf);
+		pixbuf.reset();
+	}
+};
+
+
 class studio::WorkAreaTarget_Full : public synfig::Target_Scanline
 {
 public:
@@ -430,7 +849,7 @@ public:
 		h(h),
 		real_tile_w(),
 		real_tile_h(),
-		refresh_id(workarea->refreshes),
+		refresh_id(workarea->get_refreshes()),
 		onionskin(false),
 		onion_first_tile(),
 		onion_layers(0)
@@ -574,8 +993,10 @@ public:
 				Gdk::INTERP_NEAREST, // interp
 				255/(onion_layers-onion_skin_queue.size()+1) //int overall_alpha
 			);
-			tile->refresh_id = refresh_id - onion_skin_queue.size();
-			workarea->get_tile_book().sort();
+			// the newer tile replaces the old one
+			WorkAreaTile mixed = *tile;
+			mixed.refresh_id = refresh_id - onion_skin_queue.size();
+			workarea->get_tile_book().add(mixed);
 		}
 
 		workarea->queue_draw();
@@ -584,6 +1005,23 @@ public:
 
 /* === M E T H O D S ======================================================= */
 
+WorkAreaTile::WorkAreaTile(int refresh_id, const WorkAreaTile &tile, const synfig::RectInt &rect):
+	refresh_id(refresh_id),
+	rect(rect),
+	surface(),
+	source(tile.source),
+	source_offset(
+		tile.source_offset[0] + rect.minx - tile.rect.minx,
+		tile.source_offset[1] + rect.miny - tile.rect.miny )
+{
+	assert(source);
+	int w = rect.maxx - rect.minx;
+	int h = rect.maxy - rect.miny;
+	pixbuf = source_offset == VectorInt(0, 0) && w == source->get_width() && h == source->get_height()
+	       ? source
+	       : Gdk::Pixbuf::create_subpixbuf(source, source_offset[0], source_offset[1], w, h);
+}
+
 WorkAreaTile*
 WorkAreaTileBook::find_tile(int refresh_id, const synfig::RectInt &rect)
 {
@@ -594,22 +1032,93 @@ WorkAreaTileBook::find_tile(int refresh_id, const synfig::RectInt &rect)
 }
 
 void
-WorkAreaTileBook::sort()
+WorkAreaTileBook::add(const WorkAreaTile &tile)
 {
-	tiles.sort();
-	for(WorkAreaTile::List::iterator i = tiles.begin(); i != tiles.end(); ++i)
-		for(WorkAreaTile::List::iterator j = tiles.begin(); j != i;)
-			if (j->refresh_id < i->refresh_id && etl::intersect(i->rect, j->rect))
-				{ WorkAreaTile::List::iterator k = j; ++j; tiles.erase(k); } else ++j;
+	if (!tile.rect.valid() || !tile.pixbuf)
+		return;
+
+	// drop older tiles under the new one,
+	// and drop the new tile itself if it's under the newer one
+	WorkAreaTile::List::iterator position = tiles.end();
+	for(WorkAreaTile::List::iterator i = tiles.begin(); i != tiles.end();)
+	{
+		if (i->refresh_id > tile.refresh_id)
+		{
+			if (etl::intersect(i->rect, tile.rect))
+				return;
+			if (position == tiles.end())
+				position = i;
+			++i;
+		}
+		else
+		if (i->refresh_id < tile.refresh_id && etl::intersect(i->rect, tile.rect))
+			i = tiles.erase(i);
+		else
+			++i;
+	}
+	tiles.insert(position, tile);
 }
 
 void
-WorkAreaTileBook::add(const WorkAreaTile &tile)
+WorkAreaTileBook::renew(int refresh_id, int new_refresh_id, const synfig::RectInt &dirty_rect, const synfig::VectorInt &grid)
 {
-	if (!tile.rect.valid() || !tile.pixbuf)
-		return;
-	tiles.push_back(tile);
-	sort();
+	RectInt hole = dirty_rect;
+	if (hole.valid() && grid[0] > 0 && grid[1] > 0)
+		hole = RectInt(
+			align_down(hole.minx, grid[0]),
+			align_down(hole.miny, grid[1]),
+			align_up(hole.maxx, grid[0]),
+			align_up(hole.maxy, grid[1]) );
+
+	WorkAreaTile::List renewed;
+	std::vector<WorkAreaTile::List::iterator> parts;
+	std::vector<synfig::RectInt> subs;
+	subs.reserve(4);
+
+	for(WorkAreaTile::List::iterator i = tiles.begin(); i != tiles.end();)
+	{
+		if (i->refresh_id < refresh_id || !i->pixbuf)
+			{ ++i; continue; }
+
+		if (!etl::intersect(i->rect, hole))
+		{
+			i->refresh_id = new_refresh_id;
+			WorkAreaTile::List::iterator j = i++;
+			renewed.splice(renewed.end(), tiles, j);
+			if (j->pixbuf != j->source)
+				parts.push_back(j);
+			continue;
+		}
+
+		// split tile, sub-pixbufs share pixels with the original one.
+		// parts outside the hole are actual,
+		// part inside will be shown until it will be rendered again
+		RectInt rect = i->rect;
+		etl::set_intersect(rect, rect, hole);
+		subtract_rect(subs, i->rect, hole);
+		for(std::vector<synfig::RectInt>::const_iterator j = subs.begin(); j != subs.end(); ++j)
+			parts.push_back(renewed.insert(renewed.end(), WorkAreaTile(new_refresh_id, *i, *j)));
+		if (rect != i->rect)
+			*i = WorkAreaTile(i->refresh_id, *i, rect);
+		++i;
+	}
+
+	// merge adjacent parts of the same rendered pixbufs
+	for(bool merged = true; merged;)
+	{
+		merged = false;
+		for(int i = 0; i < (int)parts.size(); ++i)
+			for(int j = i + 1; j < (int)parts.size();)
+				if (merge_tiles(*parts[i], *parts[j]))
+				{
+					renewed.erase(parts[j]);
+					parts.erase(parts.begin() + j);
+					merged = true;
+				}
+				else ++j;
+	}
+
+	tiles.splice(tiles.end(), renewed);
 }
 
 void
@@ -636,19 +1145,9 @@ WorkAreaTileBook::get_dirty_rects(
 			for(std::vector<synfig::RectInt>::iterator j = out_rects.begin(); j != out_rects.end();)
 			{
 				assert(j->valid());
-				RectInt rect = *j;
-				etl::set_intersect(rect, rect, i->rect);
-				if (rect.valid())
+				if (etl::intersect(*j, i->rect))
 				{
-					subs.clear();
-					if (rect.minx != j->minx)
-						subs.push_back(RectInt(j->minx, j->miny, rect.minx, j->maxy));
-					if (rect.maxx != j->maxx)
-						subs.push_back(RectInt(rect.maxx, j->miny, j->maxx, j->maxy));
-					if (rect.miny != j->miny)
-						subs.push_back(RectInt(rect.minx, j->miny, rect.maxx, rect.miny));
-					if (rect.maxy != j->maxy)
-						subs.push_back(RectInt(rect.minx, rect.maxy, rect.maxx, j->maxy));
+					subtract_rect(subs, *j, i->rect);
 
 					if (subs.empty())
 						j = out_rects.erase(j);
@@ -707,6 +1206,186 @@ WorkAreaTileBook::get_dirty_rects(
 	}
 }
 
+void
+WorkAreaOnionSkinCache::set_state(const State &x)
+{
+	synfig::Mutex::Lock lock(mutex);
+	if (state != x)
+	{
+		frames.clear();
+		state = x;
+	}
+}
+
+Glib::RefPtr<Gdk::Pixbuf>
+WorkAreaOnionSkinCache::get(const synfig::Time &time, const synfig::RectInt &rect)
+{
+	synfig::Mutex::Lock lock(mutex);
+	Map::const_iterator i = frames.find(Key(time, rect));
+	return i == frames.end() ? Glib::RefPtr<Gdk::Pixbuf>() : i->second;
+}
+
+void
+WorkAreaOnionSkinCache::add(
+	const State &state,
+	const synfig::Time &time,
+	const synfig::RectInt &rect,
+	const Glib::RefPtr<Gdk::Pixbuf> &pixbuf )
+{
+	synfig::Mutex::Lock lock(mutex);
+	// frame from the previous rendering which is still in progress
+	if (state != this->state || !pixbuf)
+		return;
+	frames[Key(time, rect)] = pixbuf;
+}
+
+void
+WorkAreaOnionSkinCache::retain(const std::vector<synfig::Time> &times)
+{
+	synfig::Mutex::Lock lock(mutex);
+	for(Map::iterator i = frames.begin(); i != frames.end();)
+		if (std::find(times.begin(), times.end(), i->first.time) == times.end())
+			frames.erase(i++);
+		else
+			++i;
+}
+
+void
+WorkAreaOnionSkinCache::clear()
+{
+	synfig::Mutex::Lock lock(mutex);
+	frames.clear();
+}
+
+
+WorkAreaFrameCache::WorkAreaFrameCache():
+	memory_limit(get_frame_cache_memory_limit()),
+	memory_used(0),
+	uses(0)
+	{ }
+
+void
+WorkAreaFrameCache::reserve(size_t size)
+{
+	while(!frames.empty() && memory_used + size > memory_limit)
+	{
+		Map::iterator oldest = frames.begin();
+		for(Map::iterator i = frames.begin(); i != frames.end(); ++i)
+			if (i->second.last_use < oldest->second.last_use)
+				oldest = i;
+		memory_used -= get_frame_size(oldest->second);
+		frames.erase(oldest);
+	}
+}
+
+void
+WorkAreaFrameCache::set_memory_limit(size_t x)
+{
+	synfig::Mutex::Lock lock(mutex);
+	memory_limit = x;
+	reserve(0);
+}
+
+void
+WorkAreaFrameCache::set_state(const State &x)
+{
+	synfig::Mutex::Lock lock(mutex);
+	if (state != x)
+	{
+		frames.clear();
+		memory_used = 0;
+		state = x;
+	}
+}
+
+bool
+WorkAreaFrameCache::has(const State &state, const synfig::Time &time, const synfig::RectInt &rect)
+{
+	synfig::Mutex::Lock lock(mutex);
+	if (state != this->state)
+		return false;
+	Map::iterator i = frames.find(time);
+	if (i == frames.end() || !etl::contains(i->second.rect, rect))
+		return false;
+	i->second.last_use = ++uses;
+	return true;
+}
+
+Glib::RefPtr<Gdk::Pixbuf>
+WorkAreaFrameCache::get(const State &state, const synfig::Time &time, const synfig::RectInt &rect)
+{
+	synfig::Mutex::Lock lock(mutex);
+	if (state != this->state || !rect.valid())
+		return Glib::RefPtr<Gdk::Pixbuf>();
+	Map::iterator i = frames.find(time);
+	if (i == frames.end() || !etl::contains(i->second.rect, rect))
+		return Glib::RefPtr<Gdk::Pixbuf>();
+	i->second.last_use = ++uses;
+
+	const RectInt &r = i->second.rect;
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf = i->second.image.unpack_pixbuf();
+	if (!pixbuf || r == rect)
+		return pixbuf;
+	return Gdk::Pixbuf::create_subpixbuf(
+		pixbuf,
+		rect.minx - r.minx,
+		rect.miny - r.miny,
+		rect.maxx - rect.minx,
+		rect.maxy - rect.miny );
+}
+
+void
+WorkAreaFrameCache::add(
+	const State &state,
+	const synfig::Time &time,
+	const synfig::RectInt &rect,
+	const Glib::RefPtr<Gdk::Pixbuf> &pixbuf )
+{
+	if ( !pixbuf
+	  || !pixbuf->get_has_alpha()
+	  || pixbuf->get_bits_per_sample() != 8
+	  || pixbuf->get_width() != rect.maxx - rect.minx
+	  || pixbuf->get_height() != rect.maxy - rect.miny )
+		return;
+
+	// compress frame without lock, it may be called from the rendering thread
+	Frame frame;
+	frame.rect = rect;
+	if (!frame.image.pack(pixbuf))
+		return;
+
+	synfig::Mutex::Lock lock(mutex);
+	// frame from the previous rendering which is still in progress
+	if (state != this->state)
+		return;
+
+	Map::iterator i = frames.find(time);
+	if (i != frames.end())
+	{
+		memory_used -= get_frame_size(i->second);
+		frames.erase(i);
+	}
+
+	size_t size = get_frame_size(frame);
+	if (size > memory_limit)
+		return;
+	reserve(size);
+
+	Frame &f = frames[time];
+	f.rect = frame.rect;
+	f.image.swap(frame.image);
+	f.last_use = ++uses;
+	memory_used += size;
+}
+
+void
+WorkAreaFrameCache::clear()
+{
+	synfig::Mutex::Lock lock(mutex);
+	frames.clear();
+	memory_used = 0;
+}
+
 
 WorkArea::WorkArea(etl::loose_handle<synfigapp::CanvasInterface> canvas_interface):
 	Gtk::Table(3, 3, false), /* 3 columns by 3 rows*/
@@ -741,6 +1420,10 @@ WorkArea::WorkArea(etl::loose_handle<synfigapp::CanvasInterface> canvas_interfac
 	render_idle_func_id=0;
 	quality=10;
 	low_res_pixel_size=2;
+	preview_pixel_size=4;
+	preview_refresh_id=-1;
+	preview_pass=false;
+	full_render_time=-1.0;
 	rendering=false;
 	canceled_=false;
 	low_resolution=false;
@@ -776,7 +1459,13 @@ WorkArea::WorkArea(etl::loose_handle<synfigapp::CanvasInterface> canvas_interfac
 	signal_sketch_saved().connect(sigc::mem_fun(*this,&studio::WorkArea::save_meta_data));
 
 	// Not that it really makes a difference... (setting this to zero, that is)
-	refreshes=0;
+	g_atomic_int_set(&refreshes, 0);
+
+	dirty_region_full=true;
+	dirty_region_child_changed=false;
+	canvas_revision=0;
+	prefetch_canvas_revision=-1;
+	render_revision=0;
 
   	drawing_area=manage(new class Gtk::DrawingArea());
   	drawing_area->add_events(Gdk::SCROLL_MASK | Gdk::BUTTON3_MOTION_MASK);
@@ -864,6 +1553,8 @@ WorkArea::WorkArea(etl::loose_handle<synfigapp::CanvasInterface> canvas_interfac
 
 
 	canvas_interface->signal_rend_desc_changed().connect(sigc::mem_fun(*this, &WorkArea::refresh_dimension_info));
+	get_canvas()->signal_child_changed().connect(sigc::mem_fun(*this, &WorkArea::on_canvas_child_changed));
+	get_canvas()->signal_changed().connect(sigc::mem_fun(*this, &WorkArea::on_canvas_changed));
 	// When either of the scrolling adjustments change, then redraw.
 	get_scrollx_adjustment()->signal_value_changed().connect(sigc::mem_fun(*this, &WorkArea::queue_scroll));
 	get_scrolly_adjustment()->signal_value_changed().connect(sigc::mem_fun(*this, &WorkArea::queue_scroll));
@@ -918,6 +1609,10 @@ WorkArea::~WorkArea()
 	// that causes crashes
 	if(render_idle_func_id)
 		render_idle_func_id=0;
+
+	// prefetch thread uses the frame cache
+	if(prefetch_renderer)
+		prefetch_renderer->stop();
 }
 
 #ifdef SINGLE_THREADED
@@ -1332,6 +2027,8 @@ WorkArea::set_onion_skin(bool x)
 	if(onion_skin==x)
 		return;
 	onion_skin=x;
+	if(!onion_skin)
+		onion_skin_cache.clear();
 	save_meta_data();
 	queue_render_preview();
 }
@@ -2823,6 +3520,7 @@ studio::WorkArea::async_update_preview()
 	}
 #endif
 
+	stop_prefetch();
 	async_renderer=0;
 
 	queued=false;
@@ -2852,6 +3550,13 @@ studio::WorkArea::async_update_preview()
 	dirty=false;
 	get_canvas_view()->reset_cancel_status();
 
+	// frame was rendered before, so it's taken from cache
+	if(show_cached_frame())
+	{
+		start_prefetch();
+		return true;
+	}
+
 	//bool ret=false;
 	RendDesc desc=get_canvas()->rend_desc();
 
@@ -2876,6 +3581,7 @@ studio::WorkArea::async_update_preview()
 	// if we have lots of pixels to render and the tile renderer isn't disabled, use it
 	int div;
 	div = low_resolution ? low_res_pixel_size : 1;
+	preview_pass=false;
 	if( !App::workarea_renderer.empty()
 	 || !getenv("SYNFIG_DISABLE_TILE_RENDER")
 	 || getenv("SYNFIG_FORCE_TILE_RENDER") )
@@ -2883,8 +3589,20 @@ studio::WorkArea::async_update_preview()
 		bool legacy = App::workarea_renderer.empty();
 		int ts = legacy ? 2048 : 2048;
 
+		// render coarse preview first, if the frame was changed and rendering is not fast,
+		// then the next pass replaces it by the full quality tiles
+		preview_pass = !low_resolution
+		            && !get_onion_skin()
+		            && preview_pixel_size > 1
+		            && preview_refresh_id != refreshes
+		            && (full_render_time < 0.0 || full_render_time > PREVIEW_MIN_RENDER_TIME)
+		            && w >= preview_pixel_size
+		            && h >= preview_pixel_size;
+		if (preview_pass)
+			preview_refresh_id = refreshes;
+
 		// do a tile render
-		handle<WorkAreaTarget> trgt(new class WorkAreaTarget(this,w,h,ts,ts,false));
+		handle<WorkAreaTarget> trgt(new class WorkAreaTarget(this,w,h,ts,ts,false,preview_pass));
 
 		trgt->set_rend_desc(&desc);
 		trgt->set_onion_skin(get_onion_skin(), onion_skins);
@@ -2902,6 +3620,11 @@ studio::WorkArea::async_update_preview()
 		target=trgt;
 	}
 
+	// the visible frame is rendered before any prefetched frames,
+	// and the previous request is cancelled when async_renderer is replaced
+	target->set_priority(AsyncRenderer::PRIORITY_VISIBLE);
+	render_revision=canvas_revision;
+
 	// We can rest assured that our time has already
 	// been set, so there is no need to have to
 	// recalculate that over again.
@@ -2932,11 +3655,23 @@ studio::WorkArea::async_update_finished()
 	if(!async_renderer)
 		return;
 
+	// show the progressive preview, the full quality pass
+	// will be started by the drawing of dirty tiles
+	if(preview_pass)
+	{
+		preview_pass=false;
+		if(!async_renderer->has_success())
+			dirty=true;
+		queue_draw();
+		return;
+	}
+
 	// If we completed successfully, then
 	// we aren't dirty anymore
 	if(async_renderer->has_success())
 	{
 		Real execution_time = async_renderer->get_execution_time();
+		full_render_time = execution_time;
 		if (execution_time > 0.0)
 		{
 			cb->task( strprintf("%s %f (%f) %s",
@@ -2958,6 +3693,12 @@ studio::WorkArea::async_update_finished()
 	}
 	//get_canvas_view()->reset_cancel_status();
 	done_rendering();
+
+	if(async_renderer->has_success())
+	{
+		cache_frame();
+		start_prefetch();
+	}
 }
 
 bool
@@ -2968,6 +3709,7 @@ studio::WorkArea::sync_update_preview()
 	canceled_=false;
 	get_canvas_view()->reset_cancel_status();
 
+	stop_prefetch();
 	async_renderer=0;
 
 again:
@@ -3018,6 +3760,7 @@ again:
 	set_rend_desc(desc);
 
 	// Create the render target
+	render_revision=canvas_revision;
 	handle<WorkAreaTarget> target = new WorkAreaTarget(this,w,h,2048,2048,true);
 	target->set_rend_desc(&desc);
 	//target->set_allow_multithreading(false);
@@ -3061,6 +3804,7 @@ again:
 	{
 		dirty=false;
 		//queued=false;
+		cache_frame();
 	}
 	else dirty=true;
 	rendering=false;
@@ -3075,10 +3819,19 @@ studio::WorkArea::async_render_preview(synfig::Time time)
 	cur_time=time;
 	//tile_book.clear();
 
-	refreshes+=5;
-	if(!get_visible())return;
+	int prev_refreshes=refreshes;
+	g_atomic_int_add(&refreshes, 5);
+	if(!get_visible())
+	{
+		dirty_region_full=true;
+		return;
+	}
 
 	get_canvas()->set_time(get_time());
+	// only the changed area is rendered again,
+	// so it is rendered in full quality without the coarse preview
+	if (refresh_dirty_region(prev_refreshes))
+		preview_refresh_id=refreshes;
 	get_canvas_view()->get_smach().process_event(EVENT_REFRESH_DUCKS);
 	signal_rendering()();
 
@@ -3090,13 +3843,363 @@ WorkArea::async_render_preview()
 	return async_render_preview(get_canvas_view()->get_time());
 }
 
+void
+WorkArea::on_canvas_child_changed(const synfig::Node *node)
+{
+	if (const Layer *layer = dynamic_cast<const Layer*>(node))
+	{
+		dirty_layers.insert(layer->get_guid());
+		dirty_region_child_changed=true;
+	}
+}
+
+void
+WorkArea::on_canvas_changed()
+{
+	// canvas changed not through one of its layers,
+	// so we don't know which part of frame is affected
+	if (!dirty_region_child_changed)
+		dirty_region_full=true;
+	dirty_region_child_changed=false;
+	++canvas_revision;
+
+	// frames rendered before the change are dropped,
+	// and frames which are rendering now will not be cached
+	stop_prefetch();
+	WorkAreaFrameCache::State state;
+	get_frame_cache_state(state);
+	frame_cache.set_state(state);
+}
+
+bool
+WorkArea::refresh_dirty_region(int prev_refresh_id)
+{
+	const RendDesc &desc = get_canvas()->rend_desc();
+	const Point &tl = desc.get_tl();
+	const Point &br = desc.get_br();
+	Rect frame(tl, br);
+	VectorInt size(w, h);
+
+	// tiles of onion skin are mixed from several frames,
+	// and tiles of low resolution preview aren't aligned to the frame pixels
+	bool partial = !onion_skin && !low_resolution;
+	bool full = !partial
+	         || dirty_region_full
+	         || !dirty_region_time.is_equal(cur_time)
+	         || dirty_region_frame != frame
+	         || dirty_region_size != size;
+
+	CanvasBase queue;
+	Context context;
+	get_canvas()->get_context_sorted(ContextParams(true), queue, context);
+
+	Rect region = Rect::zero();
+	if (!full)
+	{
+		full = !collect_dirty_region(context, Transformation(), region);
+
+		// some of changed layers was removed from canvas
+		if (!dirty_layers.empty())
+			full = true;
+	}
+
+	if (!full)
+	{
+		// convert region to pixels, with one pixel more for antialiasing
+		const Real limit = 1 << 28;
+		Real kx = size[0]/(br[0] - tl[0]);
+		Real ky = size[1]/(br[1] - tl[1]);
+		Real x0 = (region.minx - tl[0])*kx, x1 = (region.maxx - tl[0])*kx;
+		Real y0 = (region.miny - tl[1])*ky, y1 = (region.maxy - tl[1])*ky;
+		if (std::isnan(x0) || std::isnan(x1) || std::isnan(y0) || std::isnan(y1))
+		{
+			full = true;
+		}
+		else
+		if (region.is_valid())
+		{
+			RectInt dirty_rect(
+				(int)floor(std::max(-limit, std::min(x0, x1))) - 1,
+				(int)floor(std::max(-limit, std::min(y0, y1))) - 1,
+				(int)ceil(std::min(limit, std::max(x0, x1))) + 1,
+				(int)ceil(std::min(limit, std::max(y0, y1))) + 1 );
+			tile_book.renew(prev_refresh_id, refreshes, dirty_rect, VectorInt(tile_w, tile_h));
+		}
+		else
+		{
+			tile_book.renew(prev_refresh_id, refreshes, RectInt::zero(), VectorInt(tile_w, tile_h));
+		}
+	}
+
+	if (full)
+	{
+		// remember bounds of layers to localize the next changes
+		dirty_layer_bounds.clear();
+		dirty_groups.clear();
+		for(std::map<GUID, sigc::connection>::iterator i = dirty_canvas_connections.begin(); i != dirty_canvas_connections.end(); ++i)
+			i->second.disconnect();
+		dirty_canvas_connections.clear();
+		if (partial)
+			for(Context c = context; !c->empty(); ++c)
+				remember_dirty_bounds(c, Transformation());
+	}
+
+	dirty_layers.clear();
+	dirty_region_full=false;
+	dirty_region_time=cur_time;
+	dirty_region_frame=frame;
+	dirty_region_size=size;
+	return !full;
+}
+
+void
+WorkArea::remember_dirty_bounds(const synfig::Context &context, const synfig::Transformation &transformation)
+{
+	const Layer &layer = **context;
+	dirty_layers.erase(layer.get_guid());
+	dirty_layer_bounds[layer.get_guid()] = get_layer_dirty_bounds(context, transformation);
+
+	const Layer_PasteCanvas *group = get_inline_group(layer);
+	if (!group)
+		return;
+
+	CanvasBase sub_queue;
+	Context sub_context;
+	get_group_context(*group, sub_queue, sub_context);
+
+	DirtyGroup &dirty_group = dirty_groups[layer.get_guid()];
+	dirty_group.params = layer.get_param_list();
+	dirty_group.layers = get_layer_guids(sub_context);
+
+	// listen to the layers of inline canvas
+	Canvas::Handle canvas = group->get_sub_canvas();
+	sigc::connection &connection = dirty_canvas_connections[canvas->get_guid()];
+	if (!connection.connected())
+		connection = canvas->signal_child_changed().connect(
+			sigc::mem_fun(*this, &WorkArea::on_canvas_child_changed) );
+
+	Transformation sub_transformation = transformation.transform(group->get_summary_transformation());
+	for(Context c = sub_context; !c->empty(); ++c)
+		remember_dirty_bounds(c, sub_transformation);
+}
+
+bool
+WorkArea::collect_dirty_region(const synfig::Context &context, const synfig::Transformation &transformation, synfig::Rect &region)
+{
+	for(Context c = context; !c->empty() && !dirty_layers.empty(); ++c)
+	{
+		const Layer &layer = **c;
+		if (dirty_layers.erase(layer.get_guid()))
+		{
+			std::map<GUID, Rect>::iterator i = dirty_layer_bounds.find(layer.get_guid());
+			if (i == dirty_layer_bounds.end())
+				return false;
+			Rect bounds = get_layer_dirty_bounds(c, transformation);
+
+			// changes inside of the group are localized
+			// while the group itself and the list of its layers are the same
+			bool localized = false;
+			const Layer_PasteCanvas *group = get_inline_group(layer);
+			std::map<GUID, DirtyGroup>::const_iterator g = dirty_groups.find(layer.get_guid());
+			if (group && g != dirty_groups.end())
+			{
+				CanvasBase sub_queue;
+				Context sub_context;
+				get_group_context(*group, sub_queue, sub_context);
+				Rect sub_region = Rect::zero();
+				size_t count = dirty_layers.size();
+				localized = g->second.layers == get_layer_guids(sub_context)
+				         && g->second.params == layer.get_param_list()
+				         && collect_dirty_region(
+				                sub_context,
+				                transformation.transform(group->get_summary_transformation()),
+				                sub_region )
+				         && dirty_layers.size() < count;
+				if (localized)
+					region |= sub_region;
+			}
+
+			if (!localized)
+			{
+				region |= i->second;
+				region |= bounds;
+				if (group)
+					remember_dirty_bounds(c, transformation);
+			}
+			i->second = bounds;
+		}
+
+		// changes below can be moved or spread by this layer
+		if (!dirty_layers.empty() && c.active() && !is_layer_local(layer))
+			return false;
+	}
+	return true;
+}
+
+bool
+WorkArea::get_frame_cache_state(WorkAreaFrameCache::State &out_state) const
+{
+	const RendDesc &desc = get_canvas()->rend_desc();
+	out_state.revision = canvas_revision;
+	out_state.frame = Rect(desc.get_tl(), desc.get_br());
+	out_state.size = VectorInt((int)(desc.get_w()*zoom), (int)(desc.get_h()*zoom));
+	out_state.quality = quality;
+	out_state.low_res = low_resolution;
+
+	// tiles of onion skin are mixed from several frames,
+	// and tiles of low resolution preview aren't aligned to the frame pixels,
+	// also frames can't be cached until work area is resized for the current zoom
+	return !onion_skin
+	    && !low_resolution
+	    && out_state.size == VectorInt(w, h);
+}
+
+bool
+WorkArea::show_cached_frame()
+{
+	WorkAreaFrameCache::State state;
+	if (!get_frame_cache_state(state))
+		return false;
+	frame_cache.set_state(state);
+
+	RectInt rect = get_window_rect();
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf = frame_cache.get(state, cur_time, rect);
+	if (!pixbuf)
+		return false;
+
+	tile_book.add(refreshes, rect.minx, rect.miny, pixbuf);
+	queue_draw();
+	return true;
+}
+
+void
+WorkArea::cache_frame()
+{
+	WorkAreaFrameCache::State state;
+	if (!get_frame_cache_state(state) || state.revision != render_revision)
+		return;
+	frame_cache.set_state(state);
+	frame_cache.set_memory_limit(get_frame_cache_memory_limit());
+
+	RectInt rect = get_window_rect();
+	if (!rect.valid() || frame_cache.has(state, cur_time, rect))
+		return;
+
+	// frame is cached only if its visible part is completely rendered
+	std::vector<RectInt> dirty_rects;
+	tile_book.get_dirty_rects(dirty_rects, refreshes, rect);
+	if (!dirty_rects.empty())
+		return;
+
+	Glib::RefPtr<Gdk::Pixbuf> pixbuf = Gdk::Pixbuf::create(
+		Gdk::COLORSPACE_RGB, true, 8, rect.maxx - rect.minx, rect.maxy - rect.miny );
+	pixbuf->fill(0);
+	for(WorkAreaTile::List::const_iterator i = tile_book.get_tiles().begin(); i != tile_book.get_tiles().end(); ++i)
+	{
+		if (i->refresh_id < refreshes)
+			continue;
+		if (!i->pixbuf)
+			return;
+		RectInt r = i->rect;
+		etl::set_intersect(r, r, rect);
+		if (r.valid())
+			i->pixbuf->copy_area(
+				r.minx - i->rect.minx,
+				r.miny - i->rect.miny,
+				r.maxx - r.minx,
+				r.maxy - r.miny,
+				pixbuf,
+				r.minx - rect.minx,
+				r.miny - rect.miny );
+	}
+
+	frame_cache.add(state, cur_time, rect, pixbuf);
+}
+
+void
+WorkArea::start_prefetch()
+{
+	stop_prefetch();
+
+	WorkAreaFrameCache::State state;
+	if ( rendering
+	  || queued
+	  || get_canvas_view()->is_playing()
+	  || !get_frame_cache_state(state) )
+		return;
+	frame_cache.set_state(state);
+	frame_cache.set_memory_limit(get_frame_cache_memory_limit());
+
+	RendDesc desc = get_canvas()->rend_desc();
+	float fps = desc.get_frame_rate();
+	RectInt rect = get_window_rect();
+	if (fps <= 0.f || !rect.valid())
+		return;
+
+	// frames which are cached already are marked as recently used,
+	// so they will not be dropped by the following ones
+	std::vector<Time> times;
+	for(int i = 1; i <= FRAME_CACHE_PREFETCH_FRAMES; ++i)
+	{
+		Time time = Time(cur_time + i/fps).round(fps);
+		if (time > desc.get_time_end())
+			break;
+		if (!frame_cache.has(state, time, rect))
+			times.push_back(time);
+	}
+	if (times.empty())
+		return;
+
+	desc.set_antialias(1);
+	desc.set_time(cur_time);
+	desc.set_render_excluded_contexts(true);
+
+	Canvas::Handle canvas = get_prefetch_canvas();
+	if (!canvas)
+		return;
+
+	handle<WorkAreaPrefetchTarget> target(
+		new WorkAreaPrefetchTarget(this, state, rect, times, canvas) );
+	target->set_rend_desc(&desc);
+	target->set_engine(App::workarea_renderer);
+
+	prefetch_renderer = new AsyncRenderer(target);
+	prefetch_renderer->start();
+}
+
+Canvas::Handle
+WorkArea::get_prefetch_canvas()
+{
+	if (prefetch_canvas_revision != canvas_revision)
+	{
+		prefetch_canvas = snapshot_canvas(get_canvas());
+		prefetch_canvas_revision = canvas_revision;
+	}
+	return prefetch_canvas;
+}
+
+void
+WorkArea::stop_prefetch()
+{
+	if (!prefetch_renderer)
+		return;
+	etl::handle<AsyncRenderer> renderer = prefetch_renderer;
+	prefetch_renderer = 0;
+	renderer->stop();
+}
+
 bool
 studio::WorkArea::sync_render_preview(synfig::Time time)
 {
 	cur_time=time;
 	//tile_book.clear();
-	refreshes+=5;
+	g_atomic_int_add(&refreshes, 5);
+	dirty_region_full=true;
 	if(!get_visible())return false;
+
+	// frames are taken from cache when playback is repeated
+	if(show_cached_frame())
+		return true;
 	return sync_update_preview();
 }
 
@@ -3238,7 +4341,14 @@ studio::WorkArea::__render_preview(gpointer data)
 void
 studio::WorkArea::queue_render_preview()
 {
-	//synfig::info("queue_render_preview(): called for %s", get_canvas_view()->get_time().get_string().c_str());
+	dirty_region_full=true;
+	queue_render_preview_changes();
+}
+
+void
+studio::WorkArea::queue_render_preview_changes()
+{
+	//synfig::info("queue_render_preview_changes(): called for %s", get_canvas_view()->get_time().get_string().c_str());
 
 	if(queued==true)
 	{
@@ -3278,7 +4388,7 @@ studio::WorkArea::queue_render_preview()
 	}
 /*	else if(rendering)
 	{
-		refreshes+=5;
+		g_atomic_int_add(&refreshes, 5);
 		dirty=true;
 		queue_draw();
 	}
@@ -3355,7 +4465,8 @@ studio::WorkArea::set_zoom(float z)
 		async_renderer->stop();
 		async_renderer=0;
 	}*/
-	refreshes+=5;
+	g_atomic_int_add(&refreshes, 5);
+	dirty_region_full=true;
 	async_update_preview();
 	//queue_render_preview();
 	// TODO: FIXME: QuickHack
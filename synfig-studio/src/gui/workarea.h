@@ -33,6 +33,8 @@
 #include <map>
 #include <set>
 
+#include <glib.h>
+
 #include <ETL/smart_ptr>
 #include <ETL/handle>
 
@@ -48,12 +50,16 @@
 #include <synfig/vector.h>
 #include <synfig/renddesc.h>
 #include <synfig/canvas.h>
+#include <synfig/layer.h>
+#include <synfig/mutex.h>
+#include <synfig/transformation.h>
 
 #include "dials/zoomdial.h"
 #include "widgets/widget_ruler.h"
 #include "duckmatic.h"
 #include "instance.h"
 #include "app.h"
+#include "packedimage.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -86,6 +92,7 @@ namespace studio
 class WorkAreaTarget;
 class WorkAreaTarget_Full;
 class WorkAreaTarget_GL;
+class WorkAreaPrefetchTarget;
 
 class Instance;
 class CanvasView;
@@ -111,6 +118,10 @@ public:
 	synfig::RectInt rect;
 	Glib::RefPtr<Gdk::Pixbuf> pixbuf;
 	cairo_surface_t* surface;
+	//! Pixbuf which was rendered, 'pixbuf' may be a part of it
+	Glib::RefPtr<Gdk::Pixbuf> source;
+	//! Position of 'pixbuf' in 'source'
+	synfig::VectorInt source_offset;
 
 	WorkAreaTile(): refresh_id(), surface()
 		{ }
@@ -121,7 +132,9 @@ public:
 			  left + (pixbuf ? pixbuf->get_width() : 0),
 			  top + (pixbuf ? pixbuf->get_height() : 0) ),
 		pixbuf(pixbuf),
-		surface() { }
+		surface(),
+		source(pixbuf),
+		source_offset(0, 0) { }
 	WorkAreaTile(int refresh_id, int left, int top, cairo_surface_t *surface):
 		refresh_id(refresh_id),
 		rect( left,
@@ -130,6 +143,8 @@ public:
 			  top + (surface ? cairo_image_surface_get_height(surface) : 0) ),
 		pixbuf(pixbuf),
 		surface() { }
+	//! Creates tile for part 'rect' of 'tile'
+	WorkAreaTile(int refresh_id, const WorkAreaTile &tile, const synfig::RectInt &rect);
 
 	bool operator< (const WorkAreaTile &other) { return refresh_id < other.refresh_id; }
 };
@@ -146,10 +161,15 @@ public:
 
 	void clear() { tiles.clear(); }
 
-	void sort();
-
+	//! Tiles are ordered by refresh_id, older tiles never intersect newer ones
 	void add(const WorkAreaTile &tile);
 
+	//! Marks tiles which are actual for 'refresh_id' as actual for 'new_refresh_id',
+	//! except of the parts of tiles inside 'dirty_rect'.
+	//! Tiles are split only by the lines of 'grid', so the count of parts stays limited,
+	//! adjacent parts of the same tile are merged back
+	void renew(int refresh_id, int new_refresh_id, const synfig::RectInt &dirty_rect, const synfig::VectorInt &grid);
+
 	void add(int refresh_id, int left, int top, const Glib::RefPtr<Gdk::Pixbuf> &pixbuf)
 		{ add(WorkAreaTile(refresh_id, left, top, pixbuf)); }
 	void add(int refresh_id, int left, int top, cairo_surface_t *surface)
@@ -162,6 +182,127 @@ public:
 		const synfig::VectorInt &max_size = synfig::VectorInt(INT_MAX, INT_MAX) ) const;
 };
 
+//! Rendered frames of onion skin, they are reused while canvas and view are unchanged
+class WorkAreaOnionSkinCache
+{
+public:
+	//! Parameters of rendering which cached frames depends on
+	struct State
+	{
+		int revision;
+		synfig::Rect frame;
+		synfig::VectorInt size;
+		int quality;
+		bool low_res;
+
+		State(): revision(), quality(), low_res() { }
+
+		bool operator==(const State &other) const
+		{
+			return revision == other.revision
+				&& frame == other.frame
+				&& size == other.size
+				&& quality == other.quality
+				&& low_res == other.low_res;
+		}
+		bool operator!=(const State &other) const
+			{ return !(*this == other); }
+	};
+
+private:
+	struct Key
+	{
+		synfig::Time time;
+		synfig::RectInt rect;
+
+		Key(const synfig::Time &time, const synfig::RectInt &rect):
+			time(time), rect(rect) { }
+
+		bool operator<(const Key &other) const
+		{
+			if (time < other.time) return true;
+			if (other.time < time) return false;
+			if (rect.minx != other.rect.minx) return rect.minx < other.rect.minx;
+			if (rect.miny != other.rect.miny) return rect.miny < other.rect.miny;
+			if (rect.maxx != other.rect.maxx) return rect.maxx < other.rect.maxx;
+			return rect.maxy < other.rect.maxy;
+		}
+	};
+
+	typedef std::map<Key, Glib::RefPtr<Gdk::Pixbuf> > Map;
+
+	synfig::Mutex mutex;
+	State state;
+	Map frames;
+
+public:
+	//! Drops all frames if rendering parameters was changed
+	void set_state(const State &x);
+
+	Glib::RefPtr<Gdk::Pixbuf> get(const synfig::Time &time, const synfig::RectInt &rect);
+
+	//! Stores the frame if it was rendered with the actual parameters
+	void add(const State &state, const synfig::Time &time, const synfig::RectInt &rect, const Glib::RefPtr<Gdk::Pixbuf> &pixbuf);
+
+	//! Drops the frames with time not listed in 'times'
+	void retain(const std::vector<synfig::Time> &times);
+
+	void clear();
+};
+
+//! Rendered frames of playback and scrubbing, pixels of frames are compressed by PackedImage.
+//! Frames are dropped when canvas or view was changed,
+//! and the least recently used frames are dropped when memory limit is reached
+class WorkAreaFrameCache
+{
+public:
+	typedef WorkAreaOnionSkinCache::State State;
+
+private:
+	struct Frame
+	{
+		synfig::RectInt rect;
+		PackedImage image;
+		long long last_use;
+
+		Frame(): last_use() { }
+	};
+
+	typedef std::map<synfig::Time, Frame> Map;
+
+	synfig::Mutex mutex;
+	State state;
+	Map frames;
+	size_t memory_limit;
+	size_t memory_used;
+	long long uses;
+
+	static size_t get_frame_size(const Frame &frame)
+		{ return sizeof(frame) + frame.image.get_size(); }
+
+	//! Drops the least recently used frames until 'size' bytes can be added
+	void reserve(size_t size);
+
+public:
+	WorkAreaFrameCache();
+
+	void set_memory_limit(size_t x);
+	size_t get_memory_limit() const { return memory_limit; }
+
+	//! Drops all frames if rendering parameters was changed
+	void set_state(const State &x);
+
+	//! Tells whether the frame which covers 'rect' is cached, and marks it as recently used
+	bool has(const State &state, const synfig::Time &time, const synfig::RectInt &rect);
+
+	Glib::RefPtr<Gdk::Pixbuf> get(const State &state, const synfig::Time &time, const synfig::RectInt &rect);
+
+	//! Stores the frame if it was rendered with the actual parameters
+	void add(const State &state, const synfig::Time &time, const synfig::RectInt &rect, const Glib::RefPtr<Gdk::Pixbuf> &pixbuf);
+
+	void clear();
+};
+
 
 class WorkArea : public Gtk::Table, public Duckmatic
 {
@@ -170,6 +311,7 @@ class WorkArea : public Gtk::Table, public Duckmatic
 	friend class WorkAreaTarget_Cairo;
 	friend class WorkAreaTarget_Cairo_Tile;
 	friend class WorkAreaTarget_GL;
+	friend class WorkAreaPrefetchTarget;
 	friend class DirtyTrap;
 	friend class WorkAreaRenderer;
 	friend class WorkAreaProgress;
@@ -312,8 +454,47 @@ private:
 	//! This vector holds all of the tiles for this frame
 	WorkAreaTileBook tile_book;
 
-	//! This integer describes the total times that the work area has been refreshed
-	int refreshes;
+	//! This integer describes the total times that the work area has been refreshed,
+	//! changed only in main thread, render threads read it with get_refreshes()
+	gint refreshes;
+
+	//! This flag is set if the changes since the last refresh can't be localized
+	bool dirty_region_full;
+	//! This flag is set while canvas notifies about the change of one of its layers
+	bool dirty_region_child_changed;
+	//! Layers changed since the last refresh, including layers of inline canvases
+	std::set<synfig::GUID> dirty_layers;
+	//! Bounds of layers at the moment of the last refresh, in coordinates of the root canvas
+	std::map<synfig::GUID, synfig::Rect> dirty_layer_bounds;
+	//! Parameters and layers of group layer at the moment of the last refresh
+	struct DirtyGroup
+	{
+		synfig::Layer::ParamList params;
+		std::vector<synfig::GUID> layers;
+	};
+	//! Group layers which inline canvases are tracked, by GUID of group
+	std::map<synfig::GUID, DirtyGroup> dirty_groups;
+	//! Connections to the signals of inline canvases, by GUID of canvas
+	std::map<synfig::GUID, sigc::connection> dirty_canvas_connections;
+	//! Increased on each change of canvas
+	int canvas_revision;
+	//! Frames of onion skin
+	WorkAreaOnionSkinCache onion_skin_cache;
+	//! Frames of playback and scrubbing
+	WorkAreaFrameCache frame_cache;
+	//! Renders the following frames into frame cache while work area is idle
+	etl::handle<studio::AsyncRenderer> prefetch_renderer;
+	//! Copy of canvas to render frames into frame cache, see get_prefetch_canvas()
+	etl::handle<synfig::Canvas> prefetch_canvas;
+	//! Revision of canvas which prefetch_canvas is copied from
+	int prefetch_canvas_revision;
+	//! Revision of canvas at the start of the last rendering
+	int render_revision;
+
+	//! Time and frame of the last refresh
+	synfig::Time dirty_region_time;
+	synfig::Rect dirty_region_frame;
+	synfig::VectorInt dirty_region_size;
 
 	//! This list holds the queue of tiles that need to be rendered
 	//std::list<int> tile_queue;
@@ -330,6 +511,16 @@ private:
 	int quality;
 	int low_res_pixel_size;
 
+	//! Size of pixel of the coarse progressive preview, in pixels of frame,
+	//! the preview is rendered before the full quality tiles
+	int preview_pixel_size;
+	//! Refresh for which the progressive preview was started
+	int preview_refresh_id;
+	//! This flag is set while the async renderer renders the progressive preview
+	bool preview_pass;
+	//! Execution time of the last full quality rendering, negative if unknown
+	synfig::Real full_render_time;
+
 	bool dirty_trap_enabled;
 
 	int dirty_trap_queued;
@@ -366,7 +557,7 @@ public:
 	const synfig::Point& get_drag_point()const { return drag_point; }
 	const WorkAreaTileBook& get_tile_book() const { return tile_book; }
 	WorkAreaTileBook& get_tile_book() { return tile_book; }
-	int get_refreshes()const { return refreshes; }
+	int get_refreshes()const { return g_atomic_int_get(&refreshes); }
 	bool get_canceled()const { return canceled_; }
 	bool get_queued()const { return queued; }
 	bool get_rendering()const { return rendering; }
@@ -554,6 +745,7 @@ public:
 
 	int get_quality()const { return quality; }
 	int get_low_res_pixel_size()const { return low_res_pixel_size; }
+	int get_preview_pixel_size()const { return preview_pixel_size; }
 
 	void set_quality(int x);
 	void set_low_res_pixel_size(int x);
@@ -594,6 +786,9 @@ public:
 
 	void queue_render_preview();
 
+	//! Same as queue_render_preview(), but allows to refresh only the tiles
+	//! affected by the changes of canvas layers
+	void queue_render_preview_changes();
 
 	void queue_draw_preview();
 
@@ -615,6 +810,9 @@ public:
 
 	void done_rendering();
 
+	//! Stops rendering of frames into cache, the frames which are rendered already stay in it
+	void stop_prefetch();
+
 #ifdef SINGLE_THREADED
 	/* resize bug workaround */
 	void refresh_second_check();
@@ -640,6 +838,29 @@ private:
 	bool on_hruler_event(GdkEvent* event);
 	bool on_vruler_event(GdkEvent* event);
 	void on_duck_selection_single(const etl::handle<Duck>& duck_guid);
+	void on_canvas_child_changed(const synfig::Node *node);
+	void on_canvas_changed();
+
+	//! Drops the tiles affected by the changes of canvas since the last refresh,
+	//! returns false if the whole frame should be refreshed
+	bool refresh_dirty_region(int prev_refresh_id);
+	//! Remembers bounds of the layer pointed by 'context' and of layers of its inline canvas
+	void remember_dirty_bounds(const synfig::Context &context, const synfig::Transformation &transformation);
+	//! Adds area changed by layers of 'context' to 'region',
+	//! returns false if changes can't be localized inside of 'context'
+	bool collect_dirty_region(const synfig::Context &context, const synfig::Transformation &transformation, synfig::Rect &region);
+
+	//! Fills the state of frame cache, returns false if frames can't be cached in the current mode
+	bool get_frame_cache_state(WorkAreaFrameCache::State &out_state) const;
+	//! Puts the current frame from cache into tile book, returns false if it isn't cached
+	bool show_cached_frame();
+	//! Stores the current frame into cache, if the visible part of frame is completely rendered
+	void cache_frame();
+	//! Starts rendering of the frames following the current one into cache
+	void start_prefetch();
+	//! Returns copy of canvas for rendering of frames into cache, it's made once for each revision
+	//! of canvas, returns empty handle if canvas can't be copied
+	etl::handle<synfig::Canvas> get_prefetch_canvas();
 
 	/*
  -- ** -- S T A T I C   P U B L I C   M E T H O D S ---------------------------
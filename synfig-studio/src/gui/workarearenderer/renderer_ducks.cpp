@@ -193,7 +193,7 @@ Renderer_Ducks::render_vfunc(
 	}
 
 
-	const DuckList duck_list(get_work_area()->get_duck_list());
+	const DuckList &duck_list(get_work_area()->get_duck_list());
 
 	std::list<ScreenDuck> screen_duck_list;
 	const float radius((abs(pw)+abs(ph))*4);
@@ -172,6 +172,7 @@ Action::LayerPaint::PaintStroke::add_point_and_apply(const PaintPoint &point)
 	int h = wrapper.surface->get_h();
 	{
 		Mutex::Lock lock(layer->mutex);
+		layer->make_surface_unique();
 		brush_.stroke_to(&wrapper, point.x, point.y, point.pressure, 0.f, 0.f, point.dtime);
 		copy_to_cairo_surface(layer->surface, layer->csurface);
 		// TODO: optimize for hardware
@@ -227,6 +228,7 @@ Action::LayerPaint::PaintStroke::undo()
 	if (!applied) return;
 	{
 		Mutex::Lock lock(layer->mutex);
+		layer->make_surface_unique();
 		paint_prev(layer->surface);
 		copy_to_cairo_surface(layer->surface, layer->csurface);
 		layer->rendering_surface = new rendering::SurfaceSW();
@@ -245,6 +247,7 @@ Action::LayerPaint::PaintStroke::apply()
 	if (applied) return;
 	{
 		Mutex::Lock lock(layer->mutex);
+		layer->make_surface_unique();
 		paint_self(layer->surface);
 		copy_to_cairo_surface(layer->surface, layer->csurface);
 		layer->rendering_surface = new rendering::SurfaceSW();
@@ -68,6 +68,7 @@
 #include <synfigapp/localization.h>
 
 #include <synfig/importer.h>
+#include <synfig/importercache.h>
 
 #endif
 
@@ -410,6 +411,9 @@ void Instance::save_surface(const synfig::Surface &surface, const synfig::String
 
 	FileSystem::copy(FileSystemNative::instance(), tmpfile, get_file_system(), filename);
 	FileSystemNative::instance()->file_remove(tmpfile);
+
+	// file is overwritten, so decoded image is outdated
+	ImporterCache::forget(get_file_system()->get_identifier(filename));
 }
 
 void